@@ -23,20 +23,20 @@ public:
 };
 
 class FileNotFound : public std::exception {
-    std::string file_name;
+    std::string msg;
 public:
-    FileNotFound(std::string file_name) : file_name(file_name) { }
+    FileNotFound(std::string file_name) : msg("File '" + file_name + "' not found") { }
     const char *what() const throw() {
-        return ("File '" + file_name + "' not found").c_str();
+        return msg.c_str();
     }
 };
 
 class FileNotOpen : public std::exception {
-    std::string file_name;
+    std::string msg;
 public:
-    FileNotOpen(std::string file_name) : file_name(file_name) { }
+    FileNotOpen(std::string file_name) : msg("File '" + file_name + "' could not be opened - wrong format?") { }
     const char *what() const throw() {
-        return ("File '" + file_name + "' could not be opened - wrong format?").c_str();
+        return msg.c_str();
     }
 };
 
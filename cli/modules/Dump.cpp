@@ -22,6 +22,8 @@
 #include <Exception.hpp>
 #include <limits>
 #include <cstddef>
+#include <memory>
+#include <stdexcept>
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
@@ -39,17 +41,39 @@ const char* yamlstream::scalar_end = "\n";
 const char* yamlstream::item_str = "- ";
 const char* plot_script::plot_file = "dump_plot.gnu";
 
+// number of values read from a DataArray at once
+const size_t CHUNK_ELEMENTS = 1 << 16;
+
+tracking_buf::int_type tracking_buf::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return traits_type::not_eof(c);
+    }
+    last = traits_type::to_char_type(c);
+    return sink->sputc(last);
+}
+
+std::streamsize tracking_buf::xsputn(const char *s, std::streamsize n) {
+    if (n > 0) {
+        last = s[n - 1];
+    }
+    return sink->sputn(s, n);
+}
+
+int tracking_buf::sync() {
+    return sink->pubsync();
+}
+
 void yamlstream::indent_if() {
     // if endl
-    if (!strcmp(&*sstream.str().rbegin(), "\n")) {
+    if (buf->at_line_start()) {
         (*this)[level];
     }
 }
 
 void yamlstream::endl_if() {
     // if _not_ endl
-    if (strcmp(&*sstream.str().rbegin(), "\n")) {
-        sstream << "\n";
+    if (!buf->at_line_start()) {
+        *sstream << "\n";
     }
 }
 
@@ -58,7 +82,7 @@ std::string yamlstream::item() {
 }
 
 yamlstream& yamlstream::operator++() {
-    sstream << sequ_start;
+    *sstream << sequ_start;
     level++;
     return *this;
 }
@@ -84,7 +108,7 @@ yamlstream yamlstream::operator--(int) {
 yamlstream& yamlstream::operator[](const size_t n_indent) {
     endl_if();
     for (size_t i = 0; i < n_indent; i++) {
-        sstream << indent_str;
+        *sstream << indent_str;
     }
     return *this;
 }
@@ -110,8 +134,8 @@ std::string yamlstream::t(const time_t &tm) {
     return std::string(tbuff);
 }
 
-std::string yamlstream::str() {
-    return sstream.str();
+void yamlstream::flush() {
+    sstream->flush();
 }
 
 yamlstream& yamlstream::operator<<(const nix::NDSize &t)
@@ -502,6 +526,217 @@ yamlstream& yamlstream::operator<<(const nix::File &file) {
 }
 
 
+namespace {
+
+/*
+ * Write a string so that it survives the export: quoted (RFC 4180) for CSV
+ * and with backslash escapes for TSV.
+ */
+void write_field(std::ostream &out, const std::string &str, char sep) {
+    if (sep == ',') {
+        if (str.find_first_of(",\"\r\n") == std::string::npos) {
+            out << str;
+            return;
+        }
+        out << '"';
+        for (char c : str) {
+            if (c == '"') {
+                out << '"';
+            }
+            out << c;
+        }
+        out << '"';
+    } else {
+        for (char c : str) {
+            switch (c) {
+                case '\\': out << "\\\\"; break;
+                case '\t':  out << "\\t"; break;
+                case '\n':  out << "\\n"; break;
+                case '\r':  out << "\\r"; break;
+                default:    out << c;
+            }
+        }
+    }
+}
+
+
+template<typename T>
+void write_value(std::ostream &out, const T &value, char sep) {
+    out << value;
+}
+
+
+void write_value(std::ostream &out, const std::string &value, char sep) {
+    write_field(out, value, sep);
+}
+
+
+/*
+ * One line per index of the first dimension, the remaining dimensions are
+ * flattened. Reads CHUNK_ELEMENTS values (but at least one line) at once,
+ * with the calibration of the array applied.
+ */
+template<typename T>
+void write_rows(const nix::DataArray &data_array, nix::DataType dtype, const nix::NDSize &extent,
+                char sep, std::ostream &out) {
+    if (extent.size() == 0 || extent.nelms() == 0) {
+        return;
+    }
+
+    nix::ndsize_t rows = extent[0];
+    size_t row_size = static_cast<size_t>(extent.nelms() / rows);
+    size_t chunk_rows = std::max<size_t>(1, CHUNK_ELEMENTS / row_size);
+    std::unique_ptr<T[]> buffer(new T[chunk_rows * row_size]);
+
+    nix::NDSize count = extent;
+    nix::NDSize offset(extent.size(), 0);
+    for (nix::ndsize_t row = 0; row < rows; row += chunk_rows) {
+        count[0] = std::min<nix::ndsize_t>(chunk_rows, rows - row);
+        offset[0] = row;
+        data_array.getData(dtype, buffer.get(), count, offset);
+
+        size_t n = static_cast<size_t>(count[0]);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < row_size; j++) {
+                if (j) {
+                    out << sep;
+                }
+                write_value(out, buffer[i * row_size + j], sep);
+            }
+            out << '\n';
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+std::pair<double, double> Dump::write_matrix(const nix::DataArray &data_array, std::ostream &out) const {
+    double A_min = std::numeric_limits<double>::max();
+    double A_max = std::numeric_limits<double>::lowest();
+
+    nix::NDSize extent = data_array.dataExtent();
+    size_t dim1 = static_cast<size_t>(extent[0]);
+    size_t dim2 = static_cast<size_t>(extent[1]);
+    if (dim1 == 0 || dim2 == 0) {
+        return std::make_pair(0.0, 0.0);
+    }
+
+    size_t chunk_rows = std::max<size_t>(1, CHUNK_ELEMENTS / dim2);
+    std::vector<double> A(chunk_rows * dim2);
+
+    for (size_t row = 0; row < dim1; row += chunk_rows) {
+        size_t n = std::min(chunk_rows, dim1 - row);
+        nix::NDSize count({static_cast<nix::ndsize_t>(n), static_cast<nix::ndsize_t>(dim2)});
+        nix::NDSize offset({static_cast<nix::ndsize_t>(row), nix::ndsize_t(0)});
+        data_array.getData(nix::DataType::Double, A.data(), count, offset);
+
+        // loop through data_array values
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < dim2; j++) {
+                double value = A[i * dim2 + j];
+                out << value << ((j != dim2-1) ? " " : "");
+                if (value < A_min) A_min = value;
+                if (value > A_max) A_max = value;
+            }
+            out << ((row + i != dim1-1) ? "\n" : "");
+        }
+    }
+
+    return std::make_pair(A_min, A_max);
+}
+
+
+void Dump::write_table(const nix::File &file, char sep, std::ostream &out) const {
+    std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    for (auto &block : file.blocks()) {
+        for (auto &data_array : block.dataArrays()) {
+            nix::NDSize extent = data_array.dataExtent();
+            nix::DataType dtype = data_array.dataType();
+
+            out << "# " << block.name() << "/" << data_array.name() << " id=" << data_array.id()
+                << " type=" << dtype << " shape=";
+            for (size_t i = 0; i < extent.size(); i++) {
+                out << (i ? "x" : "") << extent[i];
+            }
+            out << "\n";
+
+            // calibrated values are written as they are read, in double precision
+            bool calibrated = !data_array.polynomCoefficients().empty() || data_array.expansionOrigin();
+            if (calibrated && dtype != nix::DataType::Bool && dtype != nix::DataType::String) {
+                dtype = nix::DataType::Double;
+            }
+
+            switch (dtype) {
+                case nix::DataType::Bool:
+                    write_rows<bool>(data_array, nix::DataType::Bool, extent, sep, out);
+                    break;
+                case nix::DataType::Char:
+                case nix::DataType::Int8:
+                case nix::DataType::Int16:
+                case nix::DataType::Int32:
+                case nix::DataType::Int64:
+                    write_rows<int64_t>(data_array, nix::DataType::Int64, extent, sep, out);
+                    break;
+                case nix::DataType::UInt8:
+                case nix::DataType::UInt16:
+                case nix::DataType::UInt32:
+                case nix::DataType::UInt64:
+                    write_rows<uint64_t>(data_array, nix::DataType::UInt64, extent, sep, out);
+                    break;
+                case nix::DataType::Float:
+                case nix::DataType::Double:
+                    write_rows<double>(data_array, nix::DataType::Double, extent, sep, out);
+                    break;
+                case nix::DataType::String:
+                    write_rows<std::string>(data_array, nix::DataType::String, extent, sep, out);
+                    break;
+                default:
+                    out << "# data type not supported\n";
+                    break;
+            }
+        }
+    }
+
+    out.precision(precision);
+}
+
+
+void Dump::write_stats(const nix::File &file, std::ostream &out) const {
+    nix::IOStats stats = file.ioStats();
+
+    out << "# I/O statistics of " << file.location() << "\n";
+    for (size_t i = 0; i < nix::IO_OPERATION_COUNT; i++) {
+        nix::IOOperation op = static_cast<nix::IOOperation>(i);
+        const nix::IOCounter &counter = stats[op];
+        if (counter.calls == 0) {
+            continue;
+        }
+
+        out << op << ": calls=" << counter.calls << " bytes=" << counter.bytes
+            << " total_ms=" << counter.seconds * 1e3
+            << " mean_us=" << counter.seconds * 1e6 / counter.calls << " histogram_us=";
+
+        bool first = true;
+        for (size_t bin = 0; bin < nix::IO_HISTOGRAM_BINS; bin++) {
+            if (counter.histogram[bin] == 0) {
+                continue;
+            }
+            out << (first ? "" : ",");
+            if (bin + 1 == nix::IO_HISTOGRAM_BINS) {
+                out << ">=" << (1ul << (bin - 1));
+            } else {
+                out << "<" << (1ul << bin);
+            }
+            out << ":" << counter.histogram[bin];
+            first = false;
+        }
+        out << "\n";
+    }
+}
+
+
 void Dump::load(po::options_description &desc) const {
     // declare purpose
     desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" + 
@@ -511,6 +746,11 @@ void Dump::load(po::options_description &desc) const {
     opt.add_options()
         (DATA_OPTION, "dump data from all 2D DataArrays")
         (PLOT_OPTION, ("dump & plot (only) data from all 2D DataArrays (linux only, invokes --" + std::string(DATA_OPTION) + ")").c_str())
+        (FORMAT_OPTION, po::value<std::string>()->default_value("yaml"),
+         "yaml: dump the structure of the file, csv or tsv: dump the data of all DataArrays as tables "
+         "(use --format=csv)")
+        (OUTPUT_OPTION, po::value<std::string>(), "write to the given file instead of std out (use --output=FILE)")
+        (STATS_OPTION, "print the I/O statistics of every file to std err after dumping it")
     ;
     desc.add(opt);
 }
@@ -519,13 +759,10 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
     std::vector<nix::File> files; // opened nix files
     std::stringstream out;
     std::ofstream fout;
+    std::ofstream sink_file;
     nix::File tmp_file;
     std::string file_name;
-    double A_min = std::numeric_limits<double>::max();
-    double A_max = std::numeric_limits<double>::min();
-    typedef boost::multi_array<double, 2> array_type;
-    typedef array_type::index index;
-    
+
     // --help
     if (vm.count(HELP_OPTION)) {
         po::options_description temp;
@@ -533,6 +770,21 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
         out << temp << std::endl;
         return out.str();
     }
+    // --format
+    std::string format = vm.count(FORMAT_OPTION) ? vm[FORMAT_OPTION].as<std::string>() : "yaml";
+    if (format != "yaml" && format != "csv" && format != "tsv") {
+        throw std::runtime_error("unknown format '" + format + "', use yaml, csv or tsv");
+    }
+    // --output: everything is written to the sink as it is generated
+    if (vm.count(OUTPUT_OPTION)) {
+        std::string path = vm[OUTPUT_OPTION].as<std::string>();
+        sink_file.open(path, std::ios::out | std::ios::binary);
+        if (!sink_file) {
+            throw std::runtime_error("could not open output file " + path);
+        }
+    }
+    std::ostream &sink = sink_file.is_open() ? sink_file : std::cout;
+
     // --input-file
     if (vm.count(INPFILE_OPTION)) {
         // open all files
@@ -542,19 +794,28 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                 throw FileNotFound(file_path);
             }
             // try to open!
-            tmp_file = nix::File::open(file_path, nix::FileMode::ReadWrite);
+            tmp_file = nix::File::open(file_path, nix::FileMode::ReadOnly);
             // file opened?
             if (!tmp_file.isOpen()) {
                 throw FileNotOpen(file_path);
             }
+            if (vm.count(STATS_OPTION)) {
+                tmp_file.collectIOStats(true);
+            }
             // save it!
             files.push_back(tmp_file); // ReadOnly, ReadWrite, Overwrite
         }
         // loop through entities in all files
         for (auto &file : files) {
             if ( ! (vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)) ) {
-                yaml << file;
-                out << yaml.str();
+                if (format == "yaml") {
+                    yamlstream yaml(sink);
+                    yaml << file;
+                    yaml.flush();
+                } else {
+                    write_table(file, format == "csv" ? ',' : '\t', sink);
+                    sink.flush();
+                }
             }
             else {
                 // loop through all data_arrays
@@ -566,26 +827,15 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                         if (data_array.dataExtent().size() == 2) {
                             file_name = "data_array_" + data_array.id();
                             fout.open(file_name + ".txt");
-                            index dim1 = static_cast<index>(data_array.dataExtent()[0]);
-                            index dim2 = static_cast<index>(data_array.dataExtent()[1]);
-                            array_type A(boost::extents[ dim1 ]
-                                                       [ dim2 ]);
-                            data_array.getData(A);
-                            // loop through data_array values
-                            for (index i = 0; i < dim1; i++) {
-                                for (index j = 0; j < dim2; j++) {
-                                    fout << A[i][j] << ((j != dim2-1) ? " " : "");
-                                    if (A[i][j] < A_min) A_min = A[i][j];
-                                    if (A[i][j] > A_max) A_max = A[i][j];
-                                }
-                                fout << ((i != dim1-1) ? "\n" : "");
-                            }
+                            std::pair<double, double> range = write_matrix(data_array, fout);
                             fout.close();
 
                             #ifndef _WIN32
                             if (vm.count(PLOT_OPTION)) {
                                 std::cout << "press ctrl+c for next plot" << std::endl;
-                                plot_script script(A_min, A_max, static_cast<size_t>(dim1), static_cast<size_t>(dim2), file_name + ".txt");
+                                size_t dim1 = static_cast<size_t>(data_array.dataExtent()[0]);
+                                size_t dim2 = static_cast<size_t>(data_array.dataExtent()[1]);
+                                plot_script script(range.first, range.second, dim1, dim2, file_name + ".txt");
                                 fout.open(file_name + ".gnu");
                                 fout << script.str();
                                 fout.close();
@@ -597,6 +847,9 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                     } // for data_arrays
                 } // for blcks
             } // if vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)
+            if (vm.count(STATS_OPTION)) {
+                write_stats(file, std::cerr);
+            }
         } // for: files
     } // if: INPFILE_OPTION
     else {
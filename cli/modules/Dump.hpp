@@ -24,6 +24,8 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <streambuf>
+#include <memory>
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
@@ -36,6 +38,9 @@ namespace module {
 
 const char *const DATA_OPTION = "data";
 const char *const PLOT_OPTION = "plot";
+const char *const FORMAT_OPTION = "format";
+const char *const OUTPUT_OPTION = "output";
+const char *const STATS_OPTION = "stats";
 
 class plot_script {
 private:
@@ -92,6 +97,35 @@ public:
     }
 };
 
+/**
+ * @brief stream buffer that remembers the last character written
+ *
+ * Forwards everything to the sink and keeps the last character, so that
+ * the yaml output can be indented without looking at the output written
+ * so far. Nothing is buffered here.
+ */
+class tracking_buf : public std::streambuf {
+    std::streambuf *sink;
+    char last;
+
+protected:
+    int_type overflow(int_type c);
+
+    std::streamsize xsputn(const char *s, std::streamsize n);
+
+    int sync();
+
+public:
+    tracking_buf(std::streambuf *sink) : sink(sink), last('\n') {}
+
+    /**
+     * @brief true if nothing was written yet or the last character was "\n"
+     */
+    bool at_line_start() const {
+        return last == '\n';
+    }
+};
+
 class yamlstream {
     static const char* indent_str;
     static const char* scalar_start;
@@ -101,7 +135,9 @@ class yamlstream {
     static const char* item_str;
     
     size_t level;
-    std::stringstream &sstream;
+    // shared, since the postfix operators return copies of the stream
+    std::shared_ptr<tracking_buf> buf;
+    std::shared_ptr<std::ostream> sstream;
     
     /**
      * @brief apply indentation on sstream if last char is "\n"
@@ -113,9 +149,9 @@ class yamlstream {
     void indent_if();
     
     /**
-     * @brief apply indentation on sstream if last char is "\n"
+     * @brief put "\n" into sstream if last char is not "\n"
      *
-     * Apply indentation on sstream if last char is "\n"
+     * Put "\n" into sstream if last char is not "\n"
      *
      * @return void
      */
@@ -193,18 +229,19 @@ public:
     /**
      * @brief default ctor
      *
-     * The default constructor.
+     * The default constructor. The yaml is written to the sink while it is
+     * generated, without keeping the document in memory.
      */
-    yamlstream(std::stringstream &sstream) : level(0), sstream(sstream) {};
+    yamlstream(std::ostream &sink)
+        : level(0), buf(std::make_shared<tracking_buf>(sink.rdbuf())),
+          sstream(std::make_shared<std::ostream>(buf.get())) {};
 
     /**
-     * @brief return stringstream as string
-     *
-     * Return string from stringstream
+     * @brief flush the output to the sink
      *
-     * @return string string content of the stream
+     * @return void
      */
-    std::string str();
+    void flush();
 
     /**
      * @brief default output into stringstream
@@ -217,7 +254,7 @@ public:
     template<typename T>
     yamlstream& operator<<(const T &t) {
         indent_if();
-        sstream << t;
+        *sstream << t;
         return *this;
     }
     
@@ -233,11 +270,11 @@ public:
     yamlstream& operator<<(const std::vector<T> &t) {
         indent_if();
         if (t.size()) {
-            sstream << "[";
+            *sstream << "[";
             for (auto &el : t) {
-                sstream << el << ((*t.rbegin()) != el ? ", " : "");            
+                *sstream << el << ((*t.rbegin()) != el ? ", " : "");            
             }
-            sstream << "]";
+            *sstream << "]";
         }
         return *this;
     }
@@ -265,22 +302,22 @@ public:
     yamlstream& operator<<(const boost::optional<T> &t) {
         indent_if();
         auto opt = nix::util::deRef(t);
-        sstream << opt;
+        *sstream << opt;
         return *this;
     }
     
     /**
-     * @brief pointer to stringstream output into stringstream
+     * @brief stream manipulator output into stream
      *
-     * Output via pointer to stringstream.
+     * Apply manipulators like std::endl.
      *
-     * @param ps pointer to stringstream
+     * @param ps stream manipulator
      * @return self
      */
-	yamlstream& operator<<(std::stringstream& (*ps)(std::stringstream&))
+	yamlstream& operator<<(std::ostream& (*ps)(std::ostream&))
 	{
         indent_if();
-		sstream << ps;
+		*sstream << ps;
 		return *this;
 	}
     
@@ -499,12 +536,41 @@ public:
 };
 
 class Dump : virtual public IModule {
-    
-    yamlstream yaml;
-    std::stringstream sstream;
-    
+
+    /**
+     * @brief write the 2D DataArray as text matrix for gnuplot
+     *
+     * The data is read and written in chunks of rows.
+     *
+     * @return pair of min and max value of the data
+     */
+    std::pair<double, double> write_matrix(const nix::DataArray &data_array, std::ostream &out) const;
+
+    /**
+     * @brief write the data of all DataArrays of the file as CSV or TSV
+     *
+     * Each DataArray is preceded by a "#" comment line naming it, followed by
+     * one line per index of the first dimension with all remaining values of
+     * that index. Strings are escaped (quoted for CSV, backslash escapes for
+     * TSV), so that any content survives the export. The data is read in
+     * chunks of rows.
+     *
+     * @return void
+     */
+    void write_table(const nix::File &file, char sep, std::ostream &out) const;
+
+    /**
+     * @brief write the I/O statistics collected for the file
+     *
+     * One line per operation with the number of calls, the bytes transferred,
+     * the total and mean latency and the non-empty bins of the latency
+     * histogram.
+     *
+     * @return void
+     */
+    void write_stats(const nix::File &file, std::ostream &out) const;
+
 public:
-    Dump() : yaml(yamlstream(sstream)) {}
 
     static const char* module_name;
 
@@ -12,6 +12,7 @@
 #include <nix/NDSize.hpp>
 #include <nix/Block.hpp>
 #include <nix/DataArray.hpp>
+#include <nix/DataAppender.hpp>
 #include <nix/MultiTag.hpp>
 #include <nix/Dimensions.hpp>
 #include <nix/File.hpp>
@@ -21,6 +22,9 @@
 #include <nix/Tag.hpp>
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
+#include <nix/StringColumn.hpp>
+#include <nix/MappedArray.hpp>
+#include <nix/DataSelection.hpp>
 
 
 
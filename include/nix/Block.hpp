@@ -218,6 +218,46 @@ public:
     std::vector<Source> findSources(const util::Filter<Source>::type &filter = util::AcceptAll<Source>(),
                                     size_t max_depth = std::numeric_limits<size_t>::max()) const;
 
+    /**
+     * @brief Get all data arrays of the block that reference the given source.
+     *
+     * The data arrays are looked up in an index of the source references of
+     * the file instead of checking the sources of every entity of the block.
+     *
+     * @param source    The source.
+     * @param filter    A filter function.
+     *
+     * @return A vector containing the matching data arrays.
+     */
+    std::vector<DataArray> referencingDataArrays(const Source &source,
+                                                 const util::Filter<DataArray>::type &filter = util::AcceptAll<DataArray>()) const;
+
+    /**
+     * @brief Get all tags of the block that reference the given source.
+     *
+     * See {@link referencingDataArrays} for details.
+     *
+     * @param source    The source.
+     * @param filter    A filter function.
+     *
+     * @return A vector containing the matching tags.
+     */
+    std::vector<Tag> referencingTags(const Source &source,
+                                     const util::Filter<Tag>::type &filter = util::AcceptAll<Tag>()) const;
+
+    /**
+     * @brief Get all multi tags of the block that reference the given source.
+     *
+     * See {@link referencingDataArrays} for details.
+     *
+     * @param source    The source.
+     * @param filter    A filter function.
+     *
+     * @return A vector containing the matching multi tags.
+     */
+    std::vector<MultiTag> referencingMultiTags(const Source &source,
+                                               const util::Filter<MultiTag>::type &filter = util::AcceptAll<MultiTag>()) const;
+
     /**
      * @brief Create a new root source.
      *
@@ -325,6 +365,31 @@ public:
         return backend()->dataArrayCount();
     }
 
+    /**
+     * @brief Get the id, name, type, data type, shape, unit and creation
+     *        time of all data arrays of the block.
+     *
+     * Unlike calling the accessors of every DataArray returned by
+     * {@link dataArrays}, the summary is collected in a single pass over
+     * the data arrays, reading the attributes of each with one iteration
+     * and without creating DataArray objects. Use it for listings of
+     * many data arrays.
+     *
+     * ~~~
+     * DataArraySummary summary = block.describeDataArrays();
+     * for (size_t i = 0; i < summary.size(); i++) {
+     *     std::cout << summary.name[i] << " " << summary.dtype[i] << std::endl;
+     * }
+     * ~~~
+     *
+     * @return The summary, with one row per data array.
+     */
+    DataArraySummary describeDataArrays() const {
+        DataArraySummary summary;
+        backend()->describeDataArrays(summary);
+        return summary;
+    }
+
     /**
     * @brief Create a new data array associated with this block.
     *
@@ -339,7 +404,75 @@ public:
                               const std::string &type,
                               nix::DataType      data_type,
                               const NDSize      &shape) {
-        return backend()->createDataArray(name, type, data_type, shape);
+        return backend()->createDataArray(name, type, data_type, shape, ChunkingHint(), Compression());
+    }
+
+    /**
+    * @brief Create a new data array with a chunk layout suited to the
+    *        expected access pattern.
+    *
+    * The data of a data array is stored in chunks, which are always read
+    * and written as a whole. Describing how the data will be accessed lets
+    * the chunks be shaped accordingly, e.g. a recording that is appended
+    * to along the time axis and read one channel at a time:
+    *
+    * ~~~
+    * ChunkingHint hint;
+    * hint.append_axis = 0;
+    * hint.read_shape = {0, 1};
+    * DataArray da = block.createDataArray("recording", "nix.sampled", DataType::Int16, {0, 64}, hint);
+    * ~~~
+    *
+    * The resulting layout can be inspected with {@link DataArray::chunkShape}.
+    *
+    * @param name      The name of the data array to create.
+    * @param type      The type of the data array.
+    * @param data_type A nix::DataType indicating the format to store values.
+    * @param shape     A NDSize holding the extent of the array to create.
+    * @param hint      The expected access pattern.
+    * @param compression   How to compress the data.
+    *
+    * @return The newly created data array.
+    */
+    DataArray createDataArray(const std::string  &name,
+                              const std::string  &type,
+                              nix::DataType       data_type,
+                              const NDSize       &shape,
+                              const ChunkingHint &hint,
+                              const Compression  &compression = Compression()) {
+        return backend()->createDataArray(name, type, data_type, shape, hint, compression);
+    }
+
+    /**
+    * @brief Create a new data array whose data is stored compressed.
+    *
+    * The data is compressed chunk-wise when it is written and
+    * decompressed transparently on reads. {@link Codec::Deflate} gives the
+    * better ratio, {@link Codec::LZ4} is considerably faster. Enabling the
+    * byte shuffle usually improves the ratio for numeric data of both.
+    *
+    * ~~~
+    * DataArray da = block.createDataArray("raw", "nix.sampled", DataType::Int16, {0, 64},
+    *                                      Compression(Codec::LZ4, true));
+    * ~~~
+    *
+    * Data compressed with LZ4 uses the data layout of the HDF5 LZ4 filter
+    * plugin; other applications need that plugin to read it.
+    *
+    * @param name          The name of the data array to create.
+    * @param type          The type of the data array.
+    * @param data_type     A nix::DataType indicating the format to store values.
+    * @param shape         A NDSize holding the extent of the array to create.
+    * @param compression   The compression settings.
+    *
+    * @return The newly created data array.
+    */
+    DataArray createDataArray(const std::string &name,
+                              const std::string &type,
+                              nix::DataType      data_type,
+                              const NDSize      &shape,
+                              const Compression &compression) {
+        return backend()->createDataArray(name, type, data_type, shape, ChunkingHint(), compression);
     }
 
     /**
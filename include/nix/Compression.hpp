@@ -0,0 +1,46 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_COMPRESSION_H
+#define NIX_COMPRESSION_H
+
+#include <nix/Platform.hpp>
+
+namespace nix {
+
+/**
+ * @brief Enumeration of the codecs available to compress the data of a DataArray.
+ */
+NIXAPI enum class Codec {
+    None,    //!< Store the data uncompressed
+    Deflate, //!< zlib deflate, slow but widely supported
+    LZ4      //!< LZ4 block compression, fast with moderate ratios
+};
+
+/**
+ * @brief Compression settings for the data of a DataArray.
+ *
+ * The data is compressed chunk by chunk while it is written and
+ * decompressed transparently when it is read. See
+ * {@link nix::Block::createDataArray}.
+ */
+struct Compression {
+
+    Compression() { }
+
+    Compression(Codec codec, bool shuffle = false, int level = 6)
+        : codec(codec), shuffle(shuffle), level(level) { }
+
+    Codec codec = Codec::None; //!< The codec to compress the chunks with
+    bool shuffle = false;      //!< Reorder the bytes of the elements by significance before compressing
+    int level = 6;             //!< Compression level (0-9), only used by Deflate
+};
+
+} // namespace nix
+
+#endif // NIX_COMPRESSION_H
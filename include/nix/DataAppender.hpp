@@ -0,0 +1,134 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_APPENDER_H
+#define NIX_DATA_APPENDER_H
+
+#include <nix/DataArray.hpp>
+#include <nix/Hydra.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Buffered appending of data to a {@link nix::DataArray}.
+ *
+ * {@link DataArray::appendData} resizes the data set and writes the data
+ * for every call, which is costly when many small blocks are appended,
+ * e.g. during acquisition. A DataAppender collects appended blocks in
+ * memory and writes them with a single call once the buffer holds
+ * `flush_size` bytes. The data set is grown geometrically so its extent
+ * only changes rarely.
+ *
+ * While appending, the data set may be larger than the data written. The
+ * extent of the written data is recorded with the DataArray and reported
+ * by {@link DataArray::dataExtent}. When the appender is closed (or
+ * destroyed) the remaining data is written and the data set is trimmed
+ * to its logical extent.
+ *
+ * ~~~
+ * DataArray da = block.createDataArray("signal", "nix.sampled", DataType::Int16, {0, 64});
+ * DataAppender appender(da, 0);
+ * while (acquiring) {
+ *     appender.append(DataType::Int16, samples, {n, 64});
+ * }
+ * appender.close();
+ * ~~~
+ *
+ * Blocks appended as {@link nix::DataType::String} are not buffered but
+ * written right away.
+ */
+class NIXAPI DataAppender {
+
+public:
+
+    /**
+     * @brief Create an appender for the DataArray.
+     *
+     * @param array         The DataArray to append to, it must already have data.
+     * @param axis          The dimension to append along.
+     * @param flush_size    The number of bytes to collect before writing.
+     */
+    DataAppender(const DataArray &array, size_t axis, size_t flush_size = 1024 * 1024);
+
+    DataAppender(const DataAppender &other) = delete;
+
+    DataAppender &operator=(const DataAppender &other) = delete;
+
+    /**
+     * @brief Append a block of data.
+     *
+     * @param dtype     The type of the data.
+     * @param data      Pointer to the data.
+     * @param count     The shape of the block, it must match the DataArray
+     *                  in all dimensions but the appending axis.
+     */
+    void append(DataType dtype, const void *data, const NDSize &count);
+
+    /**
+     * @brief Append a block of data.
+     *
+     * @param value     The data, its shape must match the DataArray in all
+     *                  dimensions but the appending axis.
+     */
+    template<typename T>
+    void append(const T &value) {
+        const Hydra<const T> hydra(value);
+        append(hydra.element_data_type(), hydra.data(), hydra.shape());
+    }
+
+    /**
+     * @brief Write all buffered data to the file.
+     */
+    void flush();
+
+    /**
+     * @brief Write all buffered data and trim the data set to the data written.
+     *
+     * Appending after close is an error.
+     */
+    void close();
+
+    /**
+     * @brief The number of elements appended along the axis so far, including
+     *        the buffered ones.
+     */
+    ndsize_t length() const {
+        return extent[axis] + buffered;
+    }
+
+    /**
+     * @brief Closes the appender, errors are ignored.
+     */
+    ~DataAppender();
+
+private:
+
+    DataArray array;
+    size_t    axis;
+    size_t    flush_size;
+    bool      closed;
+
+    NDSize    extent;      // logical extent of the data in the file
+    ndsize_t  capacity;    // allocated extent along the axis
+
+    DataType              buffer_type;
+    std::vector<char>     buffer;
+    std::vector<ndsize_t> blocks;     // length along the axis of the buffered blocks
+    ndsize_t              buffered;
+
+    void check(const NDSize &count) const;
+    void reserve(ndsize_t length);
+    void record();
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_APPENDER_H
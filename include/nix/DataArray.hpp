@@ -15,6 +15,7 @@
 #include <nix/base/IDataArray.hpp>
 #include <nix/Dimensions.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/MappedArray.hpp>
 
 #include <nix/Platform.hpp>
 
@@ -386,6 +387,32 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
+    /**
+     * @brief Create the data of a data array that has none yet.
+     *
+     * @param dtype         The data type that should be stored.
+     * @param size          The size of the data.
+     * @param compression   How the data should be compressed.
+     */
+    void createData(DataType dtype, const NDSize &size, const Compression &compression = Compression()) {
+        backend()->createData(dtype, size, ChunkingHint(), compression);
+    }
+
+    /**
+     * @brief Create the data of a data array that has none yet.
+     *
+     * See {@link Block::createDataArray} for the chunking hint.
+     *
+     * @param dtype         The data type that should be stored.
+     * @param size          The size of the data.
+     * @param hint          Description of the expected access pattern.
+     * @param compression   How the data should be compressed.
+     */
+    void createData(DataType dtype, const NDSize &size, const ChunkingHint &hint,
+                    const Compression &compression = Compression()) {
+        backend()->createData(dtype, size, hint, compression);
+    }
+
     void getDataDirect(DataType dtype,
                        void *data,
                        const NDSize &count,
@@ -429,8 +456,168 @@ public:
         return backend()->dataType();
     }
 
+    /**
+     * @brief Append data to the DataArray along the given axis.
+     *
+     * The data set is resized for every call; when appending many small
+     * blocks use a {@link DataAppender} instead.
+     *
+     * @param dtype     The type of the data.
+     * @param data      Pointer to the data.
+     * @param count     The shape of the data, it must match the DataArray in all
+     *                  dimensions but axis.
+     * @param axis      The dimension to append along.
+     */
     void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
 
+    /**
+     * @brief Enable the chunk cache for reads from this DataArray.
+     *
+     * Once enabled, reads are served from an in-memory least recently used
+     * cache of chunk aligned blocks of the stored data. All chunks missing
+     * for a read are fetched with a single read, optionally together with
+     * `read_ahead` subsequent chunks along the first dimension, which makes
+     * repeated, overlapping or sequential small reads (e.g. by a {@link DataView}
+     * or when paging through a signal) considerably cheaper. Reads that
+     * would not fit into the cache, string data and data that is not stored
+     * in chunks bypass the cache. Writes through the DataArray keep the cache
+     * consistent.
+     *
+     * The cache is shared by all DataArray objects referring to the same
+     * entity and is released when the file is closed.
+     *
+     * ~~~
+     * DataArray da = ...;
+     * da.chunkCache(64 * 1024 * 1024, 4);
+     * for (ndsize_t i = 0; i < n; i++) {
+     *     da.getData(window, {1024}, {i * 512});
+     * }
+     * ChunkCacheStats stats = da.chunkCacheStats();
+     * ~~~
+     *
+     * @param capacity      The maximum number of bytes held by the cache.
+     * @param read_ahead    The number of additional chunks to load on a cache miss.
+     */
+    void chunkCache(size_t capacity, size_t read_ahead = 0) {
+        backend()->chunkCache(capacity, read_ahead);
+    }
+
+    /**
+     * @brief Disable the chunk cache of the DataArray.
+     *
+     * @param t         None
+     */
+    void chunkCache(const none_t t) {
+        backend()->chunkCache(t);
+    }
+
+    /**
+     * @brief Get the usage statistics of the chunk cache.
+     *
+     * @return The statistics, all zero if the cache is not enabled.
+     */
+    ChunkCacheStats chunkCacheStats() const {
+        return backend()->chunkCacheStats();
+    }
+
+    /**
+     * @brief Get the shape of the chunks the data is stored in.
+     *
+     * See {@link Block::createDataArray} on how to influence the chunk layout.
+     *
+     * @return The chunk shape or an empty NDSize if the data is not chunked.
+     */
+    NDSize chunkShape() const {
+        return backend()->chunkShape();
+    }
+
+    /**
+     * @brief Get a read-only view of the stored data.
+     *
+     * If the data is stored in one piece (see {@link ChunkingHint::contiguous}),
+     * unfiltered and in native byte order, the file is mapped into memory
+     * and nothing is read until the data is accessed. Otherwise the data is
+     * read into memory. The view holds the raw stored values, the polynomial
+     * and expansion origin are not applied.
+     *
+     * ~~~
+     * ChunkingHint hint;
+     * hint.contiguous = true;
+     * DataArray da = block.createDataArray("recording", "nix.sampled", DataType::Int16, {nsamples, 64}, hint);
+     * ...
+     * MappedArray view = da.map();
+     * int16_t v = view.get<int16_t>({i, channel});
+     * ~~~
+     *
+     * @return The view of the data.
+     */
+    MappedArray map() const;
+
+    /**
+     * @brief Build a multi-resolution overview of the data.
+     *
+     * The samples along `axis` of 1-D or 2-D numeric data are grouped into
+     * bins of `bin_size` samples and min, max, mean and count of every bin
+     * and channel (the other dimension) are stored with the DataArray,
+     * together with coarser levels that each combine two bins of the level
+     * below. Subsequent writes, {@link appendData} and changes of the extent
+     * update the affected bins only. The overview makes {@link envelope}
+     * independent of the number of samples in the requested range.
+     *
+     * @param bin_size  The number of samples per bin of the finest level.
+     * @param axis      The dimension of the samples, e.g. time.
+     */
+    void overview(size_t bin_size = 256, size_t axis = 0) {
+        backend()->overview(bin_size, axis);
+    }
+
+    /**
+     * @brief Remove the overview of the DataArray.
+     *
+     * @param t         None
+     */
+    void overview(const none_t t) {
+        backend()->overview(t);
+    }
+
+    /**
+     * @brief Check if the DataArray has an overview.
+     */
+    bool hasOverview() const {
+        return backend()->hasOverview();
+    }
+
+    /**
+     * @brief Get the min, max and mean of a range of samples at a display
+     *        resolution.
+     *
+     * Summarizes the samples [start, start + count) along the axis of the
+     * overview (the first dimension without one) in about `points` points,
+     * e.g. one per pixel of a plot. With an overview the points are read
+     * from the coarsest level whose bins are no larger than `count / points`
+     * samples, so the range is extended to whole bins and more points may
+     * be returned; otherwise the data is read and reduced in groups of
+     * exactly `count / points` samples. The values are the stored values,
+     * the polynomial and expansion origin are not applied.
+     *
+     * ~~~
+     * da.overview();
+     * Envelope env = da.envelope(0, da.dataExtent()[0], 1000);
+     * for (size_t i = 0; i < env.shape[0]; i++) {
+     *     plot(env.start + i * env.step, env.min[i], env.max[i]);
+     * }
+     * ~~~
+     *
+     * @param start     The first sample.
+     * @param count     The number of samples.
+     * @param points    The number of points wanted.
+     *
+     * @return The envelope, see {@link Envelope}.
+     */
+    Envelope envelope(ndsize_t start, ndsize_t count, size_t points) const {
+        return backend()->envelope(start, count, points);
+    }
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -448,6 +635,8 @@ public:
      */
     NIXAPI friend std::ostream& operator<<(std::ostream &out, const DataArray &ent);
 
+    friend class DataAppender;
+
     //
 protected:
     //implementation of the DataIO interface
@@ -460,6 +649,18 @@ protected:
                  const void *data,
                  const NDSize &count,
                  const NDSize &offset) override;
+
+    void ioRead(DataType dtype,
+                void *data,
+                const DataSelection &selection) const override;
+
+    void ioReadStrings(StringColumn &data,
+                       const NDSize &count,
+                       const NDSize &offset) const override;
+
+    void ioWriteStrings(const StringColumn &data,
+                        const NDSize &count,
+                        const NDSize &offset) override;
 };
 
 } // namespace nix
@@ -0,0 +1,152 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_SELECTION_H
+#define NIX_DATA_SELECTION_H
+
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief A regular pattern of blocks in a data set.
+ *
+ * Selects `count` blocks of `block` elements along each dimension, the
+ * first one at `start` and each following one `stride` elements after the
+ * previous one.
+ */
+struct Hyperslab {
+    NDSize start;
+    NDSize count;
+    NDSize stride;
+    NDSize block;
+};
+
+
+/**
+ * @brief Selection of elements of a DataArray to be read at once.
+ *
+ * A selection is either a union of non-overlapping {@link Hyperslab}s or a
+ * list of points. The selected elements are read with a single I/O call
+ * and stored in row-major order of their position in the data (points in
+ * the order they were added).
+ *
+ * Every 10th sample of channels 0, 3 and 4 of a {time, channel} recording:
+ * ~~~
+ * DataSelection sel = DataSelection::decimate({0, 0}, {n, 64}, 0, n / 10);
+ * sel.only(1, {0, 3, 4});
+ * std::vector<double> data;
+ * array.getData(data, sel);   // data.size() == sel.shape().nelms()
+ * ~~~
+ */
+class NIXAPI DataSelection {
+
+public:
+
+    /**
+     * @brief An empty selection.
+     */
+    DataSelection() { }
+
+    /**
+     * @brief A selection of a single hyperslab, see {@link add}.
+     */
+    DataSelection(const NDSize &start, const NDSize &count,
+                  const NDSize &stride = {}, const NDSize &block = {}) {
+        add(start, count, stride, block);
+    }
+
+    /**
+     * @brief Add a hyperslab to the selection.
+     *
+     * @param start     Position of the first block.
+     * @param count     Number of blocks along each dimension.
+     * @param stride    Distance between the starts of the blocks, 1 if empty.
+     * @param block     Shape of the blocks, 1 if empty.
+     */
+    DataSelection &add(const NDSize &start, const NDSize &count,
+                       const NDSize &stride = {}, const NDSize &block = {});
+
+    /**
+     * @brief Add a single element to the selection.
+     */
+    DataSelection &addPoint(const NDSize &point);
+
+    /**
+     * @brief Restrict the selection to the given indices along one dimension.
+     *
+     * Every hyperslab is replaced by one hyperslab per run of consecutive
+     * indices, e.g. to pick a subset of the channels of a recording.
+     *
+     * @param axis      The dimension.
+     * @param indices   The indices to select, in increasing order.
+     */
+    DataSelection &only(size_t axis, const std::vector<ndsize_t> &indices);
+
+    /**
+     * @brief Select at most `max_points` evenly spaced elements along a
+     *        dimension of a region.
+     *
+     * @param offset        The start of the region.
+     * @param count         The shape of the region.
+     * @param axis          The dimension to decimate.
+     * @param max_points    The maximum number of elements along the axis.
+     */
+    static DataSelection decimate(const NDSize &offset, const NDSize &count,
+                                  size_t axis, ndsize_t max_points);
+
+    const std::vector<Hyperslab> &hyperslabs() const {
+        return slabs;
+    }
+
+    const std::vector<NDSize> &points() const {
+        return pts;
+    }
+
+    bool empty() const {
+        return slabs.empty() && pts.empty();
+    }
+
+    size_t rank() const;
+
+    /**
+     * @brief The number of selected elements.
+     */
+    ndsize_t nelms() const;
+
+    /**
+     * @brief The shape of the data read with the selection.
+     *
+     * The shape of the selected blocks for a single hyperslab or a union of
+     * hyperslabs that only differ along one dimension, otherwise the number
+     * of selected elements.
+     */
+    NDSize shape() const;
+
+    /**
+     * @brief Check if all selected elements lie within the extent.
+     */
+    bool within(const NDSize &extent) const;
+
+    /**
+     * @brief Get a copy of the selection moved by the offset.
+     */
+    DataSelection shifted(const NDSize &offset) const;
+
+private:
+
+    std::vector<Hyperslab> slabs;
+    std::vector<NDSize>    pts;
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_SELECTION_H
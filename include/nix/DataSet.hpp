@@ -14,6 +14,8 @@
 
 #include <nix/Dimensions.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/DataSelection.hpp>
+#include <nix/StringColumn.hpp>
 
 #include <nix/Platform.hpp>
 
@@ -29,6 +31,8 @@ public:
 
     template<typename T> void getData(T &value, const NDSize &offset) const;
 
+    template<typename T> void getData(T &value, const DataSelection &selection) const;
+
     template<typename T> void setData(const T &value, const NDSize &offset);
 
 
@@ -46,6 +50,36 @@ public:
         ioWrite(dtype, data, count, offset);
     }
 
+    void getData(DataType dtype,
+                 void *data,
+                 const DataSelection &selection) const {
+        ioRead(dtype, data, selection);
+    }
+
+    // string data without one std::string per element, see StringColumn
+    void getData(StringColumn &value) const {
+        NDSize extent = dataExtent();
+        ioReadStrings(value, extent, NDSize(extent.size(), 0));
+    }
+
+    void getData(StringColumn &value, const NDSize &count, const NDSize &offset) const {
+        ioReadStrings(value, count, offset);
+    }
+
+    void setData(const StringColumn &value) {
+        NDSize shape({value.size()});
+        dataExtent(shape);
+        ioWriteStrings(value, shape, {});
+    }
+
+    void setData(const StringColumn &value, const NDSize &offset) {
+        ioWriteStrings(value, NDSize({value.size()}), offset);
+    }
+
+    void setData(const StringColumn &value, const NDSize &count, const NDSize &offset) {
+        ioWriteStrings(value, count, offset);
+    }
+
     // *** the virtual interface ***
     virtual void dataExtent(const NDSize &extent) = 0;
     virtual NDSize dataExtent() const = 0;
@@ -63,6 +97,18 @@ protected:
                          const NDSize &count,
                          const NDSize &offset) = 0;
 
+    virtual void ioRead(DataType dtype,
+                        void *data,
+                        const DataSelection &selection) const = 0;
+
+    virtual void ioReadStrings(StringColumn &data,
+                               const NDSize &count,
+                               const NDSize &offset) const = 0;
+
+    virtual void ioWriteStrings(const StringColumn &data,
+                                const NDSize &count,
+                                const NDSize &offset) = 0;
+
 };
 
 template<typename T>
@@ -114,6 +160,22 @@ void DataSet::getData(T &value, const NDSize &offset) const
     getData(dtype, hydra.data(), count, offset);
 }
 
+template<typename T>
+void DataSet::getData(T &value, const DataSelection &selection) const
+{
+    Hydra<T> hydra(value);
+    DataType dtype = hydra.element_data_type();
+
+    // one-dimensional containers get the elements in a row
+    NDSize shape = selection.shape();
+    if (hydra.shape().size() == 1 && shape.size() > 1) {
+        shape = NDSize({selection.nelms()});
+    }
+
+    hydra.resize(shape);
+    getData(dtype, hydra.data(), selection);
+}
+
 
 template<typename T>
 void DataSet::setData(const T &value, const NDSize &offset)
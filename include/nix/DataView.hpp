@@ -41,6 +41,18 @@ protected:
                  const NDSize &count,
                  const NDSize &offset) override;
 
+    void ioRead(DataType dtype,
+                void *data,
+                const DataSelection &selection) const override;
+
+    void ioReadStrings(StringColumn &data,
+                       const NDSize &count,
+                       const NDSize &offset) const override;
+
+    void ioWriteStrings(const StringColumn &data,
+                        const NDSize &count,
+                        const NDSize &offset) override;
+
 private:
     NDSize transform_coordinates(const NDSize &c, const NDSize &o) const;
 
@@ -236,6 +236,18 @@ public:
      */
     size_t indexOf(const double position) const;
 
+    /**
+     * @brief Returns the indices of the given positions.
+     *
+     * Like {@link indexOf(double)}, but reads offset and sampling interval
+     * only once for all positions.
+     *
+     * @param positions  The positions, e.g. times
+     *
+     * @returns The respective indices.
+     */
+    std::vector<size_t> indexOf(const std::vector<double> &positions) const;
+
     /**
      * @brief Returns the position of this dimension at a given index.
      *
@@ -617,7 +629,21 @@ public:
      * @return The index.
      */
     size_t indexOf(const double position) const;
-    
+
+    /**
+     * @brief Returns the indices of the given positions
+     *
+     * Like {@link indexOf(double)}, but resolves all positions with a single
+     * pass over the ticks in ascending order of the positions. The ticks are
+     * only read in the vicinity of the positions, so this is also fast for
+     * dimensions with a huge number of ticks.
+     *
+     * @param positions   The positions.
+     *
+     * @return The index of the tick closest to each position.
+     */
+    std::vector<size_t> indexOf(const std::vector<double> &positions) const;
+
     /**
      * @brief Returns a vector containing a number of ticks
      *
@@ -20,7 +20,20 @@
 
 namespace nix {
 
-
+/**
+ * @brief The File is the entry point to the data and metadata stored in a NIX file.
+ *
+ * ### Thread safety
+ *
+ * The library does not synchronize access to files. A File and all entities
+ * obtained from it may only be used by one thread at a time; applications that
+ * use a file from several threads have to serialize all calls themselves.
+ *
+ * Files opened with {@link FileMode::ReadOnly} can read large selections of
+ * DataArray data with several threads (see {@link readThreads}). The worker
+ * threads are managed by the library and never touch the file outside of a
+ * read, so the rules above still apply to the calling application.
+ */
 class NIXAPI File : public base::ImplContainer<base::IFile> {
 
 public:
@@ -199,6 +212,15 @@ public:
         return blocks(util::AcceptAll<Block>());
     }
 
+    /**
+     * @brief Get a summary of all data arrays of all blocks of the file.
+     *
+     * See {@link Block::describeDataArrays} for details.
+     *
+     * @return The summary, with one row per data array.
+     */
+    DataArraySummary describeDataArrays() const;
+
     //--------------------------------------------------
     // Methods concerning sections
     //--------------------------------------------------
@@ -438,11 +460,86 @@ public:
     // Operators and other functions
     //------------------------------------------------------
 
+    /**
+     * @brief Write all pending changes to the file.
+     *
+     * The update times of modified entities are kept in memory and written
+     * when the file is flushed or closed.
+     */
+    void flush() {
+        backend()->flush();
+    }
+
     /**
      * @brief Close the file.
      */
     void close();
 
+    /**
+     * @brief Set the number of threads used to read DataArray data.
+     *
+     * Reads that span several chunks of a DataArray are then split along the
+     * chunk boundaries; the chunks are fetched one after the other and
+     * decompressed and assembled in parallel.
+     * Only available for files opened read-only.
+     *
+     * @param threads   The number of threads including the calling one; 0 uses
+     *                  one thread per available core, 1 disables parallel reads.
+     */
+    void readThreads(size_t threads) {
+        backend()->readThreads(threads);
+    }
+
+    /**
+     * @brief Get the number of threads used to read DataArray data.
+     *
+     * @return The number of threads, 1 if parallel reads are disabled.
+     */
+    size_t readThreads() const {
+        return backend()->readThreads();
+    }
+
+    /**
+     * @brief Enable or disable the collection of I/O statistics.
+     *
+     * While enabled, the number of calls, the bytes transferred and the
+     * latency of the low level operations on the file (data and attribute
+     * reads and writes, object opens, link lookups and iteration) are
+     * counted per {@link IOOperation}. Disabling the collection keeps the
+     * counters until they are reset or the file is closed. As long as no
+     * file collects statistics the operations are not measured at all.
+     *
+     * ~~~
+     * file.collectIOStats(true);
+     * for (const DataArray &da : block.dataArrays()) {
+     *     da.name();
+     * }
+     * IOStats stats = file.ioStats();
+     * size_t attr_reads = stats[IOOperation::AttrRead].calls;
+     * ~~~
+     *
+     * @param enable    True to start collecting, false to stop.
+     */
+    void collectIOStats(bool enable) {
+        backend()->collectIOStats(enable);
+    }
+
+    /**
+     * @brief Get the I/O statistics collected so far.
+     *
+     * @return The statistics, all zero if they were never collected.
+     */
+    IOStats ioStats() const {
+        return backend()->ioStats();
+    }
+
+    /**
+     * @brief Reset all I/O statistics of the file to zero.
+     */
+    void resetIOStats() {
+        backend()->resetIOStats();
+    }
+
     /**
      * @brief Check if the file is currently open.
      *
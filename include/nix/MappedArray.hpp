@@ -0,0 +1,121 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MAPPED_ARRAY_H
+#define NIX_MAPPED_ARRAY_H
+
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Read-only view of the data of a DataArray.
+ *
+ * Returned by {@link nix::DataArray::map}. If the data is stored contiguously
+ * and unfiltered in the file, the view maps the file into memory and the
+ * data is paged in by the operating system as it is accessed, without any
+ * copy. Otherwise the view holds a copy of the data read from the file.
+ *
+ * The view stays valid after the DataArray or the file is closed. The
+ * elements are laid out in row-major order, see {@link strides}.
+ */
+class NIXAPI MappedArray {
+
+public:
+
+    typedef uint8_t byte_type;
+
+    /**
+     * @brief An empty view.
+     */
+    MappedArray();
+
+    /**
+     * @brief Map a region of a file.
+     *
+     * Throws std::runtime_error if the file cannot be mapped.
+     *
+     * @param path      The file to map.
+     * @param offset    Position of the first element in the file.
+     * @param dtype     The type of the elements, in native byte order.
+     * @param shape     The shape of the data.
+     */
+    static MappedArray fromFile(const std::string &path, ndsize_t offset, DataType dtype, const NDSize &shape);
+
+    /**
+     * @brief A view of data held in memory.
+     *
+     * @param dtype     The type of the elements.
+     * @param shape     The shape of the data.
+     * @param buffer    The data, its size must match the shape.
+     */
+    static MappedArray fromBuffer(DataType dtype, const NDSize &shape, std::vector<byte_type> &&buffer);
+
+    size_t rank() const { return extends.size(); }
+    ndsize_t num_elements() const { return extends.nelms(); }
+    NDSize shape() const { return extends; }
+    NDSize size() const { return extends; }
+    DataType dtype() const { return dataType; }
+
+    /**
+     * @brief The distance in elements between neighbours along each dimension.
+     */
+    NDSize strides() const { return elm_strides; }
+
+    /**
+     * @brief True if the data is mapped from the file, false if it was read.
+     */
+    bool isMapped() const { return mapped; }
+
+    template<typename T> const T get(size_t index) const;
+    template<typename T> const T get(const NDSize &index) const;
+
+    const byte_type *data() const { return ptr; }
+
+    size_t sub2index(const NDSize &sub) const;
+
+private:
+
+    MappedArray(DataType dtype, const NDSize &shape, std::shared_ptr<const void> storage,
+                const byte_type *ptr, bool mapped);
+
+    DataType                    dataType;
+    NDSize                      extends;
+    NDSize                      elm_strides;
+    std::shared_ptr<const void> storage;
+    const byte_type            *ptr;
+    bool                        mapped;
+};
+
+/* ******************************************* */
+
+template<typename T>
+const T MappedArray::get(size_t index) const
+{
+    T value;
+    memcpy(&value, ptr + sizeof(T) * index, sizeof(T));
+    return value;
+}
+
+
+template<typename T>
+const T MappedArray::get(const NDSize &index) const
+{
+    return get<T>(sub2index(index));
+}
+
+} // namespace nix
+
+#endif // NIX_MAPPED_ARRAY_H
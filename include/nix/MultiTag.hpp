@@ -14,6 +14,7 @@
 #include <nix/Feature.hpp>
 #include <nix/Platform.hpp>
 #include <nix/DataView.hpp>
+#include <nix/NDArray.hpp>
 
 #include <algorithm>
 #include <memory>
@@ -22,6 +23,27 @@
 
 namespace nix {
 
+/**
+ * @brief The data tagged by several positions of a {@link nix::MultiTag}.
+ *
+ * The data of all requested positions is stored back to back in a single
+ * one dimensional buffer. The data of the i-th requested position starts at
+ * element `offsets[i]` of the buffer, has the shape `counts[i]` and was read
+ * from the referenced data at `origins[i]`.
+ */
+struct NIXAPI MultiTagData {
+
+    MultiTagData(DataType dtype)
+        : data(dtype, NDSize({0}))
+    {
+    }
+
+    NDArray data;
+    std::vector<ndsize_t> offsets;
+    std::vector<NDSize> counts;
+    std::vector<NDSize> origins;
+};
+
 /**
  * @brief A tag class that can be used to tag multiple positions or regions in data.
  *
@@ -351,6 +373,23 @@ public:
      */
     DataView retrieveData(size_t position_index, size_t reference_index) const;
 
+    /**
+     * @brief Retrieves the data slices tagged by several positions and extents
+     *        of a certain reference at once.
+     *
+     * Positions, extents and dimensions are read only once and neighbouring
+     * slices are fetched with combined reads, which is much faster than
+     * retrieving many positions one by one.
+     *
+     * @param position_indices the indices of the requested positions.
+     * @param reference_index the index of the requested reference.
+     * @param dtype the data type the data should be returned in.
+     *
+     * @return the requested data.
+     */
+    MultiTagData retrieveData(const std::vector<ndsize_t> &position_indices, size_t reference_index,
+                              DataType dtype = DataType::Double) const;
+
     //--------------------------------------------------
     // Methods concerning features.
     //--------------------------------------------------
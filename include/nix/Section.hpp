@@ -274,6 +274,9 @@ public:
      * section a filter is applied. If the filter returns true the respective section
      * will be added to the result list.
      * By default a filter is used that accepts all sections.
+     * The traversal is served from an index of the metadata tree of the file, which
+     * also preselects the candidates for {@link util::IdFilter}, {@link util::NameFilter},
+     * {@link util::TypeFilter} and {@link util::PropertyFilter}.
      *
      * @param filter       A filter function.
      * @param max_depth    The maximum depth of traversal.
@@ -474,11 +477,11 @@ public:
 
 private:
 
-    std::vector<Section> findDownstream(const std::function<bool(Section)> &filter) const;
+    std::vector<Section> findDownstream(const util::Filter<Section>::type &filter) const;
 
-    std::vector<Section> findUpstream(const std::function<bool(Section)> &filter) const;
+    std::vector<Section> findUpstream(const util::Filter<Section>::type &filter) const;
 
-    std::vector<Section> findSideways(const std::function<bool(Section)> &filter, const std::string &caller_id) const;
+    std::vector<Section> findSideways(const util::Filter<Section>::type &filter, const std::string &caller_id) const;
 
     size_t tree_depth() const;
 };
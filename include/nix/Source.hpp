@@ -218,6 +218,19 @@ public:
 };
 
 
+namespace util {
+
+/**
+ * @brief Translates the filters with known semantics (IdFilter, NameFilter
+ *        and TypeFilter) into a query for the source index of the backend.
+ *
+ * Used by the findSources() methods, which still apply the filter itself
+ * to all results, so that other filters keep working.
+ */
+NIXAPI base::SourceQuery sourceQuery(const Filter<Source>::type &filter);
+
+} // namespace util
+
 } // namespace nix
 
 #endif // NIX_SOURCE_H
@@ -0,0 +1,145 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STRING_COLUMN_H
+#define NIX_STRING_COLUMN_H
+
+#include <nix/Platform.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief A compact table of strings.
+ *
+ * All strings are stored back to back in one contiguous buffer, each one
+ * terminated by a null character, and are located through a table of
+ * offsets. Reading string data into a StringColumn avoids allocating one
+ * std::string per element, which dominates the time needed to read large
+ * string DataArrays or dimension labels.
+ *
+ * ~~~
+ * StringColumn labels;
+ * array.getData(labels);
+ * for (size_t i = 0; i < labels.size(); i++) {
+ *     std::cout << labels.c_str(i) << std::endl;
+ * }
+ * ~~~
+ */
+class NIXAPI StringColumn {
+
+public:
+
+    StringColumn() : offsets(1, 0) { }
+
+    /**
+     * @brief The number of strings.
+     */
+    size_t size() const {
+        return offsets.size() - 1;
+    }
+
+    /**
+     * @brief Check if the column holds no strings.
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get the null terminated string at the index.
+     */
+    const char *c_str(size_t index) const {
+        return bytes.data() + offsets[index];
+    }
+
+    /**
+     * @brief Get the length of the string at the index.
+     */
+    size_t length(size_t index) const {
+        return offsets[index + 1] - offsets[index] - 1;
+    }
+
+    /**
+     * @brief Get a copy of the string at the index.
+     */
+    std::string operator[](size_t index) const {
+        return std::string(c_str(index), length(index));
+    }
+
+    /**
+     * @brief Append a string of the given length.
+     */
+    void push_back(const char *str, size_t len) {
+        bytes.insert(bytes.end(), str, str + len);
+        bytes.push_back('\0');
+        offsets.push_back(bytes.size());
+    }
+
+    /**
+     * @brief Append a null terminated string, a null pointer appends an
+     *        empty string.
+     */
+    void push_back(const char *str) {
+        push_back(str, str == nullptr ? 0 : std::strlen(str));
+    }
+
+    void push_back(const std::string &str) {
+        push_back(str.data(), str.size());
+    }
+
+    /**
+     * @brief Reserve space for strings and their characters.
+     *
+     * @param count     The number of strings.
+     * @param chars     The total number of characters, without terminators.
+     */
+    void reserve(size_t count, size_t chars) {
+        offsets.reserve(count + 1);
+        bytes.reserve(chars + count);
+    }
+
+    /**
+     * @brief Remove all strings.
+     */
+    void clear() {
+        offsets.assign(1, 0);
+        bytes.clear();
+    }
+
+    /**
+     * @brief The buffer holding all strings, each one null terminated.
+     */
+    const std::vector<char> &blob() const {
+        return bytes;
+    }
+
+    /**
+     * @brief Get copies of all strings.
+     */
+    std::vector<std::string> strings() const {
+        std::vector<std::string> res;
+        res.reserve(size());
+        for (size_t i = 0; i < size(); i++) {
+            res.emplace_back(c_str(i), length(i));
+        }
+        return res;
+    }
+
+private:
+
+    std::vector<size_t> offsets;    // start of each string, plus the end of the last
+    std::vector<char>   bytes;
+};
+
+} // namespace nix
+
+#endif // NIX_STRING_COLUMN_H
@@ -118,8 +118,8 @@ public:
      */
     std::vector<Source> sources(util::Filter<Source>::type filter = util::AcceptAll<Source>()) const
     {
-        auto f = [this] (size_t i) { return getSource(i); };
-        return nix::base::ImplContainer<T>::template getEntities<nix::Source, decltype(f)>(f,sourceCount(),filter);
+        return nix::base::ImplContainer<T>::template filterEntities<nix::Source>(EntityWithMetadata<T>::backend()->sources(),
+                                                                                  filter);
     }
 
     /**
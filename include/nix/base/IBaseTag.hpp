@@ -45,6 +45,9 @@ public:
     virtual std::shared_ptr<IDataArray> getReference(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IDataArray>> references() const = 0;
+
+
     virtual void addReference(const std::string &id) = 0;
 
 
@@ -68,6 +71,9 @@ public:
     virtual std::shared_ptr<IFeature> getFeature(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IFeature>> features() const = 0;
+
+
     virtual std::shared_ptr<IFeature> createFeature(const std::string &data_array_id, LinkType link_type) = 0;
 
 
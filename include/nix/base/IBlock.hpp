@@ -15,12 +15,40 @@
 #include <nix/base/ITag.hpp>
 #include <nix/base/IMultiTag.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/StringColumn.hpp>
 
 #include <string>
 #include <vector>
 #include <memory>
+#include <ctime>
 
 namespace nix {
+
+/**
+ * @brief Column oriented summary of DataArrays, one row per DataArray.
+ *
+ * Row `i` of every column describes the same DataArray. See
+ * {@link nix::Block::describeDataArrays} for details.
+ */
+struct DataArraySummary {
+    StringColumn block;             //!< Name of the Block of the DataArray
+    StringColumn id;                //!< Id of the DataArray
+    StringColumn name;              //!< Name of the DataArray
+    StringColumn type;              //!< Type of the DataArray
+    std::vector<DataType> dtype;    //!< Data type, DataType::Nothing if there is no data
+    std::vector<NDSize> shape;      //!< Extent of the data, empty if there is no data
+    StringColumn unit;              //!< Unit, empty if none is set
+    std::vector<time_t> created_at; //!< Creation time
+
+    /**
+     * @brief The number of rows.
+     */
+    size_t size() const {
+        return id.size();
+    }
+};
+
+
 namespace base {
 
 /**
@@ -45,11 +73,34 @@ public:
     virtual ndsize_t sourceCount() const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::ISource>> sources() const = 0;
+
+
     virtual std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type) = 0;
 
 
     virtual bool deleteSource(const std::string &name_or_id) = 0;
 
+    /**
+     * @brief The sources of the block and their descendants up to max_depth
+     *        levels below them that match the query, together with their
+     *        depth below the sources of the block.
+     */
+    virtual std::vector<std::pair<std::shared_ptr<base::ISource>, size_t>> querySources(const SourceQuery &query,
+                                                                                          size_t max_depth) const = 0;
+
+    /**
+     * @brief The data arrays, tags and multi tags of the block that reference
+     *        the source with the given id.
+     */
+    virtual std::vector<std::shared_ptr<base::IDataArray>> referencingDataArrays(const std::string &source_id) const = 0;
+
+
+    virtual std::vector<std::shared_ptr<base::ITag>> referencingTags(const std::string &source_id) const = 0;
+
+
+    virtual std::vector<std::shared_ptr<base::IMultiTag>> referencingMultiTags(const std::string &source_id) const = 0;
+
     //--------------------------------------------------
     // Methods concerning data arrays
     //--------------------------------------------------
@@ -66,8 +117,16 @@ public:
     virtual ndsize_t dataArrayCount() const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::IDataArray>> dataArrays() const = 0;
+
+
+    virtual void describeDataArrays(DataArraySummary &summary) const = 0;
+
+
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
-                                                              nix::DataType data_type, const NDSize &shape) = 0;
+                                                              nix::DataType data_type, const NDSize &shape,
+                                                              const ChunkingHint &hint,
+                                                              const Compression &compression) = 0;
 
 
     virtual bool deleteDataArray(const std::string &name_or_id) = 0;
@@ -88,6 +147,9 @@ public:
     virtual ndsize_t tagCount() const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::ITag>> tags() const = 0;
+
+
     virtual std::shared_ptr<base::ITag> createTag(const std::string &name, const std::string &type,
                                                               const std::vector<double> &position) = 0;
 
@@ -110,6 +172,9 @@ public:
     virtual ndsize_t multiTagCount() const = 0;
 
 
+    virtual std::vector<std::shared_ptr<base::IMultiTag>> multiTags() const = 0;
+
+
     // TODO evaluate if DataArray can be replaced by shared_ptr<IDataArray>
     virtual std::shared_ptr<base::IMultiTag> createMultiTag(const std::string &name, const std::string &type,
                                                           const DataArray &positions) = 0;
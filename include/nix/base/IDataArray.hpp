@@ -13,11 +13,60 @@
 #include <nix/base/IDimensions.hpp>
 #include <nix/DataType.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/Compression.hpp>
+#include <nix/DataSelection.hpp>
+#include <nix/StringColumn.hpp>
 
 #include <string>
 #include <vector>
 
 namespace nix {
+
+/**
+ * @brief Usage statistics of the chunk cache of a DataArray.
+ *
+ * See {@link nix::DataArray::chunkCache} for details.
+ */
+struct ChunkCacheStats {
+    size_t hits = 0;       //!< Number of chunks served from the cache
+    size_t misses = 0;     //!< Number of chunks that had to be read from the file
+    size_t evictions = 0;  //!< Number of chunks dropped to stay within the capacity
+    size_t size = 0;       //!< Bytes currently held by the cache
+    size_t capacity = 0;   //!< Maximum number of bytes the cache may hold
+};
+
+
+/**
+ * @brief Min, max and mean of consecutive groups of samples of a DataArray.
+ *
+ * Point `i` summarizes the samples [start + i * step, start + (i + 1) * step)
+ * along the axis of the overview, separately for every channel (the other
+ * dimension of 2-D data). See {@link nix::DataArray::envelope} for details.
+ */
+struct Envelope {
+    ndsize_t start = 0;        //!< Position of the first sample of the first point
+    ndsize_t step = 0;         //!< Number of samples per point
+    NDSize shape;              //!< Number of points and channels
+    std::vector<double> min;   //!< Minimum of each point and channel, row-major
+    std::vector<double> max;   //!< Maximum of each point and channel, row-major
+    std::vector<double> mean;  //!< Mean of each point and channel, row-major
+};
+
+
+/**
+ * @brief Description of how the data of a DataArray will be accessed.
+ *
+ * Used to choose the chunk layout when the data is created, see
+ * {@link nix::Block::createDataArray}. All members are optional.
+ */
+struct ChunkingHint {
+    boost::optional<size_t> append_axis; //!< Dimension along which the data will grow
+    NDSize read_shape;                   //!< Shape of typical reads, 0 for the full extent of a dimension
+    size_t target_bytes = 0;             //!< Desired size of a chunk in bytes, 0 to let the library decide
+    bool contiguous = false;             //!< Store the data in one piece with a fixed extent, see DataArray::map
+};
+
+
 namespace base {
 
 /**
@@ -113,8 +162,11 @@ public:
      *
      * @param dtype     The data type that should be stored in this data array.
      * @param size      The size of the data to store.
+     * @param hint      Description of the expected access pattern, used to choose the chunk layout.
+     * @param compression   How the data should be compressed.
      */
-    virtual void createData(DataType dtype, const NDSize &size) = 0;
+    virtual void createData(DataType dtype, const NDSize &size, const ChunkingHint &hint,
+                            const Compression &compression) = 0;
 
     /**
      * @brief Check if the data array has some data.
@@ -143,15 +195,111 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read the selected elements from the data array.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer for {@link DataSelection::nelms} elements.
+     * @param selection The elements to read.
+     */
+    virtual void read(DataType dtype, void *buffer, const DataSelection &selection) const = 0;
+
+    /**
+     * @brief Write strings to the data array.
+     *
+     * @param data      The strings to write.
+     * @param count     The size of the data to write.
+     * @param offset    The position where the writing should start.
+     */
+    virtual void write(const StringColumn &data, const NDSize &count, const NDSize &offset) = 0;
+
+    /**
+     * @brief Read strings from the data array.
+     *
+     * @param data      The column the strings are stored in.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     */
+    virtual void read(StringColumn &data, const NDSize &count, const NDSize &offset) const = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
 
     virtual void dataExtent(const NDSize &extent) = 0;
 
+    /**
+     * @brief Record the extent of the valid data while the data set is
+     *        allocated beyond it.
+     *
+     * The recorded extent is reported by {@link dataExtent} until the
+     * extent of the data set is changed. See {@link nix::DataAppender}.
+     */
+    virtual void logicalExtent(const NDSize &extent) = 0;
+
+
+    virtual void logicalExtent(const none_t t) = 0;
+
 
     virtual DataType dataType(void) const = 0;
 
+    /**
+     * @brief Enable the chunk cache for reads from this data array.
+     *
+     * @param capacity      The maximum number of bytes held by the cache.
+     * @param read_ahead    The number of additional chunks along the first
+     *                      dimension that are loaded on every cache miss.
+     */
+    virtual void chunkCache(size_t capacity, size_t read_ahead) = 0;
+
+    /**
+     * @brief Disable the chunk cache and release all cached chunks.
+     */
+    virtual void chunkCache(const none_t t) = 0;
+
+
+    virtual ChunkCacheStats chunkCacheStats() const = 0;
+
+    /**
+     * @brief Get the chunk shape of the data, empty if the data is not chunked.
+     */
+    virtual NDSize chunkShape() const = 0;
+
+    /**
+     * @brief Get the location of the data in the file.
+     *
+     * Only succeeds if the data is stored in one piece, unfiltered and in
+     * the native byte order of the data type, so that it can be mapped
+     * into memory directly.
+     *
+     * @param path      The path of the file.
+     * @param offset    The position of the first element in the file.
+     *
+     * @return True if the data can be mapped, false otherwise.
+     */
+    virtual bool dataLocation(std::string &path, ndsize_t &offset) const = 0;
+
+    /**
+     * @brief Build an overview of the data and keep it up to date on writes.
+     *
+     * @param bin_size  The number of samples per bin of the finest level.
+     * @param axis      The dimension along which the samples are binned.
+     */
+    virtual void overview(size_t bin_size, size_t axis) = 0;
+
+    /**
+     * @brief Remove the overview.
+     */
+    virtual void overview(const none_t t) = 0;
+
+
+    virtual bool hasOverview() const = 0;
+
+    /**
+     * @brief Get the envelope of a range of samples, see {@link Envelope}.
+     */
+    virtual Envelope envelope(ndsize_t start, ndsize_t count, size_t points) const = 0;
+
     /**
      * @brief Destructor
      */
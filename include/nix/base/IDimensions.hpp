@@ -10,6 +10,7 @@
 #define NIX_I_DIMENSIONS_H
 
 #include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
 
 #include <string>
 #include <vector>
@@ -158,6 +159,14 @@ public:
 
     virtual void ticks(const std::vector<double> &ticks) = 0;
 
+    /**
+     * @brief Get the ticks [start, start + count) without reading all of them.
+     */
+    virtual std::vector<double> ticks(ndsize_t start, size_t count) const = 0;
+
+
+    virtual ndsize_t tickCount() const = 0;
+
 
     virtual ~IRangeDimension() {}
 
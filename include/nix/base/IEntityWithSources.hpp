@@ -55,6 +55,9 @@ public:
     virtual std::shared_ptr<ISource> getSource(const size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISource>> sources() const = 0;
+
+
     virtual ~IEntityWithSources() {}
 
 };
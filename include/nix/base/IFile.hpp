@@ -13,6 +13,8 @@
 #include <nix/base/IBlock.hpp>
 #include <nix/Platform.hpp>
 
+#include <array>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -36,6 +38,63 @@ NIXAPI enum class Implementation {
 };
 
 
+/**
+ * @brief Categories of the low level I/O operations counted by
+ *        {@link nix::File::collectIOStats}.
+ */
+NIXAPI enum class IOOperation {
+    DataRead = 0,   //!< Reads of data sets (H5Dread, H5Dread_chunk)
+    DataWrite,      //!< Writes of data sets (H5Dwrite)
+    AttrRead,       //!< Reads of attribute values (H5Aread)
+    AttrWrite,      //!< Writes of attribute values (H5Awrite)
+    AttrLookup,     //!< Existence checks, opens and creation of attributes
+    ObjectOpen,     //!< Opens of groups, data sets and other objects
+    LinkLookup,     //!< Existence checks of links (H5Lexists)
+    LinkIteration   //!< Iteration over and indexed access to the links of a group
+};
+
+/**
+ * @brief The number of {@link IOOperation} categories.
+ */
+const size_t IO_OPERATION_COUNT = 8;
+
+/**
+ * @brief The number of bins of the latency histogram of an {@link IOCounter}.
+ */
+const size_t IO_HISTOGRAM_BINS = 16;
+
+NIXAPI std::ostream &operator<<(std::ostream &out, const IOOperation op);
+
+/**
+ * @brief Number, volume and latency of the calls of one {@link IOOperation}.
+ *
+ * Bin 0 of the histogram counts the calls that took less than 1 microsecond,
+ * bin `i` those that took [2^(i-1), 2^i) microseconds. The last bin also
+ * counts all slower calls.
+ */
+struct IOCounter {
+    size_t calls = 0;         //!< Number of calls
+    size_t bytes = 0;         //!< Bytes transferred to or from memory
+    double seconds = 0;       //!< Cumulative latency of all calls
+    std::array<size_t, IO_HISTOGRAM_BINS> histogram = {{}};   //!< Calls by latency
+};
+
+/**
+ * @brief I/O statistics of a file, one {@link IOCounter} per {@link IOOperation}.
+ */
+struct IOStats {
+    std::array<IOCounter, IO_OPERATION_COUNT> counters;
+
+    const IOCounter &operator[](IOOperation op) const {
+        return counters[static_cast<size_t>(op)];
+    }
+
+    IOCounter &operator[](IOOperation op) {
+        return counters[static_cast<size_t>(op)];
+    }
+};
+
+
 namespace base {
 
 
@@ -60,6 +119,9 @@ public:
     virtual std::shared_ptr<IBlock> getBlock(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IBlock>> blocks() const = 0;
+
+
     virtual std::shared_ptr<IBlock> createBlock(const std::string &name, const std::string &type) = 0;
 
 
@@ -78,6 +140,9 @@ public:
     virtual std::shared_ptr<ISection> getSection(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISection>> sections() const = 0;
+
+
     virtual ndsize_t sectionCount() const = 0;
 
 
@@ -117,12 +182,30 @@ public:
     virtual void forceCreatedAt(time_t time) = 0;
 
 
+    virtual void flush() = 0;
+
+
     virtual void close() = 0;
 
 
     virtual bool isOpen() const = 0;
 
 
+    virtual void readThreads(size_t threads) = 0;
+
+
+    virtual size_t readThreads() const = 0;
+
+
+    virtual void collectIOStats(bool enable) = 0;
+
+
+    virtual IOStats ioStats() const = 0;
+
+
+    virtual void resetIOStats() = 0;
+
+
     virtual ~IFile() {}
 
 };
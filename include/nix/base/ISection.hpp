@@ -18,11 +18,24 @@
 #include <nix/NDSize.hpp>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace nix {
 namespace base {
 
+/**
+ * @brief Restricts the sections returned by {@link ISection::querySections}
+ *        to those with the given id, name or type, or with a property of the
+ *        given name. Empty fields match all sections.
+ */
+struct SectionQuery {
+    std::string id;
+    std::string name;
+    std::string type;
+    std::string property;
+};
+
 /**
  * @brief Interface for implementations of the Section entity.
  *
@@ -84,11 +97,22 @@ public:
     virtual std::shared_ptr<ISection> getSection(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISection>> sections() const = 0;
+
+
     virtual std::shared_ptr<ISection> createSection(const std::string &name, const std::string &type) = 0;
 
 
     virtual bool deleteSection(const std::string &name_or_id) = 0;
 
+    /**
+     * @brief The section and its descendants up to max_depth levels below it
+     *        that match the query, in breadth-first order and together with
+     *        their depth relative to the section.
+     */
+    virtual std::vector<std::pair<std::shared_ptr<ISection>, size_t>> querySections(const SectionQuery &query,
+                                                                                      size_t max_depth) const = 0;
+
     //--------------------------------------------------
     // Methods for property access
     //--------------------------------------------------
@@ -105,6 +129,9 @@ public:
     virtual std::shared_ptr<IProperty> getProperty(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<IProperty>> properties() const = 0;
+
+
     virtual std::shared_ptr<IProperty> createProperty(const std::string &name, const DataType &dtype) = 0;
 
 
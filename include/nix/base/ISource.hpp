@@ -14,10 +14,23 @@
 
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace nix {
 namespace base {
 
+/**
+ * @brief Restricts the sources returned by {@link ISource::querySources}
+ *        and {@link IBlock::querySources} to those with the given id, name
+ *        or type. Empty fields match all sources.
+ */
+struct SourceQuery {
+    std::string id;
+    std::string name;
+    std::string type;
+};
+
 
 /**
  * @brief Interface for implementations of the Source entity.
@@ -37,6 +50,9 @@ public:
     virtual std::shared_ptr<ISource> getSource(size_t index) const = 0;
 
 
+    virtual std::vector<std::shared_ptr<ISource>> sources() const = 0;
+
+
     virtual ndsize_t sourceCount() const = 0;
 
 
@@ -45,6 +61,14 @@ public:
 
     virtual bool deleteSource(const std::string &name_or_id) = 0;
 
+    /**
+     * @brief The source and its descendants up to max_depth levels below it
+     *        that match the query, in breadth-first order and together with
+     *        their depth relative to the source.
+     */
+    virtual std::vector<std::pair<std::shared_ptr<ISource>, size_t>> querySources(const SourceQuery &query,
+                                                                                    size_t max_depth) const = 0;
+
 
     virtual ~ISource() {}
 
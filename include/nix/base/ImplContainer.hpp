@@ -76,6 +76,23 @@ protected:
         return entities;
     }
 
+    template<typename TENT, typename TBASE>
+    std::vector<TENT> filterEntities(
+        const std::vector<std::shared_ptr<TBASE>> &candidates,
+        std::function<bool(TENT)> filter) const
+    {
+        std::vector<TENT> entities;
+
+        for (const auto &impl : candidates) {
+            TENT candidate(impl);
+            if (candidate && filter(candidate)) {
+                entities.push_back(candidate);
+            }
+        }
+
+        return entities;
+    }
+
 public:
 
     ImplContainer()
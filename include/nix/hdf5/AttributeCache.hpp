@@ -0,0 +1,96 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ATTRIBUTE_CACHE_H
+#define NIX_ATTRIBUTE_CACHE_H
+
+#include <nix/hdf5/LocID.hpp>
+#include <nix/Platform.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Cache of the standard string attributes of an entity ("entity_id",
+ *        "name", "type", "definition", "created_at" and "updated_at").
+ *
+ * On first access all of them are read in a single pass over the attributes
+ * of the object (H5Aiterate), instead of checking, opening and reading
+ * each one separately on every access. Writes go to the file and the cache.
+ *
+ * Caches are shared by all backend objects of an entity and registered by
+ * the address of the entity object in the FileState of the file. Only weak
+ * references are held by the registry, so a cache lives as long as the
+ * objects using it; since these keep the entity object open, the address
+ * can not be reused in the meantime. The registry and the values of each
+ * cache are guarded by mutexes.
+ */
+class NIXAPI AttributeCache {
+
+public:
+
+    /**
+     * @brief Get the shared cache of the object, creating it if necessary.
+     *
+     * Nothing is read until the first access.
+     */
+    static std::shared_ptr<AttributeCache> forObject(const LocID &obj);
+
+    /**
+     * @brief Update the cached value of an attribute that was written to
+     *        the object at the given address without going through its cache.
+     */
+    static void update(const ObjectAddress &address, const std::string &name, const std::string &value);
+
+    /**
+     * @brief Get the value of an attribute.
+     *
+     * @return False if the object has no such attribute.
+     */
+    bool get(const LocID &obj, const std::string &name, std::string &value);
+
+    /**
+     * @brief Check if the object has the attribute.
+     */
+    bool has(const LocID &obj, const std::string &name);
+
+    /**
+     * @brief Write the attribute to the object and the cache.
+     */
+    void set(const LocID &obj, const std::string &name, const std::string &value);
+
+    /**
+     * @brief Remove the attribute from the object and the cache.
+     */
+    void remove(const LocID &obj, const std::string &name);
+
+    /**
+     * @brief True if the attribute is one of the cached ones.
+     */
+    static bool cached(const std::string &name);
+
+private:
+
+    void load(const LocID &obj);
+
+    // guards the values, which are also updated through the registry
+    std::mutex lock;
+    bool loaded = false;
+    std::map<std::string, std::string> values;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_ATTRIBUTE_CACHE_H
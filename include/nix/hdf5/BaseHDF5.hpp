@@ -18,7 +18,9 @@
 
 #include <hdf5.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 #include <boost/optional.hpp>
 
 namespace nix {
@@ -46,7 +48,11 @@ public:
 
     void finish() {
         for (ndsize_t i = 0; i < nelms; i++) {
-            data[i] = buffer[i];
+            if (buffer[i] != nullptr) {
+                data[i] = buffer[i];
+            } else {
+                data[i].clear();
+            }
         }
     }
 
@@ -206,6 +212,52 @@ struct NIXAPI HErr {
 };
 
 
+/**
+ * @brief Memory for the variable length data of a read.
+ *
+ * HDF5 allocates every variable length element (e.g. every string) it
+ * reads separately and all of them have to be freed one by one afterwards.
+ * Passing the transfer property list of an arena to the read makes HDF5
+ * take the memory from a few large blocks instead, which are all released
+ * at once when the arena is destroyed. No vlen reclaim is needed then.
+ */
+class NIXAPI VlenArena {
+
+public:
+
+    VlenArena();
+
+    VlenArena(const VlenArena &other) = delete;
+
+    VlenArena &operator=(const VlenArena &other) = delete;
+
+    /**
+     * @brief The data transfer property list to read with.
+     */
+    hid_t xfer() const {
+        return plist.h5id();
+    }
+
+    void *allocate(size_t size);
+
+    /**
+     * @brief The number of bytes handed out so far.
+     */
+    size_t used() const {
+        return total;
+    }
+
+private:
+
+    BaseHDF5                             plist;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char                                *cur;
+    size_t                               avail;
+    size_t                               block_size;
+    size_t                               total;
+};
+
+
 } // namespace hdf5
 } // namespace nix
 
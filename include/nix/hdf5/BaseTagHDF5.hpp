@@ -62,6 +62,9 @@ public:
     virtual std::shared_ptr<base::IDataArray> getReference(size_t index) const;
 
 
+    virtual std::vector<std::shared_ptr<base::IDataArray>> references() const;
+
+
     virtual void addReference(const std::string &name_or_id);
 
 
@@ -86,6 +89,9 @@ public:
     virtual std::shared_ptr<base::IFeature> getFeature(size_t index) const;
 
 
+    virtual std::vector<std::shared_ptr<base::IFeature>> features() const;
+
+
     virtual std::shared_ptr<base::IFeature> createFeature(const std::string &name_or_id, LinkType link_type);
 
 
@@ -11,6 +11,7 @@
 
 #include <nix/base/IBlock.hpp>
 #include <nix/hdf5/EntityWithMetadataHDF5.hpp>
+#include <nix/hdf5/EntityIndex.hpp>
 
 #include <vector>
 #include <string>
@@ -28,6 +29,7 @@ class BlockHDF5 : virtual public base::IBlock, public EntityWithMetadataHDF5,
 private:
 
     optGroup data_array_group, tag_group, multi_tag_group, source_group;
+    EntityIndex data_array_index, tag_index, multi_tag_index, source_index;
 
 public:
 
@@ -78,11 +80,36 @@ public:
     ndsize_t sourceCount() const;
 
 
+    std::vector<std::shared_ptr<base::ISource>> sources() const;
+
+
     std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
 
 
     bool deleteSource(const std::string &name_or_id);
 
+
+    std::vector<std::pair<std::shared_ptr<base::ISource>, size_t>> querySources(const base::SourceQuery &query,
+                                                                                 size_t max_depth) const;
+
+
+    std::vector<std::shared_ptr<base::IDataArray>> referencingDataArrays(const std::string &source_id) const;
+
+
+    std::vector<std::shared_ptr<base::ITag>> referencingTags(const std::string &source_id) const;
+
+
+    std::vector<std::shared_ptr<base::IMultiTag>> referencingMultiTags(const std::string &source_id) const;
+
+    /**
+     * @brief The group of the source with the given id anywhere in the
+     *        source tree of the block.
+     *
+     * Sources directly below the block are found with its entity index,
+     * deeper ones with the {@link SourceIndex} of the file.
+     */
+    boost::optional<Group> findSourceGroup(const std::string &id) const;
+
     //--------------------------------------------------
     // Methods concerning data arrays
     //--------------------------------------------------
@@ -99,8 +126,16 @@ public:
     ndsize_t dataArrayCount() const;
 
 
+    std::vector<std::shared_ptr<base::IDataArray>> dataArrays() const;
+
+
+    void describeDataArrays(DataArraySummary &summary) const;
+
+
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
-                                                      nix::DataType data_type, const NDSize &shape) override;
+                                                      nix::DataType data_type, const NDSize &shape,
+                                                      const ChunkingHint &hint,
+                                                      const Compression &compression) override;
 
 
     bool deleteDataArray(const std::string &name_or_id);
@@ -121,6 +156,9 @@ public:
     ndsize_t tagCount() const;
 
 
+    std::vector<std::shared_ptr<base::ITag>> tags() const;
+
+
     std::shared_ptr<base::ITag> createTag(const std::string &name, const std::string &type,
                                                       const std::vector<double> &position);
 
@@ -143,6 +181,9 @@ public:
     ndsize_t multiTagCount() const;
 
 
+    std::vector<std::shared_ptr<base::IMultiTag>> multiTags() const;
+
+
     std::shared_ptr<base::IMultiTag> createMultiTag(const std::string &name, const std::string &type,
                                                   const DataArray &positions);
 
@@ -0,0 +1,131 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CHUNK_CACHE_H
+#define NIX_CHUNK_CACHE_H
+
+#include <nix/hdf5/DataSetHDF5.hpp>
+#include <nix/base/IDataArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Least recently used cache of the chunks of a data set.
+ *
+ * The cache holds chunk aligned blocks of the data set in its native
+ * data type. Chunks missing for a read are loaded with a single read
+ * covering their bounding box, which is extended by a configurable number
+ * of chunks along the first dimension (read-ahead). Requested data is then
+ * assembled from the cached chunks and converted to the requested type.
+ *
+ * Caches are registered per data set (identified by its address) in the
+ * FileState of the file, so all handles of an entity share the same cache
+ * and the caches are dropped when the file is closed. The registry and
+ * every cache are guarded by a mutex.
+ */
+class NIXAPI ChunkCache {
+
+public:
+
+    /**
+     * @brief Create a cache for the given data set.
+     *
+     * @param data          The data set to cache.
+     * @param capacity      The maximum number of bytes held by the cache.
+     * @param read_ahead    The number of chunks to read ahead along the first dimension.
+     */
+    ChunkCache(const DataSet &data, size_t capacity, size_t read_ahead);
+
+    /**
+     * @brief Read data through the cache.
+     *
+     * @param extent    The logical extent of the data, requests beyond it
+     *                  are not served.
+     *
+     * @return False if the request can not be served by the cache (e.g.
+     *         string data, a request outside of the extent or larger than
+     *         the capacity), in which case nothing was read and the caller
+     *         has to read the data itself.
+     */
+    bool read(const DataSet &data, const NDSize &extent, DataType dtype, void *buffer,
+              const NDSize &count, const NDSize &offset);
+
+    /**
+     * @brief Drop all cached chunks that overlap the given region.
+     */
+    void invalidate(const NDSize &count, const NDSize &offset);
+
+    /**
+     * @brief Drop all cached chunks.
+     */
+    void clear();
+
+    ChunkCacheStats stats() const;
+
+    /**
+     * @brief Get the registered cache of the data set or an empty pointer
+     *        if caching is not enabled for it.
+     */
+    static std::shared_ptr<ChunkCache> find(const DataSet &data);
+
+    /**
+     * @brief Enable (or reconfigure) the cache of the data set.
+     */
+    static void enable(const DataSet &data, size_t capacity, size_t read_ahead);
+
+    /**
+     * @brief Disable the cache of the data set and release its memory.
+     */
+    static void disable(const DataSet &data);
+
+    /**
+     * @brief Drop all caches of the given file.
+     *
+     * @param file        Any object of the file (e.g. the root group).
+     */
+    static void clearCache(const LocID &file);
+
+private:
+
+    typedef std::vector<ndsize_t> ChunkIndex;
+
+    struct Chunk {
+        NDSize shape;
+        std::vector<char> data;
+        std::list<ChunkIndex>::iterator lru_pos;
+    };
+
+    bool cacheable;
+    DataType native_type;
+    size_t element_size;
+    NDSize chunk_shape;
+    size_t read_ahead;
+
+    std::map<ChunkIndex, Chunk> chunks;
+    std::list<ChunkIndex> lru;
+    ChunkCacheStats counters;
+    mutable std::mutex lock;
+
+    void load(const DataSet &data, const NDSize &extent, const NDSize &first, const NDSize &last);
+    void touch(Chunk &chunk);
+    void evict();
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_CHUNK_CACHE_H
@@ -125,7 +125,15 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size);
+    virtual void createData(DataType dtype, const NDSize &size, const ChunkingHint &hint,
+                            const Compression &compression);
+
+    /**
+     * @brief Throw the exception {@link createData} would throw for the
+     *        arguments, so that nothing is created for invalid ones.
+     */
+    static void checkData(DataType dtype, const NDSize &size, const ChunkingHint &hint,
+                          const Compression &compression);
 
 
     bool hasData() const;
@@ -137,6 +145,15 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const DataSelection &selection) const;
+
+
+    void write(const StringColumn &data, const NDSize &count, const NDSize &offset);
+
+
+    void read(StringColumn &data, const NDSize &count, const NDSize &offset) const;
+
+
     NDSize dataExtent(void) const;
 
 
@@ -145,10 +162,49 @@ public:
 
     DataType dataType(void) const;
 
+
+    void chunkCache(size_t capacity, size_t read_ahead);
+
+
+    void chunkCache(const none_t t);
+
+
+    ChunkCacheStats chunkCacheStats() const;
+
+
+    void logicalExtent(const NDSize &extent);
+
+
+    void logicalExtent(const none_t t);
+
+
+    NDSize chunkShape() const;
+
+
+    bool dataLocation(std::string &path, ndsize_t &offset) const;
+
+
+    void overview(size_t bin_size, size_t axis);
+
+
+    void overview(const none_t t);
+
+
+    bool hasOverview() const;
+
+
+    Envelope envelope(ndsize_t start, ndsize_t count, size_t points) const;
+
 private:
 
     // small helper for handling dimension groups
     Group createDimensionGroup(size_t index);
+
+    // bring the overview up to date after a write or change of the extent
+    void updateOverview(const NDSize &count, const NDSize &offset);
+
+    // throw OutOfBounds for reads beyond the logical extent
+    void checkBounds(const NDSize &count, const NDSize &offset) const;
 };
 
 
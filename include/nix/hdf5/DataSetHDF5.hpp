@@ -14,11 +14,15 @@
 #include <nix/hdf5/DataTypeHDF5.hpp>
 #include <nix/hdf5/LocID.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/StringColumn.hpp>
 #include <nix/Value.hpp>
 
 #include <nix/Platform.hpp>
 
 namespace nix {
+
+struct ChunkingHint;
+
 namespace hdf5 {
 
 class NIXAPI DataSet : public LocID {
@@ -34,6 +38,7 @@ public:
     DataSet(const DataSet &other);
 
     void read(hid_t memType, void *data) const;
+    void read(hid_t memType, void *data, const VlenArena &arena) const;
     void write(hid_t memType, const void *data);
 
     void read(DataType dtype, const NDSize &size, void *data) const;
@@ -42,6 +47,12 @@ public:
     void read(DataType dtype, void *data, const Selection &fileSel, const Selection &memSel) const;
     void write(DataType dtype, const void *data, const Selection &fileSel, const Selection &memSel);
 
+    void read(StringColumn &data) const;
+    void write(const StringColumn &data);
+
+    void read(StringColumn &data, const Selection &fileSel, const Selection &memSel) const;
+    void write(const StringColumn &data, const Selection &fileSel, const Selection &memSel);
+
     void read(std::vector<Value> &values) const;
     void write(const std::vector<Value> &values);
 
@@ -57,6 +68,12 @@ public:
 
     static NDSize guessChunking(NDSize dims, size_t element_size);
 
+    static NDSize planChunking(NDSize dims, size_t element_size, const ChunkingHint &hint);
+
+    NDSize chunking() const;
+
+    haddr_t contiguousOffset() const;
+
     void setExtent(const NDSize &dims);
     Selection createSelection() const;
     NDSize size() const;
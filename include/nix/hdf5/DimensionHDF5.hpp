@@ -172,8 +172,23 @@ public:
     void ticks(const std::vector<double> &ticks);
 
 
+    std::vector<double> ticks(ndsize_t start, size_t count) const;
+
+
+    ndsize_t tickCount() const;
+
+
     virtual ~RangeDimensionHDF5();
 
+private:
+
+    // ticks are kept in memory if there are no more than this
+    static const size_t MAX_CACHED_TICKS;
+
+    mutable std::shared_ptr<const std::vector<double>> cached_ticks;
+
+    // the cached ticks, null if there are too many to cache
+    std::shared_ptr<const std::vector<double>> loadTicks() const;
 };
 
 
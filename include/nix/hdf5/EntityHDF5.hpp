@@ -13,6 +13,7 @@
 
 #include <nix/base/IEntity.hpp>
 #include <nix/hdf5/Group.hpp>
+#include <nix/hdf5/AttributeCache.hpp>
 
 #include <string>
 #include <memory>
@@ -31,6 +32,8 @@ private:
     std::shared_ptr<base::IFile>  entity_file;
     Group                         entity_group;
 
+    mutable std::shared_ptr<AttributeCache> attr_cache;
+
 public:
 
     EntityHDF5(const std::shared_ptr<base::IFile> &file, const Group &group);
@@ -75,6 +78,11 @@ protected:
 
     std::shared_ptr<base::IFile> file() const;
 
+    /**
+     * @brief The cache of the standard attributes of the entity group.
+     */
+    AttributeCache &attributes() const;
+
 };
 
 
@@ -0,0 +1,110 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_INDEX_H
+#define NIX_ENTITY_INDEX_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <string>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Index that maps entity ids to the names of the entities inside
+ *        a container group (e.g. the "data_arrays" group of a Block).
+ *
+ * The index is stored in the file next to the container, as a data set
+ * named "<container>_index" (e.g. "data_arrays_index" inside the group of
+ * the Block) of shape {n, 2} holding the id and the link name of each
+ * entity as strings. Its attributes record the layout version
+ * ("index_version") and the number of links ("link_count") and highest
+ * link creation order ("link_order") of the container when it was written.
+ * The data set holds no references to the entities, so readers that do not
+ * know it are not affected and entities deleted by them are not kept alive.
+ *
+ * Lookups are served from an in-memory copy that is shared by all handles of
+ * the container. It is read from the stored index if the container did not
+ * change since, and otherwise filled with a single scan over the links of the
+ * container. {@link add} and {@link remove} keep it up to date, and
+ * {@link flush} writes the changed indexes of a file that is open for
+ * writing. Every hit is verified against the container, and a changed
+ * number of links or creation order triggers another scan, so changes made
+ * by other writers are detected.
+ *
+ * The in-memory copies are part of the FileState of the file, guarded by a
+ * mutex, and may be used from several threads.
+ */
+class NIXAPI EntityIndex {
+
+public:
+
+    EntityIndex() { }
+
+    /**
+     * @brief Look up the name of the link to the entity with the given id.
+     *
+     * @param container   The opened container group.
+     * @param id          The id of the entity to look for.
+     *
+     * @return The name of the entity inside the container or an empty optional.
+     */
+    boost::optional<std::string> lookup(const Group &container, const std::string &id) const;
+
+    /**
+     * @brief Like {@link Group::findGroupByNameOrAttribute} for the
+     *        "entity_id" attribute, but uses the index for the id lookup.
+     */
+    boost::optional<Group> findGroupByNameOrId(const Group &container, const std::string &name_or_id) const;
+
+    /**
+     * @brief Like {@link Group::findDataByNameOrAttribute} for the
+     *        "entity_id" attribute, but uses the index for the id lookup.
+     */
+    boost::optional<DataSet> findDataByNameOrId(const Group &container, const std::string &name_or_id) const;
+
+    /**
+     * @brief Add an entity that was just created inside the container.
+     *
+     * @param container   The opened container group.
+     * @param id          The id of the new entity.
+     * @param name        The name of the link to the entity inside the container.
+     */
+    void add(const Group &container, const std::string &id, const std::string &name) const;
+
+    /**
+     * @brief Remove an entity from the index. Must be called before the
+     *        entity is unlinked from the container.
+     *
+     * The indexes of the containers nested in the entity are dropped as well,
+     * since their addresses might get reused once the entity is gone.
+     *
+     * @param container   The opened container group.
+     * @param id          The id of the entity to remove.
+     * @param name        The name of the link to the entity inside the container.
+     */
+    void remove(const Group &container, const std::string &id, const std::string &name) const;
+
+    /**
+     * @brief Write the indexes of the given file that changed since they
+     *        were read. Does nothing if the file is opened read-only.
+     *
+     * @param file        Any object of the file (e.g. the root group).
+     */
+    static void flush(const LocID &file);
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_ENTITY_INDEX_H
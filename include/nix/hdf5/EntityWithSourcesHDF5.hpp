@@ -72,6 +72,9 @@ public:
 
     std::shared_ptr<base::ISource> getSource(const size_t index) const;
 
+
+    std::vector<std::shared_ptr<base::ISource>> sources() const;
+
     /**
      * Destructor.
      */
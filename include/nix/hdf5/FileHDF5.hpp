@@ -12,6 +12,8 @@
 #include <nix/base/IFile.hpp>
 
 #include <nix/hdf5/Group.hpp>
+#include <nix/hdf5/EntityIndex.hpp>
+#include <nix/hdf5/FileState.hpp>
 
 #include <string>
 #include <memory>
@@ -29,6 +31,10 @@ private:
 
     /* groups representing different sections of the file */
     Group root, metadata, data;
+    EntityIndex section_index, block_index;
+    size_t read_threads;
+    /* caches and indexes of the backend, dropped on close */
+    std::shared_ptr<FileState> state;
 
 public:
 
@@ -58,6 +64,9 @@ public:
     std::shared_ptr<base::IBlock> getBlock(size_t index) const;
 
 
+    std::vector<std::shared_ptr<base::IBlock>> blocks() const;
+
+
     std::shared_ptr<base::IBlock> createBlock(const std::string &name, const std::string &type);
 
 
@@ -76,6 +85,9 @@ public:
     std::shared_ptr<base::ISection> getSection(size_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISection>> sections() const;
+
+
     ndsize_t sectionCount() const;
 
 
@@ -116,12 +128,30 @@ public:
     void forceCreatedAt(time_t t);
 
 
+    void flush() override;
+
+
     void close() override;
 
 
     bool isOpen() const;
 
 
+    void readThreads(size_t threads);
+
+
+    size_t readThreads() const;
+
+
+    void collectIOStats(bool enable);
+
+
+    IOStats ioStats() const;
+
+
+    void resetIOStats();
+
+
     bool operator==(const FileHDF5 &other) const;
 
 
@@ -0,0 +1,176 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_FILE_STATE_H
+#define NIX_FILE_STATE_H
+
+#include <nix/hdf5/LocID.hpp>
+#include <nix/Platform.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief State the HDF5 backend keeps for an open file, like the caches of
+ *        entity handles and attributes or the indexes of entities.
+ *
+ * Every kind of state is a part of its own type, which is created on first
+ * use and found via the file number of any object of the file, so all
+ * handles of a file share it.
+ *
+ * The state is owned by the FileHDF5 objects of the file and dropped as a
+ * whole when the last of them is closed, as file numbers may be reused
+ * afterwards. Files that are opened otherwise get a new state on every
+ * access, i.e. nothing is cached for them. The registry of the states and
+ * the parts of each state are guarded by mutexes; the parts guard their
+ * own contents.
+ */
+class NIXAPI FileState {
+
+public:
+
+    /**
+     * @brief A part that holds one immutable value, built on demand and
+     *        dropped when it gets outdated (e.g. an index of the file).
+     */
+    template<typename T>
+    class Lazy {
+
+    public:
+
+        /**
+         * @brief Get the value, building it with make() if there is none.
+         *
+         * The value is built without holding the lock; it is only kept if
+         * it was not invalidated in the meantime.
+         */
+        template<typename F>
+        std::shared_ptr<const T> get(F make) {
+            size_t built_at;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (value) {
+                    return value;
+                }
+                built_at = generation;
+            }
+
+            std::shared_ptr<const T> built = make();
+
+            std::lock_guard<std::mutex> guard(lock);
+            if (generation == built_at) {
+                value = built;
+            }
+            return built;
+        }
+
+        /**
+         * @brief Drop the value, the next access builds a new one.
+         */
+        void invalidate() {
+            std::lock_guard<std::mutex> guard(lock);
+            value.reset();
+            generation++;
+        }
+
+    private:
+
+        std::mutex lock;
+        std::shared_ptr<const T> value;
+        size_t generation = 0;
+    };
+
+    /**
+     * @brief Get the state of the file, creating it if necessary.
+     *
+     * The state lives as long as the returned pointer (or another one to
+     * the same state) is held.
+     *
+     * @param file        Any object of the file (e.g. the root group).
+     */
+    static std::shared_ptr<FileState> open(const LocID &file) {
+        return open(file.address().first);
+    }
+
+    static std::shared_ptr<FileState> open(unsigned long fileno);
+
+    /**
+     * @brief Whether the file has a state that is kept, i.e. whether it is
+     *        opened as a FileHDF5.
+     */
+    static bool exists(unsigned long fileno) {
+        return static_cast<bool>(lookup(fileno));
+    }
+
+    /**
+     * @brief Get the part of type T of the state of the file, creating
+     *        the part if necessary.
+     *
+     * If the file has no state, the part belongs to a new state that is
+     * dropped together with the returned pointer.
+     */
+    template<typename T>
+    static std::shared_ptr<T> get(unsigned long fileno) {
+        return open(fileno)->part<T>(true);
+    }
+
+    template<typename T>
+    static std::shared_ptr<T> get(const LocID &obj) {
+        return get<T>(obj.address().first);
+    }
+
+    /**
+     * @brief Get the part of type T of the state of the file or an empty
+     *        pointer if the file has no such part.
+     */
+    template<typename T>
+    static std::shared_ptr<T> find(unsigned long fileno) {
+        std::shared_ptr<FileState> state = lookup(fileno);
+        return state ? state->part<T>(false) : std::shared_ptr<T>();
+    }
+
+    template<typename T>
+    static std::shared_ptr<T> find(const LocID &obj) {
+        return find<T>(obj.address().first);
+    }
+
+private:
+
+    static std::shared_ptr<FileState> lookup(unsigned long fileno);
+
+    template<typename T>
+    std::shared_ptr<T> part(bool create) {
+        std::lock_guard<std::mutex> guard(lock);
+
+        auto it = parts.find(typeid(T));
+        if (it != parts.end()) {
+            return std::static_pointer_cast<T>(it->second);
+        }
+
+        std::shared_ptr<T> created;
+        if (create) {
+            created = std::make_shared<T>();
+            parts.emplace(typeid(T), created);
+        }
+        return created;
+    }
+
+    std::mutex lock;
+    std::map<std::type_index, std::shared_ptr<void>> parts;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_FILE_STATE_H
@@ -0,0 +1,99 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_FILTERS_HDF5_H
+#define NIX_FILTERS_HDF5_H
+
+#include <nix/hdf5/BaseHDF5.hpp>
+#include <nix/Compression.hpp>
+#include <nix/Platform.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Filter id of the LZ4 codec.
+ *
+ * This is the id registered with the HDF Group for LZ4; the data
+ * layout matches the one of the LZ4 filter plugin, so files can be read
+ * by other HDF5 applications that have the plugin installed.
+ */
+const H5Z_filter_t FILTER_LZ4 = 32004;
+
+/**
+ * @brief Register the filters implemented by the library with HDF5.
+ *
+ * Safe to call repeatedly; the filters are only registered once.
+ */
+NIXAPI void registerFilters();
+
+/**
+ * @brief Check that the filters for the given compression settings are
+ *        available and their parameters are valid.
+ */
+NIXAPI void checkFilters(const Compression &compression);
+
+/**
+ * @brief Add the filters for the given compression settings to a data
+ *        set creation property list.
+ */
+NIXAPI void setFilters(const BaseHDF5 &dcpl, const Compression &compression);
+
+/**
+ * @brief The filters of a data set, used to decode chunks obtained with
+ *        direct chunk reads without calling into the HDF5 library.
+ *
+ * Shuffle, LZ4 and, if the library was built with zlib, deflate can be
+ * decoded; {@link decodable} is false if any other filter is used.
+ * Only the constructor calls HDF5, {@link decode} can be called from
+ * several threads at once.
+ */
+class NIXAPI FilterPipeline {
+
+public:
+
+    /**
+     * @brief Read the filters from a data set creation property list.
+     */
+    explicit FilterPipeline(const BaseHDF5 &dcpl);
+
+    bool empty() const {
+        return filters.empty();
+    }
+
+    bool decodable() const {
+        return supported;
+    }
+
+    /**
+     * @brief Decode a raw chunk in place.
+     *
+     * @param mask       The filter mask returned by the direct chunk read.
+     * @param chunk      The raw chunk, replaced by the decoded data.
+     * @param size_hint  The size of the decoded chunk, LZ4 headers claiming more are refused.
+     */
+    void decode(uint32_t mask, std::vector<uint8_t> &chunk, size_t size_hint) const;
+
+private:
+
+    struct Filter {
+        H5Z_filter_t id;
+        std::vector<unsigned int> values;
+    };
+
+    std::vector<Filter> filters;
+    bool supported;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_FILTERS_HDF5_H
@@ -13,10 +13,12 @@
 #include <nix/hdf5/DataSetHDF5.hpp>
 #include <nix/hdf5/DataSpace.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/Compression.hpp>
 #include <nix/Platform.hpp>
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -25,6 +27,20 @@ namespace hdf5 {
 
 struct optGroup;
 
+/**
+ * @brief Name and target of a link inside a group.
+ */
+struct Link {
+    std::string   name;
+    ObjectAddress address;   //!< The address part is HADDR_UNDEF for soft and external links
+    H5O_type_t    type;      //!< H5O_TYPE_UNKNOWN unless requested, and for soft and external links
+};
+
+/**
+ * @brief Callback for Group::visitLinks(), returning false stops the iteration.
+ */
+typedef std::function<bool(const Link &)> LinkVisitor;
+
 /**
  * TODO documentation
  */
@@ -42,6 +58,20 @@ public:
 
     bool hasObject(const std::string &path) const;
     ndsize_t objectCount() const;
+
+    /**
+     * @brief Call the visitor for the links of the group, in the same order as
+     *        objectName() uses, with a single iteration over the group.
+     *
+     * The type of the linked objects is only looked up if object_type is true.
+     */
+    void visitLinks(const LinkVisitor &visitor, bool object_type = false) const;
+
+    /**
+     * @brief All links of the group, in the same order as objectName() uses,
+     *        obtained in a single pass.
+     */
+    std::vector<Link> links(bool object_type = false) const;
     std::string objectName(ndsize_t index) const;
 
     bool hasData(const std::string &name) const;
@@ -50,7 +80,8 @@ public:
 
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
             const NDSize &size, const NDSize &maxsize = {}, NDSize chunks = {},
-            bool maxSizeUnlimited = true, bool guessChunks = true) const;
+            bool maxSizeUnlimited = true, bool guessChunks = true,
+            const Compression &compression = Compression()) const;
 
     DataSet openData(const std::string &name) const;
     void removeData(const std::string &name);
@@ -0,0 +1,117 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_HANDLE_CACHE_H
+#define NIX_HANDLE_CACHE_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Cache of the backend objects of entities, keyed by the address
+ *        of the entity group in the file.
+ *
+ * Getting an entity that is still referenced by some handle returns the
+ * existing backend object instead of opening its group and constructing a
+ * new one. Only weak references are held, so an entry lives exactly as
+ * long as the object it refers to; since the object keeps its group open,
+ * the address can not be reused by another object in the meantime.
+ *
+ * The entries are kept in the FileState of the file and thus dropped when
+ * the file is closed.
+ */
+class NIXAPI HandleCache {
+
+public:
+
+    /**
+     * @brief Get the cached object at the address or an empty pointer.
+     */
+    template<typename T>
+    static std::shared_ptr<T> find(const ObjectAddress &address) {
+        std::shared_ptr<void> obj = lookup(address, typeid(T));
+        return std::static_pointer_cast<T>(obj);
+    }
+
+    /**
+     * @brief Add an object to the cache.
+     */
+    template<typename T>
+    static void add(const ObjectAddress &address, const std::shared_ptr<T> &obj) {
+        insert(address, typeid(T), obj);
+    }
+
+    /**
+     * @brief Get the cached object of the entity group or create one with
+     *        make() and add it.
+     */
+    template<typename T, typename F>
+    static std::shared_ptr<T> get(const LocID &group, F make) {
+        ObjectAddress address = group.address();
+        std::shared_ptr<T> obj = find<T>(address);
+
+        if (!obj) {
+            obj = make();
+            add(address, obj);
+        }
+
+        return obj;
+    }
+
+    /**
+     * @brief All entities of the container, obtained with a single iteration
+     *        over its links; objects of the entities are reused if cached and
+     *        created with make() from the entity group otherwise.
+     */
+    template<typename I, typename T, typename F>
+    static std::vector<std::shared_ptr<I>> all(const boost::optional<Group> &container, F make) {
+        std::vector<std::shared_ptr<I>> entities;
+
+        if (!container) {
+            return entities;
+        }
+
+        container->visitLinks([&](const Link &link) {
+            std::shared_ptr<T> entity = find<T>(link.address);
+
+            if (!entity) {
+                if (!container->hasGroup(link.name)) {
+                    return true;
+                }
+                entity = make(container->openGroup(link.name, false));
+                add(link.address, entity);
+            }
+
+            entities.push_back(entity);
+            return true;
+        });
+
+        return entities;
+    }
+
+private:
+
+    static std::shared_ptr<void> lookup(const ObjectAddress &address, const std::type_index &type);
+    static void insert(const ObjectAddress &address, const std::type_index &type, const std::shared_ptr<void> &obj);
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_HANDLE_CACHE_H
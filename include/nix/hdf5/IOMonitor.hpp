@@ -0,0 +1,119 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_IO_MONITOR_H
+#define NIX_IO_MONITOR_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/Platform.hpp>
+
+#include <hdf5.h>
+
+#include <chrono>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief I/O statistics of the files that collect them.
+ *
+ * Operations are attributed to the file of the object they work on. The
+ * statistics are part of the FileState of the file, so they are shared by
+ * all handles of the file and dropped when it is closed. As long as no
+ * file collects statistics, {@link active} is false and the operations are
+ * not measured at all.
+ */
+class NIXAPI IOMonitor {
+
+public:
+
+    /**
+     * @brief Start (or stop) collecting statistics for the file.
+     *
+     * Stopping keeps the counters collected so far.
+     */
+    static void enable(hid_t file, bool enable);
+
+    /**
+     * @brief Get the statistics of the file, all zero if none were collected.
+     */
+    static IOStats stats(hid_t file);
+
+    /**
+     * @brief Reset the counters of the file to zero.
+     */
+    static void reset(hid_t file);
+
+    /**
+     * @brief True if any file collects statistics.
+     */
+    static bool active();
+
+    /**
+     * @brief Count an operation on the given object, if its file collects
+     *        statistics. Never throws.
+     */
+    static void record(hid_t obj, IOOperation op, size_t bytes, double seconds);
+};
+
+
+/**
+ * @brief Measures one operation from its construction to its destruction
+ *        and records it with the {@link IOMonitor}.
+ */
+class NIXAPI IOProbe {
+
+public:
+
+    typedef std::chrono::steady_clock clock_t;
+
+    IOProbe(hid_t obj, IOOperation op)
+        : obj(obj), op(op), nbytes(0), running(IOMonitor::active()) {
+        if (running) {
+            start = clock_t::now();
+        }
+    }
+
+    /**
+     * @brief Set the number of bytes transferred by the operation.
+     */
+    void bytes(size_t n) {
+        nbytes = n;
+    }
+
+    /**
+     * @brief Set the number of bytes transferred from the memory type and
+     *        the elements selected in the memory space (the whole data set
+     *        or attribute for H5S_ALL). Only evaluated while measuring.
+     */
+    void transfer(hid_t mem_type, hid_t mem_space);
+
+    ~IOProbe() {
+        if (running) {
+            std::chrono::duration<double> elapsed = clock_t::now() - start;
+            IOMonitor::record(obj, op, nbytes, elapsed.count());
+        }
+    }
+
+private:
+
+    IOProbe(const IOProbe &) = delete;
+    IOProbe &operator=(const IOProbe &) = delete;
+
+    hid_t obj;
+    IOOperation op;
+    size_t nbytes;
+    bool running;
+    clock_t::time_point start;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_IO_MONITOR_H
@@ -19,6 +19,13 @@
 namespace nix {
 namespace hdf5 {
 
+/**
+ * @brief Identifies an object by the number of its file and its address
+ *        within the file, independent of the handle or path used to open it.
+ */
+typedef std::pair<unsigned long, haddr_t> ObjectAddress;
+
+
 class NIXAPI LocID : public BaseHDF5 {
 public:
     LocID();
@@ -40,6 +47,8 @@ public:
 
     void deleteLink(std::string name, hid_t plist = H5L_SAME_LOC);
 
+    ObjectAddress address() const;
+
 private:
 
     Attribute openAttr(const std::string &name) const;
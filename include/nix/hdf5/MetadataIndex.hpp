@@ -0,0 +1,102 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_METADATA_INDEX_H
+#define NIX_METADATA_INDEX_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/base/ISection.hpp>
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief In-memory index of the metadata tree (all sections) of a file.
+ *
+ * The index holds the parent/child structure of the sections together with
+ * maps from ids, names, types and property names to sections. It is built
+ * with a single traversal of the tree on the first query and shared by all
+ * handles of the file. Any change of the tree, i.e. adding or removing
+ * sections or properties or changing the type of a section, must call
+ * {@link invalidate}, so that the next query builds a fresh index.
+ * The index is part of the FileState of the file; it is never modified
+ * once it is published.
+ */
+class NIXAPI MetadataIndex {
+
+public:
+
+    static const size_t npos = static_cast<size_t>(-1);
+
+    struct Node {
+        std::string id;
+        std::string name;
+        std::string link;      //!< Name of the link inside the "sections" group of the parent
+        std::string type;
+        size_t parent;         //!< npos for the root sections of the file
+        size_t depth;          //!< Depth below the root sections of the file
+        std::vector<size_t> children;
+    };
+
+    /**
+     * @brief The index of the file containing the object, built on first use.
+     *
+     * @param obj   Any object of the file (e.g. the root group).
+     */
+    static std::shared_ptr<const MetadataIndex> get(const LocID &obj);
+
+    /**
+     * @brief Drop the index of the file after its metadata tree changed.
+     *
+     * @param file  Any object of the file (e.g. the root group).
+     */
+    static void invalidate(const LocID &file);
+
+    /**
+     * @brief The position of the section with the given id or npos.
+     */
+    size_t find(const std::string &id) const;
+
+    const Node &node(size_t pos) const {
+        return nodes[pos];
+    }
+
+    /**
+     * @brief The sections in the subtree of the section at the given position,
+     *        up to max_depth levels below it, that match the query.
+     *
+     * @return Pairs of positions and depths relative to the start section,
+     *         in breadth-first order.
+     */
+    std::vector<std::pair<size_t, size_t>> query(size_t start, const base::SectionQuery &query,
+                                                 size_t max_depth) const;
+
+private:
+
+    typedef std::unordered_map<std::string, std::vector<size_t>> PostingMap;
+
+    // nodes are stored in breadth-first order of the whole tree
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, size_t> by_id;
+    PostingMap by_name, by_type, by_property;
+
+    void build(const Group &metadata);
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_METADATA_INDEX_H
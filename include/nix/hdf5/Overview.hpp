@@ -0,0 +1,87 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_OVERVIEW_HDF5_H
+#define NIX_OVERVIEW_HDF5_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/hdf5/DataSetHDF5.hpp>
+#include <nix/base/IDataArray.hpp>
+#include <nix/Platform.hpp>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Multi-resolution summary of the data of a DataArray.
+ *
+ * The samples along one axis of a 1-D or 2-D data set are grouped into bins
+ * of `bin_size` samples and the min, max, mean and count of every bin and
+ * channel (the other axis) are stored in the data set "0" of the group
+ * "overview" of the DataArray. Level `k` (data set "k") combines pairs of
+ * bins of level `k - 1`, up to the level with a single bin.
+ *
+ * Each level is stored as Double data of shape {bins, channels, 4}.
+ */
+class NIXAPI Overview {
+
+public:
+
+    static bool exists(const Group &array_group);
+
+    /**
+     * @brief Build the overview for the data and store it with the DataArray.
+     */
+    static Overview create(const Group &array_group, const DataSet &data, const NDSize &extent,
+                           size_t axis, size_t bin_size);
+
+    static Overview open(const Group &array_group);
+
+    static void remove(const Group &array_group);
+
+    /**
+     * @brief The dimension along which the samples are binned.
+     */
+    size_t axis() const {
+        return sample_axis;
+    }
+
+    /**
+     * @brief Update the bins after samples in [begin, end) along the axis
+     *        were written or the extent of the data changed.
+     */
+    void update(const DataSet &data, const NDSize &extent, ndsize_t begin, ndsize_t end);
+
+    /**
+     * @brief The envelope of a range of samples from the coarsest level
+     *        with at least `points` bins in the range.
+     */
+    Envelope envelope(const DataSet &data, const NDSize &extent,
+                      ndsize_t start, ndsize_t count, size_t points) const;
+
+    /**
+     * @brief The envelope of a range of samples computed from the data.
+     */
+    static Envelope compute(const DataSet &data, const NDSize &extent, size_t axis,
+                            ndsize_t start, ndsize_t count, size_t points);
+
+private:
+
+    Overview(const Group &group, size_t axis, ndsize_t bin_size);
+
+    DataSet level(size_t index, size_t channels) const;
+
+    Group    group;
+    size_t   sample_axis;
+    ndsize_t bin_size;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_OVERVIEW_HDF5_H
@@ -0,0 +1,71 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_PARALLEL_READER_H
+#define NIX_PARALLEL_READER_H
+
+#include <nix/hdf5/DataSetHDF5.hpp>
+#include <nix/Platform.hpp>
+
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Reads large selections of a chunked data set with several threads.
+ *
+ * The selection is split along chunk boundaries. The calling thread
+ * fetches whole chunks with direct chunk reads, while the threads of a
+ * pool shared by all readers decode them (see {@link FilterPipeline}) and
+ * copy their part into the result. Calls into the HDF5 library are
+ * serialized with {@link libraryLock}, since the library is usually not
+ * built thread-safe; decoding and assembling happens concurrently. The
+ * result is converted to the requested type in one go at the end.
+ *
+ * Only data sets whose file type matches the native type and whose
+ * filters can be decoded are supported; for all others {@link read}
+ * returns false and the caller reads the data as usual.
+ */
+class NIXAPI ParallelReader {
+
+public:
+
+    /**
+     * @brief Create a reader for the data set.
+     *
+     * @param data      The data set to read from.
+     * @param threads   The number of threads to use, including the calling thread,
+     *                  which fetches the chunks.
+     */
+    ParallelReader(const DataSet &data, size_t threads);
+
+    /**
+     * @brief Read the selection given by count and offset.
+     *
+     * @return False if the selection can not be read in parallel, in which
+     *         case nothing was read.
+     */
+    bool read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
+
+    /**
+     * @brief The lock that serializes the HDF5 calls of the readers.
+     */
+    static std::mutex &libraryLock();
+
+private:
+
+    DataSet data;
+    size_t threads;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_PARALLEL_READER_H
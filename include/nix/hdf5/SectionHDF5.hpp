@@ -10,11 +10,14 @@
 #define NIX_SECTION_HDF5_H
 
 #include <nix/hdf5/NamedEntityHDF5.hpp>
+#include <nix/hdf5/EntityIndex.hpp>
 #include <nix/base/ISection.hpp>
 #include <nix/Section.hpp>
 
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace nix {
 namespace hdf5 {
@@ -27,6 +30,7 @@ private:
     // TODO: consider writing parent_section as soft link into file
     std::shared_ptr<base::ISection> parent_section;
     optGroup property_group, section_group;
+    EntityIndex property_index, section_index;
 
 public:
 
@@ -69,6 +73,12 @@ public:
     // Attribute getter and setter
     //--------------------------------------------------
 
+    using NamedEntityHDF5::type;
+
+
+    void type(const std::string &type);
+
+
     void repository(const std::string &repository);
 
 
@@ -121,11 +131,18 @@ public:
     std::shared_ptr<base::ISection> getSection(size_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISection>> sections() const;
+
+
     std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
 
 
     bool deleteSection(const std::string &name_or_id);
 
+
+    std::vector<std::pair<std::shared_ptr<base::ISection>, size_t>> querySections(const base::SectionQuery &query,
+                                                                                   size_t max_depth) const;
+
     //--------------------------------------------------
     // Methods for property access
     //--------------------------------------------------
@@ -143,6 +160,9 @@ public:
     std::shared_ptr<base::IProperty> getProperty(size_t index) const;
 
 
+    std::vector<std::shared_ptr<base::IProperty>> properties() const;
+
+
     std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype);
 
 
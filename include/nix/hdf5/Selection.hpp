@@ -10,6 +10,7 @@
 #define NIX_SELECTION_H
 
 #include <nix/NDSize.hpp>
+#include <nix/DataSelection.hpp>
 #include <nix/Hydra.hpp>
 #include <nix/hdf5/DataSpace.hpp>
 
@@ -48,6 +49,10 @@ public:
     Selection& operator=(const Selection &other) { space = other.space; return *this; }
 
     void select(const NDSize &count, const NDSize &start, Mode mode = Mode::Set);
+    void select(const NDSize &count, const NDSize &start, const NDSize &stride, const NDSize &block,
+                Mode mode = Mode::Set);
+    void select(const std::vector<NDSize> &points);
+    void select(const DataSelection &selection);
     void offset(const NDSSize &offset);
 
     DataSpace& h5space() { return space; }
@@ -55,6 +60,7 @@ public:
     bool isValid() const;
     void bounds(NDSize &start, NDSize &end) const;
     NDSize size() const;
+    ndsize_t npoints() const;
     size_t rank() const;
 
 private:
@@ -11,6 +11,8 @@
 
 #include <nix/base/ISource.hpp>
 #include <nix/hdf5/EntityWithMetadataHDF5.hpp>
+#include <nix/hdf5/EntityIndex.hpp>
+#include <nix/hdf5/SourceIndex.hpp>
 
 #include <vector>
 #include <string>
@@ -27,6 +29,7 @@ class SourceHDF5 : virtual public base::ISource, public EntityWithMetadataHDF5
 private:
 
     optGroup source_group;
+    EntityIndex source_index;
 
 public:
 
@@ -48,6 +51,27 @@ public:
     SourceHDF5(const std::shared_ptr<base::IFile> &file, const Group &group, const std::string &id, const std::string &type,
                const std::string &name, time_t time);
 
+    /**
+     * Get the backend object of an indexed source, reusing a cached one if possible.
+     */
+    static std::shared_ptr<SourceHDF5> fromIndex(const std::shared_ptr<base::IFile> &file, const LocID &loc,
+                                                 const SourceIndex::Node &node);
+
+    /**
+     * Unlink all descendants of the source with the given id from their parents,
+     * deepest first, without creating backend objects for them.
+     */
+    static void deleteDescendants(const LocID &loc, const std::string &id);
+
+    //--------------------------------------------------
+    // Attribute getter and setter
+    //--------------------------------------------------
+
+    using NamedEntityHDF5::type;
+
+
+    void type(const std::string &type);
+
     //--------------------------------------------------
     // Methods concerning child sources
     //--------------------------------------------------
@@ -62,6 +86,9 @@ public:
     std::shared_ptr<base::ISource> getSource(size_t index) const;
 
 
+    std::vector<std::shared_ptr<base::ISource>> sources() const;
+
+
     ndsize_t sourceCount() const;
 
 
@@ -70,6 +97,10 @@ public:
 
     bool deleteSource(const std::string &name_or_id);
 
+
+    std::vector<std::pair<std::shared_ptr<base::ISource>, size_t>> querySources(const base::SourceQuery &query,
+                                                                                 size_t max_depth) const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -0,0 +1,172 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SOURCE_INDEX_H
+#define NIX_SOURCE_INDEX_H
+
+#include <nix/hdf5/Group.hpp>
+#include <nix/base/ISource.hpp>
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief In-memory index of the source trees of all blocks of a file.
+ *
+ * The index holds the parent/child structure of the sources together with
+ * maps from ids, names and types to sources. It is built with a single
+ * traversal of the source trees of the file on the first query and shared
+ * by all handles of the file. Any change of the source trees must call
+ * {@link invalidate}, so that the next query builds a fresh index; changes
+ * of the sources referenced by entities do not affect it, see
+ * {@link SourceReferences}.
+ * The index is part of the FileState of the file; it is never modified
+ * once it is published.
+ */
+class NIXAPI SourceIndex {
+
+public:
+
+    static const size_t npos = static_cast<size_t>(-1);
+
+    struct Node {
+        std::string   id;
+        std::string   name;
+        std::string   type;
+        std::string   link;      //!< Name of the link inside the "sources" group of the parent
+        std::string   block;     //!< Id of the block of the source
+        std::string   path;      //!< Absolute path of the source group in the file
+        ObjectAddress address;
+        size_t parent;           //!< npos for the sources directly below a block
+        size_t depth;            //!< Depth below the sources of the block
+        std::vector<size_t> children;
+    };
+
+    /**
+     * @brief The index of the file containing the object, built on first use.
+     *
+     * @param obj   Any object of the file (e.g. the root group).
+     */
+    static std::shared_ptr<const SourceIndex> get(const LocID &obj);
+
+    /**
+     * @brief Drop the index of the file after a source tree or the sources
+     *        of an entity changed.
+     *
+     * @param file  Any object of the file (e.g. the root group).
+     */
+    static void invalidate(const LocID &file);
+
+    /**
+     * @brief The position of the source with the given id or npos.
+     */
+    size_t find(const std::string &id) const;
+
+    const Node &node(size_t pos) const {
+        return nodes[pos];
+    }
+
+    /**
+     * @brief The positions of the sources directly below the block.
+     */
+    const std::vector<size_t> &roots(const std::string &block_id) const;
+
+    /**
+     * @brief The sources in the subtree of the source at the given position,
+     *        up to max_depth levels below it, that match the query.
+     *
+     * @return Pairs of positions and depths relative to the start source,
+     *         in breadth-first order.
+     */
+    std::vector<std::pair<size_t, size_t>> query(size_t start, const base::SourceQuery &query,
+                                                 size_t max_depth) const;
+
+private:
+
+    typedef std::unordered_map<std::string, std::vector<size_t>> PostingMap;
+
+    // nodes are stored in breadth-first order of all trees
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, size_t> by_id;
+    PostingMap by_name, by_type, by_block;
+
+    void build(const Group &data);
+};
+
+
+/**
+ * @brief In-memory map from the sources of a file to the data arrays, tags
+ *        and multi tags that reference them.
+ *
+ * The map is only needed to answer the referencing*() queries of a block,
+ * so it is kept apart from the {@link SourceIndex}: it is built with a
+ * single traversal of the entities of the file on the first such query and
+ * shared by all handles of the file. Adding or removing the sources of an
+ * entity or deleting an entity must call {@link invalidate}; the next
+ * query builds a fresh map. The map is part of the FileState of the file;
+ * it is never modified once it is published.
+ */
+class NIXAPI SourceReferences {
+
+public:
+
+    /**
+     * @brief An entity that references a source.
+     */
+    struct Referrer {
+        std::string   link;      //!< Name of the link inside the container of the block
+        ObjectAddress address;
+    };
+
+    struct References {
+        std::vector<Referrer> data_arrays;
+        std::vector<Referrer> tags;
+        std::vector<Referrer> multi_tags;
+    };
+
+    /**
+     * @brief The map of the file containing the object, built on first use.
+     *
+     * @param obj   Any object of the file (e.g. the root group).
+     */
+    static std::shared_ptr<const SourceReferences> get(const LocID &obj);
+
+    /**
+     * @brief Drop the map of the file after the sources of an entity changed
+     *        or an entity was deleted.
+     *
+     * @param file  Any object of the file (e.g. the root group).
+     */
+    static void invalidate(const LocID &file);
+
+    /**
+     * @brief The entities referencing the source with the given id.
+     */
+    const References &of(const std::string &source_id) const;
+
+private:
+
+    std::unordered_map<std::string, References> refs;
+
+    void build(const Group &data);
+    void addReferences(const Group &block, const std::string &container,
+                       std::vector<Referrer> References::*list);
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_SOURCE_INDEX_H
@@ -0,0 +1,60 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_UPDATE_LOG_H
+#define NIX_UPDATE_LOG_H
+
+#include <nix/hdf5/LocID.hpp>
+#include <nix/Platform.hpp>
+
+#include <ctime>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief Pending "updated_at" timestamps of entities, keyed by the address
+ *        of the entity object in the file.
+ *
+ * Every modification of an entity bumps its update time. Instead of
+ * rewriting the attribute each time, the time is recorded here and the
+ * attributes of all modified entities are written once, when the file is
+ * flushed or closed. The log holds a handle to every modified object until
+ * then, so the addresses stay valid. The log is part of the FileState of
+ * the file and guarded by a mutex; files without a state get the attribute
+ * written right away.
+ */
+class NIXAPI UpdateLog {
+
+public:
+
+    /**
+     * @brief Record an update of the object at the given time.
+     */
+    static void markUpdated(const LocID &obj, time_t time);
+
+    /**
+     * @brief Get the pending update time of the object.
+     *
+     * @return True if an update is pending, false otherwise.
+     */
+    static bool pending(const LocID &obj, time_t &time);
+
+    /**
+     * @brief Write the pending update times of all objects of the given file.
+     *
+     * @param file        Any object of the file (e.g. the root group).
+     */
+    static void flush(const LocID &file);
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_UPDATE_LOG_H
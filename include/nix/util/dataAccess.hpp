@@ -62,6 +62,25 @@ NIXAPI size_t positionToIndex(double position, const std::string &unit, const Se
  */
 NIXAPI size_t positionToIndex(double position, const std::string &unit, const SampledDimension &dimension);
 
+/**
+ * @brief Converts positions given in a unit into indices according to the dimension descriptor.
+ *
+ * Like {@link positionToIndex(double, const std::string&, const SampledDimension&)}, but the
+ * scaling of the unit and the parameters of the dimension are determined only once for all
+ * positions.
+ *
+ * @param positions     The positions
+ * @param unit          The unit in which the positions are given, may be "none"
+ * @param dimension     The dimension descriptor for the respective dimension.
+ *
+ * @return The calculated indices.
+ *
+ * @throws nix::IncompatibleDimension The the dimensions are incompatible.
+ * @throws nix::OutOfBounds If a position is too small for the dimension.
+ */
+NIXAPI std::vector<size_t> positionToIndex(const std::vector<double> &positions, const std::string &unit,
+                                           const SampledDimension &dimension);
+
 /**
  * @brief Converts a position given in a unit into an index according to the dimension descriptor.
  *
@@ -105,6 +124,23 @@ NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_
  */
 NIXAPI DataView retrieveData(const MultiTag &tag, size_t position_index, size_t reference_index);
 
+/**
+ * @brief Retrieve the data referenced by several positions and extents of the MultiTag.
+ *
+ * Positions and extents are read once, the dimensions of the referenced data
+ * are resolved once and slices lying close to each other are read together,
+ * so that retrieving many positions causes only a few reads.
+ *
+ * @param tag                   The multi tag.
+ * @param position_indices      The indices of the positions.
+ * @param reference_index       The index of the reference from which data should be returned.
+ * @param dtype                 The data type of the returned data.
+ *
+ * @return The data referenced by the positions and extents.
+ */
+NIXAPI MultiTagData retrieveData(const MultiTag &tag, const std::vector<ndsize_t> &position_indices,
+                                 size_t reference_index, DataType dtype = DataType::Double);
+
 /**
  * @brief Retrieve the data referenced by the given position and extent of the Tag.
  *
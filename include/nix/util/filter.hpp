@@ -122,6 +122,28 @@ struct NameFilter : public Filter<T> {
 };
 
 
+/**
+ * Filter for entities that have a property with the given name,
+ * e.g. sections.
+ */
+template<typename T>
+struct PropertyFilter : public Filter<T> {
+
+    const std::string name;
+
+
+    PropertyFilter(const std::string &str)
+        : name(str)
+    {}
+
+
+    virtual bool operator()(const T &e) {
+        return e.hasProperty(name);
+    }
+
+};
+
+
 } // namespace util
 } // namespace nix
 
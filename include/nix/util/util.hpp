@@ -16,12 +16,14 @@
 
 #include <nix/Exception.hpp>
 #include <nix/Platform.hpp>
+#include <nix/NDSize.hpp>
 
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <limits>
 #include <type_traits>
 
 #include <boost/optional.hpp>
@@ -350,12 +352,107 @@ R deRef(boost::optional<R> var) {
     else return R();
 }
 
+/*
+ * Conversion of a calibrated value to the output type. Like the
+ * conversion done by HDF5, integer results are truncated and clamped
+ * to the range of the type.
+ */
+template<typename T, bool = std::is_integral<T>::value>
+struct CalibratedValue {
+    static T convert(double value) {
+        return static_cast<T>(value);
+    }
+};
+template<typename T>
+struct CalibratedValue<T, true> {
+    static T convert(double value) {
+        const double lo = static_cast<double>(std::numeric_limits<T>::lowest());
+        const double hi = static_cast<double>(std::numeric_limits<T>::max());
+        if (value >= hi) {
+            return std::numeric_limits<T>::max();
+        }
+        return static_cast<T>(value > lo ? value : lo);
+    }
+};
+
+/**
+ * @brief Apply the calibration polynomial to the input values.
+ *
+ * Computes `sum(coefficients[i] * (input - origin)^i)` using Horner's
+ * scheme and converts the results to the output type, all in a single
+ * pass over the data. The frequent cases of no, a constant or a linear
+ * polynomial are handled by dedicated loops, which the compiler can
+ * vectorize. Input and output may be the same buffer if both types
+ * have the same size.
+ *
+ * @param coefficients  The coefficients of the polynomial, lowest order first.
+ * @param origin        The expansion origin.
+ * @param input         The values to calibrate.
+ * @param output        The buffer receiving the calibrated values.
+ * @param n             The number of values.
+ */
+template<typename In, typename Out>
+void applyPolynomial(const std::vector<double> &coefficients,
+                     double origin,
+                     const In *input,
+                     Out *output,
+                     size_t n) {
+    typedef CalibratedValue<Out> out_value;
+    const size_t order = coefficients.size();
+
+    if (order == 0) {
+        // if we have no coefficients, i.e no polynomial specified we
+        // should still apply the the origin transformation
+        for (size_t k = 0; k < n; k++) {
+            output[k] = out_value::convert(static_cast<double>(input[k]) - origin);
+        }
+    } else if (order == 1) {
+        const Out value = out_value::convert(coefficients[0]);
+        for (size_t k = 0; k < n; k++) {
+            output[k] = value;
+        }
+    } else if (order == 2) {
+        const double offset = coefficients[0];
+        const double gain = coefficients[1];
+        for (size_t k = 0; k < n; k++) {
+            const double x = static_cast<double>(input[k]) - origin;
+            output[k] = out_value::convert(offset + gain * x);
+        }
+    } else {
+        const double *c = coefficients.data();
+        for (size_t k = 0; k < n; k++) {
+            const double x = static_cast<double>(input[k]) - origin;
+            double value = c[order - 1];
+            for (size_t i = order - 1; i > 0; i--) {
+                value = value * x + c[i - 1];
+            }
+            output[k] = out_value::convert(value);
+        }
+    }
+}
+
 NIXAPI void applyPolynomial(const std::vector<double> &coefficients,
                             double origin,
                             const double *input,
                             double *output,
                             size_t n);
 
+/**
+ * @brief Copy a block of elements between two dense, row-major buffers.
+ *
+ * @param src           The source buffer.
+ * @param src_shape     The shape of the source buffer.
+ * @param src_offset    The position of the block in the source buffer.
+ * @param dst           The destination buffer.
+ * @param dst_shape     The shape of the destination buffer.
+ * @param dst_offset    The position of the block in the destination buffer.
+ * @param count         The shape of the block.
+ * @param element_size  The size of a single element in bytes.
+ */
+NIXAPI void copyBlock(const void *src, const NDSize &src_shape, const NDSize &src_offset,
+                      void *dst, const NDSize &dst_shape, const NDSize &dst_offset,
+                      const NDSize &count, size_t element_size);
+
 bool looksLikeUUID(const std::string &id);
 
 } // namespace util
@@ -14,13 +14,13 @@ namespace nix {
 
 std::vector<Source> Block::findSources(const util::Filter<Source>::type &filter,
         size_t max_depth) const {
-    const vector<Source> probes = sources();
-    vector<Source> matches;
     vector<Source> result;
 
-    for (auto &probe : probes) {
-        matches = probe.findSources(filter, max_depth);
-        result.insert(result.end(), matches.begin(), matches.end());
+    for (const auto &match : backend()->querySources(util::sourceQuery(filter), max_depth)) {
+        Source source(match.first);
+        if (filter(source)) {
+            result.push_back(source);
+        }
     }
 
     return result;
@@ -34,10 +34,7 @@ bool Block::hasSource(const Source &source) const {
 }
 
 std::vector<Source> Block::sources(const util::Filter<Source>::type &filter) const {
-    auto f = [this](size_t i) { return getSource(i); };
-    return getEntities<Source>(f,
-            sourceCount(),
-            filter);
+    return filterEntities<Source>(backend()->sources(), filter);
 }
 
 bool Block::deleteSource(const Source &source) {
@@ -47,6 +44,30 @@ bool Block::deleteSource(const Source &source) {
     return backend()->deleteSource(source.id());
 }
 
+std::vector<DataArray> Block::referencingDataArrays(const Source &source,
+        const util::Filter<DataArray>::type &filter) const {
+    if (source == none) {
+        throw std::runtime_error("Empty Source entity given");
+    }
+    return filterEntities<DataArray>(backend()->referencingDataArrays(source.id()), filter);
+}
+
+std::vector<Tag> Block::referencingTags(const Source &source,
+        const util::Filter<Tag>::type &filter) const {
+    if (source == none) {
+        throw std::runtime_error("Empty Source entity given");
+    }
+    return filterEntities<Tag>(backend()->referencingTags(source.id()), filter);
+}
+
+std::vector<MultiTag> Block::referencingMultiTags(const Source &source,
+        const util::Filter<MultiTag>::type &filter) const {
+    if (source == none) {
+        throw std::runtime_error("Empty Source entity given");
+    }
+    return filterEntities<MultiTag>(backend()->referencingMultiTags(source.id()), filter);
+}
+
 bool Block::hasDataArray(const DataArray &data_array) const {
     if (data_array == none) {
         throw std::runtime_error("Empty DataArray entity given!");
@@ -55,10 +76,7 @@ bool Block::hasDataArray(const DataArray &data_array) const {
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
-    auto f = [this] (size_t i) { return getDataArray(i); };
-    return getEntities<DataArray>(f,
-                                  dataArrayCount(),
-                                  filter);
+    return filterEntities<DataArray>(backend()->dataArrays(), filter);
 }
 
 bool Block::deleteDataArray(const DataArray &data_array) {
@@ -76,10 +94,7 @@ bool Block::hasTag(const Tag &tag) const {
 }
 
 std::vector<Tag> Block::tags(const util::Filter<Tag>::type &filter) const {
-    auto f = [this] (size_t i) { return getTag(i); };
-    return getEntities<Tag>(f,
-                            tagCount(),
-                            filter);
+    return filterEntities<Tag>(backend()->tags(), filter);
 }
 
 bool Block::deleteTag(const Tag &tag) {
@@ -97,10 +112,7 @@ bool Block::hasMultiTag(const MultiTag &multi_tag) const {
 }
 
 std::vector<MultiTag> Block::multiTags(const util::AcceptAll<MultiTag>::type &filter) const {
-    auto f = [this] (size_t i) { return getMultiTag(i); };
-    return getEntities<MultiTag>(f,
-                                multiTagCount(),
-                                filter);
+    return filterEntities<MultiTag>(backend()->multiTags(), filter);
 }
 
 bool Block::deleteMultiTag(const MultiTag &multi_tag) {
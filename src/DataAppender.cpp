@@ -0,0 +1,177 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataAppender.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace nix {
+
+DataAppender::DataAppender(const DataArray &array, size_t axis, size_t flush_size)
+    : array(array), axis(axis), flush_size(flush_size), closed(false),
+      buffer_type(DataType::Nothing), buffered(0)
+{
+    extent = this->array.dataExtent();
+
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    capacity = extent[axis];
+}
+
+
+void DataAppender::check(const NDSize &count) const {
+    if (closed) {
+        throw std::runtime_error("DataAppender: cannot append after close");
+    }
+
+    if (extent.size() != count.size()) {
+        throw IncompatibleDimensions("Data and DataArray must have the same dimensionality", "DataAppender::append");
+    }
+
+    for (size_t i = 0; i < count.size(); i ++) {
+        if (i != axis && extent[i] != count[i]) {
+            throw IncompatibleDimensions("Shape of data and shape of DataArray must match in all dimension but axis!",
+                                         "DataAppender::append");
+        }
+    }
+}
+
+
+void DataAppender::append(DataType dtype, const void *data, const NDSize &count) {
+    check(count);
+
+    if (count[axis] == 0) {
+        return;
+    }
+
+    if (dtype != buffer_type) {
+        flush();
+        buffer_type = dtype;
+    }
+
+    if (dtype == DataType::String) {
+        reserve(extent[axis] + count[axis]);
+
+        NDSize offset(extent.size(), 0);
+        offset[axis] = extent[axis];
+        array.setData(dtype, data, count, offset);
+
+        extent[axis] += count[axis];
+        record();
+        return;
+    }
+
+    const size_t nbytes = count.nelms() * data_type_to_size(dtype);
+    const char *bytes = static_cast<const char *>(data);
+
+    buffer.insert(buffer.end(), bytes, bytes + nbytes);
+    blocks.push_back(count[axis]);
+    buffered += count[axis];
+
+    if (buffer.size() >= flush_size) {
+        flush();
+    }
+}
+
+
+void DataAppender::reserve(ndsize_t length) {
+    if (length <= capacity) {
+        return;
+    }
+
+    capacity = std::max(length, capacity * 2);
+
+    NDSize allocated(extent);
+    allocated[axis] = capacity;
+    array.dataExtent(allocated);
+
+    // changing the extent dropped the logical extent, so the file would
+    // report the allocated rows as data if nothing else gets written
+    record();
+}
+
+
+void DataAppender::flush() {
+    if (buffered == 0) {
+        return;
+    }
+
+    reserve(extent[axis] + buffered);
+
+    NDSize count(extent);
+    count[axis] = buffered;
+
+    NDSize offset(extent.size(), 0);
+    offset[axis] = extent[axis];
+
+    if (axis == 0 || blocks.size() == 1) {
+        array.setData(buffer_type, buffer.data(), count, offset);
+    } else {
+        // blocks along an inner axis interleave, so put them in place first
+        const size_t esize = data_type_to_size(buffer_type);
+        std::vector<char> assembled(buffer.size());
+        NDSize zero(extent.size(), 0), dst(extent.size(), 0), shape(count);
+        size_t pos = 0;
+
+        for (ndsize_t len : blocks) {
+            shape[axis] = len;
+            util::copyBlock(buffer.data() + pos, shape, zero, assembled.data(), count, dst, shape, esize);
+            pos += shape.nelms() * esize;
+            dst[axis] += len;
+        }
+
+        array.setData(buffer_type, assembled.data(), count, offset);
+    }
+
+    extent[axis] += buffered;
+    buffer.clear();
+    blocks.clear();
+    buffered = 0;
+
+    record();
+}
+
+
+void DataAppender::record() {
+    if (capacity > extent[axis]) {
+        array.backend()->logicalExtent(extent);
+    } else {
+        array.backend()->logicalExtent(none);
+    }
+}
+
+
+void DataAppender::close() {
+    if (closed) {
+        return;
+    }
+
+    flush();
+
+    if (capacity > extent[axis]) {
+        array.dataExtent(extent);
+        capacity = extent[axis];
+    }
+
+    closed = true;
+}
+
+
+DataAppender::~DataAppender() {
+    try {
+        close();
+    } catch (...) {
+        // the file might have been closed already
+    }
+}
+
+} // namespace nix
@@ -24,15 +24,93 @@ static void convertData(DataType source, DataType destination, void *data, size_
     res.check("Could not convert data");
 }
 
+// types the calibration can be applied to without going through double
+static bool isCalibratable(DataType dtype) {
+    switch (dtype) {
+    case DataType::Float:
+    case DataType::Double:
+    case DataType::Int8:
+    case DataType::Int16:
+    case DataType::Int32:
+    case DataType::Int64:
+    case DataType::UInt8:
+    case DataType::UInt16:
+    case DataType::UInt32:
+    case DataType::UInt64:
+        return true;
+    default:
+        return false;
+    }
+}
 
-void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    const std::vector<double> poly = polynomCoefficients();
-    boost::optional<double> opt_origin = expansionOrigin();
+template<typename In>
+static void calibrateTo(DataType destination, const std::vector<double> &poly, double origin,
+                        const In *input, void *output, size_t nelms) {
+    switch (destination) {
+    case DataType::Float:  util::applyPolynomial(poly, origin, input, static_cast<float *>(output), nelms);    break;
+    case DataType::Double: util::applyPolynomial(poly, origin, input, static_cast<double *>(output), nelms);   break;
+    case DataType::Int8:   util::applyPolynomial(poly, origin, input, static_cast<int8_t *>(output), nelms);   break;
+    case DataType::Int16:  util::applyPolynomial(poly, origin, input, static_cast<int16_t *>(output), nelms);  break;
+    case DataType::Int32:  util::applyPolynomial(poly, origin, input, static_cast<int32_t *>(output), nelms);  break;
+    case DataType::Int64:  util::applyPolynomial(poly, origin, input, static_cast<int64_t *>(output), nelms);  break;
+    case DataType::UInt8:  util::applyPolynomial(poly, origin, input, static_cast<uint8_t *>(output), nelms);  break;
+    case DataType::UInt16: util::applyPolynomial(poly, origin, input, static_cast<uint16_t *>(output), nelms); break;
+    case DataType::UInt32: util::applyPolynomial(poly, origin, input, static_cast<uint32_t *>(output), nelms); break;
+    case DataType::UInt64: util::applyPolynomial(poly, origin, input, static_cast<uint64_t *>(output), nelms); break;
+    default:
+        throw std::invalid_argument("Cannot apply polynom to non-numeric data");
+    }
+}
+
+static void calibrate(DataType source, DataType destination, const std::vector<double> &poly, double origin,
+                      const void *input, void *output, size_t nelms) {
+    switch (source) {
+    case DataType::Float:  calibrateTo(destination, poly, origin, static_cast<const float *>(input), output, nelms);    break;
+    case DataType::Double: calibrateTo(destination, poly, origin, static_cast<const double *>(input), output, nelms);   break;
+    case DataType::Int8:   calibrateTo(destination, poly, origin, static_cast<const int8_t *>(input), output, nelms);   break;
+    case DataType::Int16:  calibrateTo(destination, poly, origin, static_cast<const int16_t *>(input), output, nelms);  break;
+    case DataType::Int32:  calibrateTo(destination, poly, origin, static_cast<const int32_t *>(input), output, nelms);  break;
+    case DataType::Int64:  calibrateTo(destination, poly, origin, static_cast<const int64_t *>(input), output, nelms);  break;
+    case DataType::UInt8:  calibrateTo(destination, poly, origin, static_cast<const uint8_t *>(input), output, nelms);  break;
+    case DataType::UInt16: calibrateTo(destination, poly, origin, static_cast<const uint16_t *>(input), output, nelms); break;
+    case DataType::UInt32: calibrateTo(destination, poly, origin, static_cast<const uint32_t *>(input), output, nelms); break;
+    case DataType::UInt64: calibrateTo(destination, poly, origin, static_cast<const uint64_t *>(input), output, nelms); break;
+    default:
+        throw std::invalid_argument("Cannot apply polynom to non-numeric data");
+    }
+}
+
+
+// reads the raw values with read_raw(type, buffer) and applies the calibration of the array
+template<typename F>
+static void readCalibrated(const DataArray &array, DataType dtype, void *data, ndsize_t count_nelms, F read_raw) {
+    const std::vector<double> poly = array.polynomCoefficients();
+    boost::optional<double> opt_origin = array.expansionOrigin();
 
     if (poly.size() || opt_origin) {
         size_t data_esize = data_type_to_size(dtype);
-        size_t nelms = check::fits_in_size_t(count.nelms(),
+        size_t nelms = check::fits_in_size_t(count_nelms,
 			"Cannot apply polynom or oirign transform. Buffer needed exceeds memory.");
+        const double origin = opt_origin ? *opt_origin : 0.0;
+        const DataType stored = array.dataType();
+
+        if (isCalibratable(stored) && isCalibratable(dtype)) {
+            // read the raw values and calibrate them straight into the
+            // output buffer, in place if the element sizes match
+            size_t stored_esize = data_type_to_size(stored);
+            std::vector<char> tmp;
+            void *read_buffer = data;
+
+            if (stored_esize != data_esize) {
+                tmp.resize(nelms * stored_esize);
+                read_buffer = tmp.data();
+            }
+
+            read_raw(stored, read_buffer);
+            calibrate(stored, dtype, poly, origin, read_buffer, data, nelms);
+            return;
+        }
+
         std::vector<double> tmp;
         double *read_buffer;
 
@@ -44,8 +122,7 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
             read_buffer = reinterpret_cast<double *>(data);
         }
 
-        getDataDirect(DataType::Double, read_buffer, count, offset);
-        const double origin = opt_origin ? *opt_origin : 0.0;
+        read_raw(DataType::Double, read_buffer);
 
         util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
         convertData(DataType::Double, dtype, read_buffer, nelms);
@@ -55,14 +132,72 @@ void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const ND
         }
 
     } else {
-        getDataDirect(dtype, data, count, offset);
+        read_raw(dtype, data);
+    }
+}
+
+
+void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    readCalibrated(*this, dtype, data, count.nelms(), [&](DataType type, void *buffer) {
+        getDataDirect(type, buffer, count, offset);
+    });
+}
+
+
+void DataArray::ioRead(DataType dtype, void *data, const DataSelection &selection) const {
+    if (!selection.within(dataExtent())) {
+        throw OutOfBounds("DataArray::getData: selection is outside of the data");
     }
+
+    readCalibrated(*this, dtype, data, selection.nelms(), [&](DataType type, void *buffer) {
+        backend()->read(type, buffer, selection);
+    });
 }
 
 void DataArray::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
     setDataDirect(dtype, data, count, offset);
 }
 
+MappedArray DataArray::map() const {
+    const DataType dtype = dataType();
+    const NDSize extent = dataExtent();
+
+    if (extent.size() == 0) {
+        return MappedArray();
+    }
+
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("DataArray::map(): String data cannot be mapped");
+    }
+
+    std::string path;
+    ndsize_t offset;
+    if (backend()->dataLocation(path, offset)) {
+        try {
+            return MappedArray::fromFile(path, offset, dtype, extent);
+        } catch (const std::runtime_error &) {
+            // the file might have moved, read it through the library
+        }
+    }
+
+    size_t nbytes = check::fits_in_size_t(extent.nelms() * data_type_to_size(dtype),
+                                          "Cannot read data: exceeds memory");
+    std::vector<MappedArray::byte_type> buffer(nbytes);
+    if (nbytes > 0) {
+        getDataDirect(dtype, buffer.data(), extent, NDSize(extent.size(), 0));
+    }
+
+    return MappedArray::fromBuffer(dtype, extent, std::move(buffer));
+}
+
+void DataArray::ioReadStrings(StringColumn &data, const NDSize &count, const NDSize &offset) const {
+    backend()->read(data, count, offset);
+}
+
+void DataArray::ioWriteStrings(const StringColumn &data, const NDSize &count, const NDSize &offset) {
+    backend()->write(data, count, offset);
+}
+
 void DataArray::appendData(DataType dtype, const void *data, const NDSize &count, size_t axis) {
 
     //first some sanity checks
@@ -0,0 +1,244 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataSelection.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nix {
+
+// position after the last selected element of the slab along each dimension
+static NDSize slab_end(const Hyperslab &slab) {
+    NDSize end(slab.start);
+    for (size_t i = 0; i < end.size(); i++) {
+        if (slab.count[i] > 0) {
+            end[i] += (slab.count[i] - 1) * slab.stride[i] + slab.block[i];
+        }
+    }
+    return end;
+}
+
+
+DataSelection &DataSelection::add(const NDSize &start, const NDSize &count,
+                                  const NDSize &stride, const NDSize &block) {
+    const size_t rank = start.size();
+
+    if (count.size() != rank || (stride && stride.size() != rank) || (block && block.size() != rank)) {
+        throw InvalidRank("DataSelection: start, count, stride and block must have the same rank");
+    }
+
+    if (!empty() && this->rank() != rank) {
+        throw InvalidRank("DataSelection: all parts of a selection must have the same rank");
+    }
+
+    if (!pts.empty()) {
+        throw std::invalid_argument("DataSelection: cannot combine points and hyperslabs");
+    }
+
+    Hyperslab slab{start, count, stride ? stride : NDSize(rank, 1), block ? block : NDSize(rank, 1)};
+
+    for (size_t i = 0; i < rank; i++) {
+        if (slab.stride[i] == 0 || slab.block[i] == 0) {
+            throw std::invalid_argument("DataSelection: stride and block must not be 0");
+        }
+        if (slab.count[i] > 1 && slab.stride[i] < slab.block[i]) {
+            throw std::invalid_argument("DataSelection: blocks must not overlap");
+        }
+    }
+
+    slabs.push_back(slab);
+    return *this;
+}
+
+
+DataSelection &DataSelection::addPoint(const NDSize &point) {
+    if (!empty() && rank() != point.size()) {
+        throw InvalidRank("DataSelection: all parts of a selection must have the same rank");
+    }
+
+    if (!slabs.empty()) {
+        throw std::invalid_argument("DataSelection: cannot combine points and hyperslabs");
+    }
+
+    pts.push_back(point);
+    return *this;
+}
+
+
+DataSelection &DataSelection::only(size_t axis, const std::vector<ndsize_t> &indices) {
+    if (!empty() && axis >= rank()) {
+        throw InvalidRank("DataSelection: axis is out of bounds");
+    }
+
+    if (!std::is_sorted(indices.begin(), indices.end()) ||
+        std::adjacent_find(indices.begin(), indices.end()) != indices.end()) {
+        throw std::invalid_argument("DataSelection: indices must be increasing");
+    }
+
+    if (!pts.empty()) {
+        std::vector<NDSize> kept;
+        for (const NDSize &p : pts) {
+            if (std::binary_search(indices.begin(), indices.end(), p[axis])) {
+                kept.push_back(p);
+            }
+        }
+        pts.swap(kept);
+        return *this;
+    }
+
+    std::vector<Hyperslab> restricted;
+    for (const Hyperslab &slab : slabs) {
+        for (size_t i = 0; i < indices.size(); ) {
+            size_t j = i + 1;
+            while (j < indices.size() && indices[j] == indices[j - 1] + 1) {
+                j++;
+            }
+
+            Hyperslab part(slab);
+            part.start[axis] = indices[i];
+            part.count[axis] = j - i;
+            part.stride[axis] = 1;
+            part.block[axis] = 1;
+            restricted.push_back(part);
+
+            i = j;
+        }
+    }
+
+    slabs.swap(restricted);
+    return *this;
+}
+
+
+DataSelection DataSelection::decimate(const NDSize &offset, const NDSize &count,
+                                      size_t axis, ndsize_t max_points) {
+    if (axis >= count.size()) {
+        throw InvalidRank("DataSelection::decimate: axis is out of bounds");
+    }
+
+    if (max_points == 0) {
+        throw std::invalid_argument("DataSelection::decimate: max_points must not be 0");
+    }
+
+    const ndsize_t len = count[axis];
+    const ndsize_t step = std::max<ndsize_t>(1, (len + max_points - 1) / max_points);
+
+    NDSize slab_count(count);
+    slab_count[axis] = (len + step - 1) / step;
+
+    NDSize stride(count.size(), 1);
+    stride[axis] = step;
+
+    return DataSelection(offset, slab_count, stride);
+}
+
+
+size_t DataSelection::rank() const {
+    if (!slabs.empty()) {
+        return slabs.front().start.size();
+    }
+    return pts.empty() ? 0 : pts.front().size();
+}
+
+
+ndsize_t DataSelection::nelms() const {
+    if (!pts.empty()) {
+        return pts.size();
+    }
+
+    ndsize_t n = 0;
+    for (const Hyperslab &slab : slabs) {
+        n += (slab.count * slab.block).nelms();
+    }
+    return n;
+}
+
+
+NDSize DataSelection::shape() const {
+    if (slabs.empty()) {
+        return NDSize({nelms()});
+    }
+
+    NDSize shape = slabs.front().count * slabs.front().block;
+    if (slabs.size() == 1) {
+        return shape;
+    }
+
+    // slabs that only differ along one axis stack up along it
+    const size_t rank = shape.size();
+    size_t axis = rank;
+
+    for (size_t k = 1; k < slabs.size(); k++) {
+        const Hyperslab &first = slabs.front(), &slab = slabs[k];
+        for (size_t i = 0; i < rank; i++) {
+            bool same = first.start[i] == slab.start[i] && first.count[i] == slab.count[i] &&
+                        first.stride[i] == slab.stride[i] && first.block[i] == slab.block[i];
+            if (!same) {
+                if (axis != rank && axis != i) {
+                    return NDSize({nelms()});
+                }
+                axis = i;
+            }
+        }
+    }
+
+    if (axis == rank) {
+        // the same slab several times
+        return NDSize({nelms()});
+    }
+
+    shape[axis] = 0;
+    for (const Hyperslab &slab : slabs) {
+        shape[axis] += slab.count[axis] * slab.block[axis];
+    }
+    return shape;
+}
+
+
+bool DataSelection::within(const NDSize &extent) const {
+    if (empty()) {
+        return true;
+    }
+
+    if (extent.size() != rank()) {
+        return false;
+    }
+
+    for (const Hyperslab &slab : slabs) {
+        if (slab.count.nelms() > 0 && !(slab_end(slab) <= extent)) {
+            return false;
+        }
+    }
+
+    for (const NDSize &p : pts) {
+        if (!(p < extent)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+DataSelection DataSelection::shifted(const NDSize &offset) const {
+    DataSelection sel(*this);
+
+    for (Hyperslab &slab : sel.slabs) {
+        slab.start += offset;
+    }
+
+    for (NDSize &p : sel.pts) {
+        p += offset;
+    }
+
+    return sel;
+}
+
+} // namespace nix
@@ -56,6 +56,29 @@ void DataView::ioWrite(DataType dtype, const void *data, const NDSize &count, co
     array.setData(dtype, data, real_count, base);
 }
 
+void DataView::ioRead(DataType dtype, void *data, const DataSelection &selection) const {
+
+    if (!selection.within(count)) {
+        throw OutOfBounds("Trying to access data outside of range", 0);
+    }
+
+    array.getData(dtype, data, selection.shifted(offset));
+}
+
+void DataView::ioReadStrings(StringColumn &data, const NDSize &count, const NDSize &offset) const {
+
+    const NDSize &real_count =  count ? count : this->count;
+    NDSize base = transform_coordinates(real_count, offset);
+    array.getData(data, real_count, base);
+}
+
+void DataView::ioWriteStrings(const StringColumn &data, const NDSize &count, const NDSize &offset) {
+
+    const NDSize &real_count =  count ? count : this->count;
+    NDSize base = transform_coordinates(real_count, offset);
+    array.setData(data, real_count, base);
+}
+
 DataType DataView::dataType() const {
     return array.dataType();
 }
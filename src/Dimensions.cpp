@@ -8,7 +8,9 @@
 
 #include <nix/Dimensions.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <nix/util/util.hpp>
 #include <nix/Exception.hpp>
 
@@ -179,6 +181,31 @@ size_t SampledDimension::indexOf(const double position) const {
 }
 
 
+vector<size_t> SampledDimension::indexOf(const vector<double> &positions) const {
+    const double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
+    const double sampling_interval = backend()->samplingInterval();
+    const size_t n = positions.size();
+
+    // independent iterations without branches, so that the compiler can vectorize them
+    vector<double> rounded(n);
+    double lowest = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        rounded[i] = round((positions[i] - offset) / sampling_interval);
+        lowest = min(lowest, rounded[i]);
+    }
+
+    if (lowest < 0.0) {
+        throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+    }
+
+    vector<size_t> indices(n);
+    for (size_t i = 0; i < n; i++) {
+        indices[i] = static_cast<size_t>(rounded[i]);
+    }
+    return indices;
+}
+
+
 double SampledDimension::positionAt(const size_t index) const {
     double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
     double sampling_interval = backend()->samplingInterval();
@@ -313,50 +340,121 @@ void RangeDimension::ticks(const std::vector<double> &ticks) {
 
 
 double RangeDimension::tickAt(const size_t index) const {
-    vector<double> ticks = this->ticks();
-    if (index >= ticks.size()) {
+    if (index >= backend()->tickCount()) {
         throw nix::OutOfBounds("RangeDimension::tickAt: Given index is out of bounds!", index);
     }
-    return ticks[index];
+    return backend()->ticks(index, 1)[0];
 }
 
 
 size_t RangeDimension::indexOf(const double position) const {
-    size_t index;
-    vector<double> ticks = this->ticks();
-    if (position < *ticks.begin()) {
-        return 0;
-    } else if (position > *prev(ticks.end())) {
-        return prev(ticks.end()) - ticks.begin();
+    return indexOf(vector<double>{position})[0];
+}
+
+
+namespace {
+
+const ndsize_t TICK_BLOCK_SIZE = 4096;
+
+// Random access to the ticks of a dimension that reads them in blocks
+class TickReader {
+
+public:
+
+    TickReader(const base::IRangeDimension *dim)
+        : size(dim->tickCount()), dim(dim), first(0)
+    {
     }
-    vector<double>::iterator low = std::lower_bound (ticks.begin(), ticks.end(), position);
-    if (*low == position) {
-        return low - ticks.begin();
+
+    double operator[](ndsize_t index) {
+        if (index < first || index >= first + block.size()) {
+            first = index / TICK_BLOCK_SIZE * TICK_BLOCK_SIZE;
+            size_t count = static_cast<size_t>(std::min(TICK_BLOCK_SIZE, size - first));
+            block = dim->ticks(first, count);
+        }
+        return block[index - first];
     }
-    if (low != ticks.begin() && *low != position) {
-        double diff_low, diff_before;
-        diff_low = fabs(*low - position);
-        diff_before = fabs(*(std::prev(low)) - position);
-        if (diff_low < diff_before) {
-            index = low - ticks.begin();
+
+    // index of the first tick not less than position, searching from `from` on
+    ndsize_t lowerBound(double position, ndsize_t from) {
+        // gallop to bracket the position, then bisect
+        ndsize_t lo = from, step = 1, hi = from;
+        while (hi < size && (*this)[hi] < position) {
+            lo = hi + 1;
+            hi = std::min(size, hi + step);
+            step *= 2;
+        }
+
+        while (lo < hi) {
+            ndsize_t mid = lo + (hi - lo) / 2;
+            if ((*this)[mid] < position) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo;
+    }
+
+    const ndsize_t size;
+
+private:
+
+    const base::IRangeDimension *dim;
+    ndsize_t first;
+    vector<double> block;
+};
+
+}
+
+
+vector<size_t> RangeDimension::indexOf(const vector<double> &positions) const {
+    TickReader ticks(backend());
+    if (ticks.size == 0) {
+        throw nix::OutOfBounds("RangeDimension::indexOf: The dimension has no ticks!");
+    }
+
+    // resolve the positions in ascending order, each search starts at the previous result
+    vector<size_t> order(positions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&positions](size_t a, size_t b) {
+        return positions[a] < positions[b];
+    });
+
+    vector<size_t> indices(positions.size());
+    const ndsize_t last = ticks.size - 1;
+    ndsize_t low = 0;
+
+    for (size_t k : order) {
+        const double position = positions[k];
+
+        if (position <= ticks[0]) {
+            indices[k] = 0;
+            continue;
+        } else if (position > ticks[last]) {
+            indices[k] = static_cast<size_t>(last);
+            low = last;
+            continue;
+        }
+
+        low = ticks.lowerBound(position, low);
+        if (ticks[low] != position && fabs(ticks[low] - position) >= fabs(ticks[low - 1] - position)) {
+            indices[k] = static_cast<size_t>(low - 1);
         } else {
-            index = low - ticks.begin() - 1;
+            indices[k] = static_cast<size_t>(low);
         }
-        return index;
-    } else {
-        return low - ticks.begin();
     }
+
+    return indices;
 }
 
 
 vector<double> RangeDimension::axis(const size_t count, const size_t startIndex) const {
-    vector<double> ticks = this->ticks();
-    if ((startIndex + count) > ticks.size()) {
+    if ((startIndex + count) > backend()->tickCount()) {
         throw nix::OutOfBounds("RangeDimension::axis: Count is invalid, reaches beyond the ticks stored in this dimension.");
-    } 
-    vector<double>::const_iterator first = ticks.begin() + startIndex;
-    vector<double> axis(first, first + count);
-    return axis;
+    }
+    return backend()->ticks(startIndex, count);
 }
 
 
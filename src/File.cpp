@@ -44,10 +44,16 @@ bool File::deleteBlock(const Block &block) {
 
 std::vector<Block> File::blocks(const util::Filter<Block>::type &filter) const
 {
-    auto f = [this] (size_t i) { return getBlock(i); };
-    return getEntities<Block>(f,
-                              blockCount(),
-                              filter);
+    return filterEntities<Block>(backend()->blocks(), filter);
+}
+
+
+DataArraySummary File::describeDataArrays() const {
+    DataArraySummary summary;
+    for (ndsize_t i = 0; i < blockCount(); i++) {
+        backend()->getBlock(i)->describeDataArrays(summary);
+    }
+    return summary;
 }
 
 
@@ -61,10 +67,7 @@ bool File::hasSection(const Section &section) const {
 
 std::vector<Section> File::sections(const util::Filter<Section>::type &filter) const
 {
-    auto f = [this] (size_t i) { return getSection(i); };
-    return getEntities<Section>(f,
-                                sectionCount(),
-                                filter);
+    return filterEntities<Section>(backend()->sections(), filter);
 }
 
 
@@ -170,4 +173,19 @@ void File::close() {
     }
 }
 
+
+std::ostream &operator<<(std::ostream &out, const IOOperation op) {
+    switch (op) {
+    case IOOperation::DataRead:      out << "DataRead";      break;
+    case IOOperation::DataWrite:     out << "DataWrite";     break;
+    case IOOperation::AttrRead:      out << "AttrRead";      break;
+    case IOOperation::AttrWrite:     out << "AttrWrite";     break;
+    case IOOperation::AttrLookup:    out << "AttrLookup";    break;
+    case IOOperation::ObjectOpen:    out << "ObjectOpen";    break;
+    case IOOperation::LinkLookup:    out << "LinkLookup";    break;
+    case IOOperation::LinkIteration: out << "LinkIteration"; break;
+    }
+    return out;
+}
+
 }
@@ -0,0 +1,128 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MappedArray.hpp>
+#include <nix/Exception.hpp>
+
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nix {
+
+static NDSize row_major_strides(const NDSize &shape) {
+    size_t rank = shape.size();
+    NDSize strides(rank, 1);
+
+    for (size_t i = 1; i < rank; i++) {
+        size_t lst = rank - i;
+        size_t cur = lst - 1;
+        strides[cur] = strides[lst] * shape[lst];
+    }
+
+    return strides;
+}
+
+
+MappedArray::MappedArray()
+    : dataType(DataType::Nothing), ptr(nullptr), mapped(false)
+{
+}
+
+
+MappedArray::MappedArray(DataType dtype, const NDSize &shape, std::shared_ptr<const void> storage,
+                         const byte_type *ptr, bool mapped)
+    : dataType(dtype), extends(shape), elm_strides(row_major_strides(shape)),
+      storage(std::move(storage)), ptr(ptr), mapped(mapped)
+{
+}
+
+
+#ifndef _WIN32
+
+namespace {
+
+struct file_mapping {
+    void   *addr;
+    size_t  length;
+
+    ~file_mapping() {
+        munmap(addr, length);
+    }
+};
+
+}
+
+MappedArray MappedArray::fromFile(const std::string &path, ndsize_t offset, DataType dtype, const NDSize &shape) {
+    const ndsize_t nbytes = shape.nelms() * data_type_to_size(dtype);
+
+    if (nbytes == 0) {
+        return MappedArray(dtype, shape, nullptr, nullptr, true);
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("MappedArray: Could not open file " + path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<ndsize_t>(st.st_size) < offset + nbytes) {
+        close(fd);
+        throw std::runtime_error("MappedArray: Data exceeds the file " + path);
+    }
+
+    // the mapping has to start at a page boundary
+    const ndsize_t page = static_cast<ndsize_t>(sysconf(_SC_PAGESIZE));
+    const ndsize_t start = offset / page * page;
+    const size_t length = check::fits_in_size_t(offset - start + nbytes, "MappedArray: Data exceeds the address space");
+
+    void *addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(start));
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("MappedArray: Could not map file " + path);
+    }
+
+    std::shared_ptr<file_mapping> mapping = std::make_shared<file_mapping>();
+    mapping->addr = addr;
+    mapping->length = length;
+
+    const byte_type *ptr = static_cast<const byte_type *>(addr) + (offset - start);
+    return MappedArray(dtype, shape, mapping, ptr, true);
+}
+
+#else
+
+MappedArray MappedArray::fromFile(const std::string &path, ndsize_t offset, DataType dtype, const NDSize &shape) {
+    throw std::runtime_error("MappedArray: Mapping files is not supported on this platform");
+}
+
+#endif
+
+
+MappedArray MappedArray::fromBuffer(DataType dtype, const NDSize &shape, std::vector<byte_type> &&buffer) {
+    if (buffer.size() != shape.nelms() * data_type_to_size(dtype)) {
+        throw std::invalid_argument("MappedArray: Buffer size does not match the shape");
+    }
+
+    std::shared_ptr<std::vector<byte_type>> storage = std::make_shared<std::vector<byte_type>>(std::move(buffer));
+    return MappedArray(dtype, shape, storage, storage->data(), false);
+}
+
+
+size_t MappedArray::sub2index(const NDSize &sub) const {
+    ndsize_t pos = elm_strides.dot(sub);
+    return check::fits_in_size_t(pos, "index does not fit into memory");
+}
+
+} // namespace nix
@@ -75,10 +75,7 @@ bool MultiTag::removeReference(const DataArray &reference) {
 
 
 std::vector<DataArray> MultiTag::references(const util::Filter<DataArray>::type &filter) const {
-    auto f = [this] (size_t i) { return getReference(i); };
-    return getEntities<DataArray>(f,
-                                  referenceCount(),
-                                  filter);
+    return filterEntities<DataArray>(backend()->references(), filter);
 }
 
 
@@ -87,6 +84,12 @@ DataView MultiTag::retrieveData(size_t position_index, size_t reference_index) c
 }
 
 
+MultiTagData MultiTag::retrieveData(const std::vector<ndsize_t> &position_indices, size_t reference_index,
+                                    DataType dtype) const {
+    return util::retrieveData(*this, position_indices, reference_index, dtype);
+}
+
+
 bool MultiTag::hasFeature(const Feature &feature) const {
     if (feature == none) {
         throw std::runtime_error("MultiTag::hasFeature: Empty feature given!");
@@ -96,10 +99,7 @@ bool MultiTag::hasFeature(const Feature &feature) const {
 
 
 std::vector<Feature> MultiTag::features(const util::Filter<Feature>::type &filter) const {
-    auto f = [this] (size_t i) { return getFeature(i); };
-    return getEntities<Feature>(f,
-                                featureCount(),
-                                filter);
+    return filterEntities<Feature>(backend()->features(), filter);
 }
 
 
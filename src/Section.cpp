@@ -8,9 +8,11 @@
 
 #include <nix/Section.hpp>
 
-#include <list>
+#include <nix/util/util.hpp>
+
 #include <algorithm>
 #include <iterator>
+#include <limits>
 
 
 using namespace std;
@@ -75,51 +77,44 @@ bool Section::deleteSection(const Section &section) {
 }
 
 /*
- * Helper struct for {@link findSections}.
+ * Translates the filters with known semantics into a query for the
+ * metadata index of the backend, so that only matching sections get
+ * handles. The filter itself is still applied to all results.
  */
-struct SectionCont {
-    SectionCont(Section s, size_t d = 0)
-    : entity(s), depth(d)
-    {}
+static base::SectionQuery section_query(const util::Filter<Section>::type &filter) {
+    base::SectionQuery query;
+
+    if (auto f = filter.target<util::IdFilter<Section>>()) {
+        query.id = f->id;
+    } else if (auto f = filter.target<util::NameFilter<Section>>()) {
+        query.name = f->name;
+    } else if (auto f = filter.target<util::TypeFilter<Section>>()) {
+        query.type = f->type;
+    } else if (auto f = filter.target<util::PropertyFilter<Section>>()) {
+        // the filter also matches property ids, which are not indexed
+        if (!util::looksLikeUUID(f->name)) {
+            query.property = f->name;
+        }
+    }
 
-    Section entity;
-    size_t depth;
-};
+    return query;
+}
 
 
 std::vector<Section> Section::sections(const util::Filter<Section>::type &filter) const {
-    auto f = [this] (size_t i) { return getSection(i); };
-    return getEntities<Section>(f,
-                                sectionCount(),
-                                filter);
+    return filterEntities<Section>(backend()->sections(), filter);
 }
 
 
 std::vector<Section> Section::findSections(const util::Filter<Section>::type &filter,
                                            size_t max_depth) const
 {
-    std::vector<Section>  results;
-    std::list<SectionCont> todo;
-
-    todo.push_back(SectionCont(*this));
-
-    while (todo.size() > 0)
-    {
-        SectionCont current = todo.front();
-        todo.pop_front();
-
-        bool filter_ok = filter(current.entity);
-        if (filter_ok) {
-            results.push_back(current.entity);
-        }
+    std::vector<Section> results;
 
-        if (current.depth < max_depth) {
-            std::vector<Section> children = current.entity.sections();
-            size_t next_depth = current.depth + 1;
-
-            for (auto it = children.begin(); it != children.end(); ++it) {
-                todo.push_back(SectionCont(*it, next_depth));
-            }
+    for (const auto &match : backend()->querySections(section_query(filter), max_depth)) {
+        Section section(match.first);
+        if (filter(section)) {
+            results.push_back(section);
         }
     }
 
@@ -172,10 +167,7 @@ bool Section::hasProperty(const Property &property) const {
 }
 
 std::vector<Property> Section::properties(const util::Filter<Property>::type &filter) const {
-    auto f = [this] (size_t i) { return getProperty(i); };
-    return getEntities<Property>(f,
-            propertyCount(),
-            filter);
+    return filterEntities<Property>(backend()->properties(), filter);
 }
 
 bool Section::deleteProperty(const Property &property) {
@@ -212,31 +204,42 @@ vector<Property> Section::inheritedProperties() const {
 //------------------------------------------------------
 
 size_t Section::tree_depth() const{
-  const vector<Section> children = sections();
-  size_t depth = 0;
-  if (children.size() > 0) {
-      for (auto &child : children) {
-          depth = max(depth, child.tree_depth());
-      }
-      depth += 1;
-  }
-  return depth;
+    size_t depth = 0;
+    for (const auto &match : backend()->querySections(base::SectionQuery(), std::numeric_limits<size_t>::max())) {
+        depth = max(depth, match.second);
+    }
+    return depth;
 }
 
 
-vector<Section> Section::findDownstream(const std::function<bool(Section)> &filter) const{
+vector<Section> Section::findDownstream(const util::Filter<Section>::type &filter) const{
     vector<Section> results;
-    size_t max_depth = tree_depth();
-    size_t actual_depth = 1;
-    while (results.size() == 0 && actual_depth <= max_depth) {
-        results = findSections(filter, actual_depth);
-        actual_depth += 1;
+    if (sectionCount() == 0) {
+        return results;
+    }
+
+    // a single traversal instead of one per depth: all matches up to
+    // the first depth (but at least 1) at which anything matches
+    vector<pair<Section, size_t>> matches;
+    size_t found_depth = std::numeric_limits<size_t>::max();
+    for (const auto &match : backend()->querySections(section_query(filter), std::numeric_limits<size_t>::max())) {
+        Section section(match.first);
+        if (filter(section)) {
+            matches.emplace_back(section, match.second);
+            found_depth = min(found_depth, max(match.second, size_t(1)));
+        }
+    }
+
+    for (const auto &match : matches) {
+        if (match.second <= found_depth) {
+            results.push_back(match.first);
+        }
     }
     return results;
 }
 
 
-vector<Section> Section::findUpstream(const std::function<bool(Section)> &filter) const{
+vector<Section> Section::findUpstream(const util::Filter<Section>::type &filter) const{
     vector<Section> results;
     Section p = parent();
 
@@ -251,7 +254,7 @@ vector<Section> Section::findUpstream(const std::function<bool(Section)> &filter
 }
 
 
-vector<Section> Section::findSideways(const std::function<bool(Section)> &filter, const string &caller_id) const{
+vector<Section> Section::findSideways(const util::Filter<Section>::type &filter, const string &caller_id) const{
     vector<Section> results;
     Section p = parent();
     if (p != nullptr) {
@@ -8,8 +8,6 @@
 
 #include <nix/Source.hpp>
 
-#include <queue>
-
 using namespace std;
 using namespace nix;
 
@@ -50,10 +48,7 @@ bool Source::hasSource(const Source &source) const {
 
 
 std::vector<Source> Source::sources(const util::Filter<Source>::type &filter) const {
-    auto f = [this] (size_t i) { return getSource(i); };
-    return getEntities<Source>(f,
-                               sourceCount(),
-                               filter);
+    return filterEntities<Source>(backend()->sources(), filter);
 }
 
 
@@ -66,41 +61,34 @@ bool Source::deleteSource(const Source &source) {
 
 
 
-struct SourceCont {
-    Source entity;
-    size_t depth;
-};
-
-
 std::vector<Source> Source::findSources(const util::Filter<Source>::type &filter,
                                         size_t max_depth) const
 {
-    std::vector<Source>  results;
-    std::queue<SourceCont> todo;
+    std::vector<Source> results;
 
-    todo.push({*this, 0});
+    for (const auto &match : backend()->querySources(util::sourceQuery(filter), max_depth)) {
+        Source source(match.first);
+        if (filter(source)) {
+            results.push_back(source);
+        }
+    }
 
-    while (todo.size() > 0)
-    {
-        SourceCont current = todo.front();
-        todo.pop();
+    return results;
+}
 
-        bool filter_ok = filter(current.entity);
-        if (filter_ok) {
-            results.push_back(current.entity);
-        }
 
-        if (current.depth < max_depth) {
-            std::vector<Source> children = current.entity.sources();
-            size_t next_depth = current.depth + 1;
+base::SourceQuery util::sourceQuery(const util::Filter<Source>::type &filter) {
+    base::SourceQuery query;
 
-            for (auto it = children.begin(); it != children.end(); ++it) {
-                todo.push({*it, next_depth});
-            }
-        }
+    if (auto f = filter.target<util::IdFilter<Source>>()) {
+        query.id = f->id;
+    } else if (auto f = filter.target<util::NameFilter<Source>>()) {
+        query.name = f->name;
+    } else if (auto f = filter.target<util::TypeFilter<Source>>()) {
+        query.type = f->type;
     }
 
-    return results;
+    return query;
 }
 
 //------------------------------------------------------
@@ -56,10 +56,7 @@ bool Tag::removeReference(const DataArray &reference) {
 
 
 std::vector<DataArray> Tag::references(const util::Filter<DataArray>::type &filter) const {
-    auto f = [this] (size_t i) { return getReference(i); };
-    return getEntities<DataArray>(f,
-                                  referenceCount(),
-                                  filter);
+    return filterEntities<DataArray>(backend()->references(), filter);
 }
 
 bool Tag::hasFeature(const Feature &feature) const {
@@ -71,10 +68,7 @@ bool Tag::hasFeature(const Feature &feature) const {
 
 
 std::vector<Feature> Tag::features(const util::Filter<Feature>::type &filter) const {
-    auto f = [this] (size_t i) { return getFeature(i); };
-    return getEntities<Feature>(f,
-                                featureCount(),
-                                filter);
+    return filterEntities<Feature>(backend()->features(), filter);
 }
 
 
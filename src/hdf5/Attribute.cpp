@@ -10,6 +10,7 @@
 
 #include <nix/hdf5/Attribute.hpp>
 #include <nix/hdf5/DataTypeHDF5.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
 
 namespace nix {
 namespace hdf5 {
@@ -26,6 +27,8 @@ Attribute::Attribute(const Attribute &other) : BaseHDF5(other) {
 
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, void *data) {
+    IOProbe probe(hid, IOOperation::AttrRead);
+    probe.transfer(mem_type.h5id(), H5S_ALL);
     HErr status = H5Aread(hid, mem_type.h5id(), data);
     status.check("Attribute::read(): Could not read data");
 }
@@ -42,6 +45,8 @@ void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *da
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const void *data) {
+    IOProbe probe(hid, IOOperation::AttrWrite);
+    probe.transfer(mem_type.h5id(), H5S_ALL);
     HErr status = H5Awrite(hid, mem_type.h5id(), data);
     status.check("Attribute::write(): Could not write data");
 }
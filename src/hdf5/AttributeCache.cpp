@@ -0,0 +1,195 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/AttributeCache.hpp>
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// part of the file state
+struct attribute_caches {
+    std::mutex lock;
+    std::map<haddr_t, std::weak_ptr<AttributeCache>> entries;
+    size_t prune_at = 64;
+};
+
+struct attr_visit {
+    std::map<std::string, std::string> *values;
+    std::exception_ptr error;
+};
+
+herr_t read_attr(hid_t loc, const char *name, const H5A_info_t *info, void *op_data) {
+    attr_visit *visit = static_cast<attr_visit *>(op_data);
+
+    if (!AttributeCache::cached(name)) {
+        return 0;
+    }
+
+    // exceptions must not unwind through the HDF5 library
+    try {
+        Attribute attr;
+        {
+            IOProbe probe(loc, IOOperation::AttrLookup);
+            attr = H5Aopen(loc, name, H5P_DEFAULT);
+        }
+        attr.check(std::string("AttributeCache: Could not open attribute ") + name);
+
+        h5x::DataType file_type = H5Aget_type(attr.h5id());
+        NDSize dims = attr.extent();
+        if (!file_type.isVariableString() || dims.nelms() != 1) {
+            return 0;
+        }
+
+        std::string value;
+        attr.read(data_type_to_h5_memtype(DataType::String), dims, &value);
+        (*visit->values)[name] = value;
+        return 0;
+    } catch (...) {
+        visit->error = std::current_exception();
+        return -1;
+    }
+}
+
+} // anonymous namespace
+
+
+std::shared_ptr<AttributeCache> AttributeCache::forObject(const LocID &obj) {
+    ObjectAddress address = obj.address();
+    std::shared_ptr<attribute_caches> caches = FileState::get<attribute_caches>(address.first);
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    attribute_caches &reg = *caches;
+
+    auto it = reg.entries.find(address.second);
+    if (it != reg.entries.end()) {
+        std::shared_ptr<AttributeCache> cache = it->second.lock();
+        if (cache) {
+            return cache;
+        }
+    }
+
+    // drop the entries of caches that are gone, now and then
+    if (reg.entries.size() >= reg.prune_at) {
+        for (auto jt = reg.entries.begin(); jt != reg.entries.end(); ) {
+            if (jt->second.expired()) {
+                jt = reg.entries.erase(jt);
+            } else {
+                ++jt;
+            }
+        }
+        reg.prune_at = std::max<size_t>(64, 2 * reg.entries.size());
+    }
+
+    std::shared_ptr<AttributeCache> cache = std::make_shared<AttributeCache>();
+    reg.entries[address.second] = cache;
+    return cache;
+}
+
+
+void AttributeCache::update(const ObjectAddress &address, const std::string &name, const std::string &value) {
+    std::shared_ptr<attribute_caches> caches = FileState::find<attribute_caches>(address.first);
+    if (!caches) {
+        return;
+    }
+
+    std::shared_ptr<AttributeCache> cache;
+    {
+        std::lock_guard<std::mutex> guard(caches->lock);
+        auto it = caches->entries.find(address.second);
+        if (it != caches->entries.end()) {
+            cache = it->second.lock();
+        }
+    }
+
+    if (cache) {
+        std::lock_guard<std::mutex> cache_guard(cache->lock);
+        if (cache->loaded) {
+            cache->values[name] = value;
+        }
+    }
+}
+
+
+bool AttributeCache::cached(const std::string &name) {
+    return name == "entity_id" || name == "name" || name == "type" || name == "definition" ||
+           name == "created_at" || name == "updated_at";
+}
+
+
+void AttributeCache::load(const LocID &obj) {
+    attr_visit visit = {&values, nullptr};
+    hsize_t idx = 0;
+
+    values.clear();
+    HErr res = H5Aiterate2(obj.h5id(), H5_INDEX_NAME, H5_ITER_NATIVE, &idx, read_attr, &visit);
+    if (visit.error) {
+        values.clear();
+        std::rethrow_exception(visit.error);
+    }
+    res.check("AttributeCache: Could not iterate over attributes");
+
+    loaded = true;
+}
+
+
+bool AttributeCache::get(const LocID &obj, const std::string &name, std::string &value) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!loaded) {
+        load(obj);
+    }
+
+    auto it = values.find(name);
+    if (it == values.end()) {
+        return false;
+    }
+
+    value = it->second;
+    return true;
+}
+
+
+bool AttributeCache::has(const LocID &obj, const std::string &name) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!loaded) {
+        load(obj);
+    }
+
+    return values.find(name) != values.end();
+}
+
+
+void AttributeCache::set(const LocID &obj, const std::string &name, const std::string &value) {
+    obj.setAttr(name, value);
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (loaded) {
+        values[name] = value;
+    }
+}
+
+
+void AttributeCache::remove(const LocID &obj, const std::string &name) {
+    if (obj.hasAttr(name)) {
+        obj.removeAttr(name);
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    values.erase(name);
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -9,6 +9,9 @@
 #include <nix/hdf5/BaseHDF5.hpp>
 #include <nix/hdf5/ExceptionHDF5.hpp>
 
+#include <algorithm>
+#include <cstddef>
+
 
 namespace nix {
 namespace hdf5 {
@@ -128,5 +131,64 @@ void BaseHDF5::invalidate() {
     hid = H5I_INVALID_HID;
 }
 
+//--------------------------------------------------
+// VlenArena
+//--------------------------------------------------
+
+namespace {
+
+const size_t ARENA_ALIGN = alignof(std::max_align_t);
+const size_t ARENA_BLOCK_MIN = 64 * 1024;
+const size_t ARENA_BLOCK_MAX = 8 * 1024 * 1024;
+
+void *arena_alloc(size_t size, void *info) {
+    try {
+        return static_cast<VlenArena *>(info)->allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void arena_free(void *mem, void *info) {
+    // released with the arena
+}
+
+} // anonymous namespace
+
+
+VlenArena::VlenArena()
+    : plist(H5Pcreate(H5P_DATASET_XFER)), cur(nullptr), avail(0), block_size(ARENA_BLOCK_MIN), total(0)
+{
+    plist.check("VlenArena: Could not create transfer plist");
+
+    HErr res = H5Pset_vlen_mem_manager(plist.h5id(), arena_alloc, this, arena_free, this);
+    res.check("VlenArena: Could not set vlen memory manager");
+}
+
+
+void *VlenArena::allocate(size_t size) {
+    size = (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+
+    if (size > avail) {
+        // large requests get a block of their own, the current one stays in use
+        if (size > block_size / 4) {
+            blocks.emplace_back(new char[size]);
+            total += size;
+            return blocks.back().get();
+        }
+
+        blocks.emplace_back(new char[block_size]);
+        cur = blocks.back().get();
+        avail = block_size;
+        block_size = std::min(block_size * 2, ARENA_BLOCK_MAX);
+    }
+
+    void *mem = cur;
+    cur += size;
+    avail -= size;
+    total += size;
+    return mem;
+}
+
 } // namespace hdf5
 } // namespace nix
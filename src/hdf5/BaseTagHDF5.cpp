@@ -14,6 +14,7 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/BlockHDF5.hpp>
 #include <nix/hdf5/FeatureHDF5.hpp>
+#include <nix/hdf5/HandleCache.hpp>
 #include <nix/Exception.hpp>
 
 #include <algorithm>
@@ -81,23 +82,32 @@ shared_ptr<IDataArray>  BaseTagHDF5::getReference(const std::string &name_or_id)
 
     if (g && hasReference(id)) {
         Group group = g->openGroup(id);
-        da = make_shared<DataArrayHDF5>(file(), block(), group);
+        da = HandleCache::get<DataArrayHDF5>(group, [&] {
+            return make_shared<DataArrayHDF5>(file(), block(), group);
+        });
     }
 
     return da;
 }
 
 shared_ptr<IDataArray>  BaseTagHDF5::getReference(size_t index) const {
-    // check if index valid
-    if(index > referenceCount()) {
+    boost::optional<Group> g = refs_group();
+    if (!g) {
         throw OutOfBounds("No reference at given index", index);
     }
 
-    boost::optional<Group> g = refs_group();
-    string id = g ? g->objectName(index) : "";
+    // objectName() checks the index
+    string id = g->objectName(index);
     return getReference(id);
 }
 
+
+vector<shared_ptr<IDataArray>> BaseTagHDF5::references() const {
+    return HandleCache::all<IDataArray, DataArrayHDF5>(refs_group(), [this](const Group &grp) {
+        return make_shared<DataArrayHDF5>(file(), block(), grp);
+    });
+}
+
 void BaseTagHDF5::addReference(const std::string &name_or_id) {
     if (name_or_id.empty())
         throw EmptyString("addReference");
@@ -132,15 +142,21 @@ void BaseTagHDF5::references(const std::vector<DataArray> &refs_new) {
     // extract vectors of names from vectors of new & old references
     std::vector<std::string> names_new(refs_new.size());
     transform(refs_new.begin(), refs_new.end(), names_new.begin(), util::toName<DataArray>);
-	//FIXME: issue 473
-    std::vector<DataArray> refs_old(static_cast<size_t>(referenceCount()));
-    for (size_t i = 0; i < refs_old.size(); i++) refs_old[i] = getReference(i);
-    std::vector<std::string> names_old(refs_old.size());
-    transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<DataArray>);
+    std::vector<std::string> names_old;
+    boost::optional<Group> g = refs_group();
+    if (g) {
+        g->visitLinks([this, &names_old](const Link &link) {
+            shared_ptr<IDataArray> ref = getReference(link.name);
+            if (ref) {
+                names_old.push_back(ref->name());
+            }
+            return true;
+        });
+    }
 
     // sort them
     std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
+    std::sort(names_old.begin(), names_old.end());
 
     // get names only in names_new (add), names only in names_old (remove) & ignore rest
     std::vector<std::string> names_add;
@@ -195,11 +211,32 @@ shared_ptr<IFeature> BaseTagHDF5::getFeature(const std::string &name_or_id) cons
 
 shared_ptr<IFeature>  BaseTagHDF5::getFeature(size_t index) const {
     boost::optional<Group> g = feature_group();
+    if (!g) {
+        throw OutOfBounds("No feature at given index", index);
+    }
+
     string id = g->objectName(index);
     return getFeature(id);
 }
 
 
+vector<shared_ptr<IFeature>> BaseTagHDF5::features() const {
+    vector<shared_ptr<IFeature>> features;
+    boost::optional<Group> g = feature_group();
+
+    if (g) {
+        g->visitLinks([&](const Link &link) {
+            if (link.type == H5O_TYPE_GROUP) {
+                features.push_back(make_shared<FeatureHDF5>(file(), block(), g->openGroup(link.name, false)));
+            }
+            return true;
+        }, true);
+    }
+
+    return features;
+}
+
+
 shared_ptr<IFeature>  BaseTagHDF5::createFeature(const std::string &name_or_id, LinkType link_type) {
     if(!block()->hasDataArray(name_or_id)) {
         throw std::runtime_error("DataArray not found in Block!");
@@ -14,6 +14,12 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/TagHDF5.hpp>
 #include <nix/hdf5/MultiTagHDF5.hpp>
+#include <nix/hdf5/HandleCache.hpp>
+#include <nix/hdf5/SourceIndex.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+#include <nix/hdf5/DataTypeHDF5.hpp>
+
+#include <exception>
 
 #include <boost/range/irange.hpp>
 
@@ -23,6 +29,107 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+namespace {
+
+// returns the cached backend object of the entity group or creates a new one
+template<typename T, typename F>
+shared_ptr<T> cached_entity(const Group &group, F make) {
+    ObjectAddress address = group.address();
+    shared_ptr<T> entity = HandleCache::find<T>(address);
+
+    if (!entity) {
+        entity = make(group);
+        HandleCache::add(address, entity);
+    }
+
+    return entity;
+}
+
+
+// the entities of the container that reference a source, see SourceReferences::of()
+template<typename I, typename T, typename F>
+vector<shared_ptr<I>> referencing_entities(const boost::optional<Group> &container,
+                                           const vector<SourceReferences::Referrer> &referrers, F make) {
+    vector<shared_ptr<I>> entities;
+
+    if (!container) {
+        return entities;
+    }
+
+    for (const auto &referrer : referrers) {
+        shared_ptr<T> entity = HandleCache::find<T>(referrer.address);
+
+        if (!entity) {
+            if (!container->hasGroup(referrer.link)) {
+                continue;
+            }
+            Group group = container->openGroup(referrer.link, false);
+            // the referrer belongs to another block
+            if (group.address() != referrer.address) {
+                continue;
+            }
+            entity = make(group);
+            HandleCache::add(referrer.address, entity);
+        }
+
+        entities.push_back(entity);
+    }
+
+    return entities;
+}
+
+
+// attributes of a data array read by describeDataArrays()
+struct data_array_attrs {
+    std::map<std::string, std::string> strings;
+    std::vector<uint64_t> logical_extent;
+    bool has_logical_extent = false;
+    std::exception_ptr error;
+};
+
+
+herr_t read_data_array_attr(hid_t loc, const char *name, const H5A_info_t *info, void *op_data) {
+    data_array_attrs *attrs = static_cast<data_array_attrs *>(op_data);
+    std::string attr_name(name);
+
+    bool is_string = attr_name == "entity_id" || attr_name == "name" || attr_name == "type" ||
+                     attr_name == "created_at" || attr_name == "unit";
+    if (!is_string && attr_name != "logical_extent") {
+        return 0;
+    }
+
+    // exceptions must not unwind through the HDF5 library
+    try {
+        Attribute attr;
+        {
+            IOProbe probe(loc, IOOperation::AttrLookup);
+            attr = H5Aopen(loc, name, H5P_DEFAULT);
+        }
+        attr.check("BlockHDF5::describeDataArrays: Could not open attribute " + attr_name);
+
+        h5x::DataType file_type = H5Aget_type(attr.h5id());
+        NDSize dims = attr.extent();
+
+        if (is_string) {
+            if (file_type.isVariableString() && dims.nelms() == 1) {
+                attr.read(data_type_to_h5_memtype(DataType::String), dims, &attrs->strings[attr_name]);
+            }
+        } else {
+            attrs->logical_extent.resize(dims.nelms());
+            attr.read(data_type_to_h5_memtype(DataType::UInt64), dims, attrs->logical_extent.data());
+            attrs->has_logical_extent = true;
+        }
+
+        return 0;
+    } catch (...) {
+        attrs->error = std::current_exception();
+        return -1;
+    }
+}
+
+
+} // anonymous namespace
+
 
 BlockHDF5::BlockHDF5(const std::shared_ptr<base::IFile> &file, const Group &group)
         : EntityWithMetadataHDF5(file, group) {
@@ -61,9 +168,11 @@ shared_ptr<ISource> BlockHDF5::getSource(const string &name_or_id) const {
     boost::optional<Group> g = source_group();
 
     if (g) {
-        boost::optional<Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<Group> group = source_index.findGroupByNameOrId(*g, name_or_id);
         if (group)
-            source = make_shared<SourceHDF5>(file(), *group);
+            source = cached_entity<SourceHDF5>(*group, [this](const Group &grp) {
+                return make_shared<SourceHDF5>(file(), grp);
+            });
     }
 
     return source;
@@ -83,6 +192,13 @@ ndsize_t BlockHDF5::sourceCount() const {
 }
 
 
+vector<shared_ptr<ISource>> BlockHDF5::sources() const {
+    return HandleCache::all<ISource, SourceHDF5>(source_group(), [this](const Group &grp) {
+        return make_shared<SourceHDF5>(file(), grp);
+    });
+}
+
+
 shared_ptr<ISource> BlockHDF5::createSource(const string &name, const string &type) {
     if (name.empty()) {
         throw EmptyString("name");
@@ -94,7 +210,12 @@ shared_ptr<ISource> BlockHDF5::createSource(const string &name, const string &ty
     boost::optional<Group> g = source_group(true);
 
     Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), group, id, type, name);
+    auto source = make_shared<SourceHDF5>(file(), group, id, type, name);
+    HandleCache::add(group.address(), source);
+    source_index.add(*g, id, name);
+    SourceIndex::invalidate(group);
+
+    return source;
 }
 
 
@@ -103,16 +224,17 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
     bool deleted = false;
 
     if (g) {
-        // call deleteSource on sources to trigger recursive call to all sub-sources
-        if (hasSource(name_or_id)) {
-            // get instance of source about to get deleted
-            Source source = getSource(name_or_id);
-            // loop through all child sources and call deleteSource on them
-            for (auto &child : source.sources()) {
-                source.deleteSource(child.id());
-            }
-            // if hasSource is true then source_group always exists
-            deleted = g->removeAllLinks(source.name());
+        boost::optional<Group> group = source_index.findGroupByNameOrId(*g, name_or_id);
+        if (group) {
+            string id, name;
+            group->getAttr("entity_id", id);
+            group->getAttr("name", name);
+
+            // the sub-sources are removed with a single pass over the indexed tree
+            SourceHDF5::deleteDescendants(this->group(), id);
+            source_index.remove(*g, id, name);
+            deleted = g->removeAllLinks(name);
+            SourceIndex::invalidate(this->group());
         }
     }
 
@@ -120,6 +242,86 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
 }
 
 
+vector<pair<shared_ptr<ISource>, size_t>> BlockHDF5::querySources(const SourceQuery &query,
+                                                                    size_t max_depth) const {
+    vector<pair<shared_ptr<ISource>, size_t>> results;
+    shared_ptr<const SourceIndex> index = SourceIndex::get(group());
+    string block_id = id();
+
+    if (index->roots(block_id).size() != sourceCount()) {
+        // the tree was changed behind our back, e.g. by another handle of the file
+        SourceIndex::invalidate(group());
+        index = SourceIndex::get(group());
+    }
+
+    for (size_t root : index->roots(block_id)) {
+        for (const auto &match : index->query(root, query, max_depth)) {
+            results.emplace_back(SourceHDF5::fromIndex(file(), group(), index->node(match.first)), match.second);
+        }
+    }
+
+    return results;
+}
+
+
+vector<shared_ptr<IDataArray>> BlockHDF5::referencingDataArrays(const string &source_id) const {
+    shared_ptr<const SourceReferences> refs = SourceReferences::get(group());
+    return referencing_entities<IDataArray, DataArrayHDF5>(data_array_group(), refs->of(source_id).data_arrays,
+                                                           [this](const Group &grp) {
+        return make_shared<DataArrayHDF5>(file(), block(), grp);
+    });
+}
+
+
+vector<shared_ptr<ITag>> BlockHDF5::referencingTags(const string &source_id) const {
+    shared_ptr<const SourceReferences> refs = SourceReferences::get(group());
+    return referencing_entities<ITag, TagHDF5>(tag_group(), refs->of(source_id).tags,
+                                               [this](const Group &grp) {
+        return make_shared<TagHDF5>(file(), block(), grp);
+    });
+}
+
+
+vector<shared_ptr<IMultiTag>> BlockHDF5::referencingMultiTags(const string &source_id) const {
+    shared_ptr<const SourceReferences> refs = SourceReferences::get(group());
+    return referencing_entities<IMultiTag, MultiTagHDF5>(multi_tag_group(), refs->of(source_id).multi_tags,
+                                                         [this](const Group &grp) {
+        return make_shared<MultiTagHDF5>(file(), block(), grp);
+    });
+}
+
+
+boost::optional<Group> BlockHDF5::findSourceGroup(const string &id) const {
+    boost::optional<Group> g = source_group();
+    if (!g) {
+        return none;
+    }
+
+    boost::optional<string> name = source_index.lookup(*g, id);
+    if (name) {
+        return g->openGroup(*name, false);
+    }
+
+    shared_ptr<const SourceIndex> index = SourceIndex::get(group());
+    size_t pos = index->find(id);
+    if (pos == SourceIndex::npos) {
+        // the tree was changed behind our back, e.g. by another handle of the file
+        SourceIndex::invalidate(group());
+        index = SourceIndex::get(group());
+        pos = index->find(id);
+    }
+
+    if (pos == SourceIndex::npos || index->node(pos).block != this->id()) {
+        return none;
+    }
+
+    const SourceIndex::Node &node = index->node(pos);
+    Group source(H5Gopen(group().h5id(), node.path.c_str(), H5P_DEFAULT));
+    source.check("BlockHDF5::findSourceGroup: Could not open source " + node.path);
+    return source;
+}
+
+
 //--------------------------------------------------
 // Methods related to Tag
 //--------------------------------------------------
@@ -134,7 +336,11 @@ shared_ptr<ITag> BlockHDF5::createTag(const std::string &name, const std::string
     boost::optional<Group> g = tag_group(true);
 
     Group group = g->openGroup(name);
-    return make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    auto tag = make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    HandleCache::add(group.address(), tag);
+    tag_index.add(*g, id, name);
+
+    return tag;
 }
 
 
@@ -148,9 +354,11 @@ shared_ptr<ITag> BlockHDF5::getTag(const string &name_or_id) const {
     boost::optional<Group> g = tag_group();
 
     if (g) {
-        boost::optional<Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<Group> group = tag_index.findGroupByNameOrId(*g, name_or_id);
         if (group)
-            tag = make_shared<TagHDF5>(file(), block(), *group);
+            tag = cached_entity<TagHDF5>(*group, [this](const Group &grp) {
+                return make_shared<TagHDF5>(file(), block(), grp);
+            });
     }
 
     return tag;
@@ -170,13 +378,23 @@ ndsize_t BlockHDF5::tagCount() const {
 }
 
 
+vector<shared_ptr<ITag>> BlockHDF5::tags() const {
+    return HandleCache::all<ITag, TagHDF5>(tag_group(), [this](const Group &grp) {
+        return make_shared<TagHDF5>(file(), block(), grp);
+    });
+}
+
+
 bool BlockHDF5::deleteTag(const std::string &name_or_id) {
     boost::optional<Group> g = tag_group();
     bool deleted = false;
 
     if (hasTag(name_or_id) && g) {
+        shared_ptr<ITag> tag = getTag(name_or_id);
+        tag_index.remove(*g, tag->id(), tag->name());
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getTag(name_or_id)->name());
+        deleted = g->removeAllLinks(tag->name());
+        SourceReferences::invalidate(*g);
     }
 
     return deleted;
@@ -198,9 +416,11 @@ shared_ptr<IDataArray> BlockHDF5::getDataArray(const string &name_or_id) const {
     boost::optional<Group> g = data_array_group();
 
     if (g) {
-        boost::optional<Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<Group> group = data_array_index.findGroupByNameOrId(*g, name_or_id);
         if (group)
-            da = make_shared<DataArrayHDF5>(file(), block(), *group);
+            da = cached_entity<DataArrayHDF5>(*group, [this](const Group &grp) {
+                return make_shared<DataArrayHDF5>(file(), block(), grp);
+            });
     }
 
     return da;
@@ -220,21 +440,98 @@ ndsize_t BlockHDF5::dataArrayCount() const {
 }
 
 
+vector<shared_ptr<IDataArray>> BlockHDF5::dataArrays() const {
+    return HandleCache::all<IDataArray, DataArrayHDF5>(data_array_group(), [this](const Group &grp) {
+        return make_shared<DataArrayHDF5>(file(), block(), grp);
+    });
+}
+
+
+void BlockHDF5::describeDataArrays(DataArraySummary &summary) const {
+    boost::optional<Group> g = data_array_group();
+    if (!g) {
+        return;
+    }
+
+    string block_name = name();
+    size_t count = summary.size() + g->objectCount();
+    summary.dtype.reserve(count);
+    summary.shape.reserve(count);
+    summary.created_at.reserve(count);
+
+    g->visitLinks([&](const Link &link) {
+        Group da;
+        H5E_BEGIN_TRY {
+            IOProbe probe(g->h5id(), IOOperation::ObjectOpen);
+            da = Group(H5Gopen(g->h5id(), link.name.c_str(), H5P_DEFAULT), false);
+        } H5E_END_TRY;
+
+        if (!da.isValid()) {
+            return true;
+        }
+
+        data_array_attrs attrs;
+        hsize_t idx = 0;
+        HErr res = H5Aiterate2(da.h5id(), H5_INDEX_NAME, H5_ITER_NATIVE, &idx, read_data_array_attr, &attrs);
+        if (attrs.error) {
+            std::rethrow_exception(attrs.error);
+        }
+        res.check("BlockHDF5::describeDataArrays: Could not iterate over attributes");
+
+        DataSet ds;
+        H5E_BEGIN_TRY {
+            IOProbe probe(da.h5id(), IOOperation::ObjectOpen);
+            ds = DataSet(H5Dopen(da.h5id(), "data", H5P_DEFAULT), false);
+        } H5E_END_TRY;
+
+        DataType dtype = DataType::Nothing;
+        NDSize shape{};
+        if (ds.isValid()) {
+            dtype = ds.dataType();
+            if (attrs.has_logical_extent) {
+                shape = NDSize(attrs.logical_extent.size());
+                std::copy(attrs.logical_extent.begin(), attrs.logical_extent.end(), shape.begin());
+            } else {
+                shape = ds.size();
+            }
+        }
+
+        auto &strings = attrs.strings;
+        summary.block.push_back(block_name);
+        summary.id.push_back(strings["entity_id"]);
+        summary.name.push_back(strings.count("name") ? strings["name"] : link.name);
+        summary.type.push_back(strings["type"]);
+        summary.dtype.push_back(dtype);
+        summary.shape.push_back(shape);
+        summary.unit.push_back(strings["unit"]);
+        summary.created_at.push_back(strings.count("created_at") ? util::strToTime(strings["created_at"]) : 0);
+
+        return true;
+    });
+}
+
+
 shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
-                                                  const NDSize &shape) {
+                                                  const NDSize &shape,
+                                                  const ChunkingHint &hint,
+                                                  const Compression &compression) {
     if (hasDataArray(name)) {
         throw DuplicateName("createDataArray");
     }
+    DataArrayHDF5::checkData(data_type, shape, hint, compression);
+
     string id = util::createId();
     boost::optional<Group> g = data_array_group(true);
 
     Group group = g->openGroup(name, true);
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
+    HandleCache::add(group.address(), da);
+    data_array_index.add(*g, id, name);
 
     // now create the actual H5::DataSet
-    da->createData(data_type, shape);
+    da->createData(data_type, shape, hint, compression);
 
     return da;
 }
@@ -245,8 +542,13 @@ bool BlockHDF5::deleteDataArray(const string &name_or_id) {
     boost::optional<Group> g = data_array_group();
 
     if (hasDataArray(name_or_id) && g) {
+        shared_ptr<IDataArray> da = getDataArray(name_or_id);
+        data_array_index.remove(*g, da->id(), da->name());
+        // the address of the data might get reused by new data sets
+        da->chunkCache(none);
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getDataArray(name_or_id)->name());
+        deleted = g->removeAllLinks(da->name());
+        SourceReferences::invalidate(*g);
     }
 
     return deleted;
@@ -270,7 +572,11 @@ shared_ptr<IMultiTag> BlockHDF5::createMultiTag(const std::string &name, const s
     boost::optional<Group> g = multi_tag_group(true);
 
     Group group = g->openGroup(name);
-    return make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    auto mtag = make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    HandleCache::add(group.address(), mtag);
+    multi_tag_index.add(*g, id, name);
+
+    return mtag;
 }
 
 
@@ -284,9 +590,11 @@ shared_ptr<IMultiTag> BlockHDF5::getMultiTag(const string &name_or_id) const {
     boost::optional<Group> g = multi_tag_group();
 
     if (g) {
-        boost::optional<Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<Group> group = multi_tag_index.findGroupByNameOrId(*g, name_or_id);
         if (group)
-            mtag = make_shared<MultiTagHDF5>(file(), block(), *group);
+            mtag = cached_entity<MultiTagHDF5>(*group, [this](const Group &grp) {
+                return make_shared<MultiTagHDF5>(file(), block(), grp);
+            });
     }
 
     return mtag;
@@ -306,13 +614,23 @@ ndsize_t BlockHDF5::multiTagCount() const {
 }
 
 
+vector<shared_ptr<IMultiTag>> BlockHDF5::multiTags() const {
+    return HandleCache::all<IMultiTag, MultiTagHDF5>(multi_tag_group(), [this](const Group &grp) {
+        return make_shared<MultiTagHDF5>(file(), block(), grp);
+    });
+}
+
+
 bool BlockHDF5::deleteMultiTag(const std::string &name_or_id) {
     boost::optional<Group> g = multi_tag_group();
     bool deleted = false;
 
     if (hasMultiTag(name_or_id) && g) {
+        shared_ptr<IMultiTag> mtag = getMultiTag(name_or_id);
+        multi_tag_index.remove(*g, mtag->id(), mtag->name());
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getMultiTag(name_or_id)->name());
+        deleted = g->removeAllLinks(mtag->name());
+        SourceReferences::invalidate(*g);
     }
 
     return deleted;
@@ -0,0 +1,355 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/ChunkCache.hpp>
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// number of enabled caches of all files, lets find() skip the look-up of
+// the data set address while there are none
+std::atomic<size_t> enabled_count(0);
+
+// part of the file state
+struct chunk_caches {
+    std::mutex lock;
+    std::map<haddr_t, std::shared_ptr<ChunkCache>> entries;
+
+    ~chunk_caches() {
+        enabled_count -= entries.size();
+    }
+};
+
+
+// calls f with every index in [first, last] (inclusive), last dimension fastest
+template<typename F>
+void for_each_index(const NDSize &first, const NDSize &last, F f) {
+    const size_t rank = first.size();
+    std::vector<ndsize_t> idx(first.data(), first.data() + rank);
+
+    while (true) {
+        f(idx);
+
+        size_t d = rank;
+        while (d > 0) {
+            --d;
+            if (idx[d] < last[d]) {
+                idx[d]++;
+                break;
+            }
+            idx[d] = first[d];
+            if (d == 0) {
+                return;
+            }
+        }
+    }
+}
+
+
+} // anonymous namespace
+
+
+ChunkCache::ChunkCache(const DataSet &data, size_t capacity, size_t read_ahead)
+    : read_ahead(read_ahead)
+{
+    native_type = data.dataType();
+    chunk_shape = data.chunking();
+
+    cacheable = chunk_shape.size() > 0 &&
+                native_type != DataType::String &&
+                native_type != DataType::Opaque &&
+                native_type != DataType::Nothing;
+
+    element_size = cacheable ? data_type_to_size(native_type) : 0;
+    counters.capacity = capacity;
+}
+
+
+bool ChunkCache::read(const DataSet &data, const NDSize &extent, DataType dtype, void *buffer,
+                      const NDSize &count, const NDSize &offset) {
+    const size_t rank = chunk_shape.size();
+
+    if (!cacheable || dtype == DataType::String || dtype == DataType::Opaque ||
+        count.size() != rank || offset.size() != rank || extent.size() != rank || count.nelms() == 0) {
+        return false;
+    }
+
+    // out of bounds requests are left to the caller to report
+    for (size_t d = 0; d < rank; d++) {
+        if (offset[d] + count[d] > extent[d]) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    // chunks are cut at the extent of the data set, which does not
+    // change with the logical extent
+    NDSize physical = data.size();
+
+    NDSize first(rank), last(rank), range(rank);
+    for (size_t d = 0; d < rank; d++) {
+        first[d] = offset[d] / chunk_shape[d];
+        last[d] = (offset[d] + count[d] - 1) / chunk_shape[d];
+        range[d] = last[d] - first[d] + 1;
+    }
+
+    const ndsize_t chunk_bytes = chunk_shape.nelms() * element_size;
+    if (range.nelms() * chunk_bytes > counters.capacity) {
+        return false;
+    }
+
+    // bounding box of the chunks we do not have yet
+    size_t missing = 0;
+    NDSize miss_first(first), miss_last(first);
+    for_each_index(first, last, [&](const ChunkIndex &idx) {
+        if (chunks.count(idx)) {
+            return;
+        }
+        for (size_t d = 0; d < rank; d++) {
+            miss_first[d] = missing ? std::min(miss_first[d], idx[d]) : idx[d];
+            miss_last[d] = missing ? std::max(miss_last[d], idx[d]) : idx[d];
+        }
+        missing++;
+    });
+
+    counters.hits += range.nelms() - missing;
+    counters.misses += missing;
+
+    if (missing) {
+        // extend the box along the first dimension as far as the
+        // read-ahead, the extent and the capacity allow
+        ndsize_t rows = miss_last[0] - miss_first[0] + 1;
+        ndsize_t slab_bytes = range.nelms() / range[0] * chunk_bytes;
+        ndsize_t max_rows = std::max<ndsize_t>(counters.capacity / slab_bytes, rows);
+        ndsize_t end = (physical[0] - 1) / chunk_shape[0];
+
+        rows = std::min<ndsize_t>(rows + read_ahead, max_rows);
+        miss_last[0] = std::min(miss_first[0] + rows - 1, end);
+        load(data, physical, miss_first, miss_last);
+    }
+
+    const bool convert = dtype != native_type;
+    const size_t out_size = data_type_to_size(dtype);
+    const size_t nelms = count.nelms();
+
+    std::vector<char> scratch;
+    char *out = static_cast<char *>(buffer);
+    if (convert) {
+        scratch.resize(nelms * std::max(out_size, element_size));
+        out = scratch.data();
+    }
+
+    for_each_index(first, last, [&](const ChunkIndex &idx) {
+        auto it = chunks.find(idx);
+        touch(it->second);
+
+        NDSize start(rank), src_off(rank), dst_off(rank), box(rank);
+        for (size_t d = 0; d < rank; d++) {
+            start[d] = idx[d] * chunk_shape[d];
+            ndsize_t lo = std::max(offset[d], start[d]);
+            ndsize_t hi = std::min(offset[d] + count[d], start[d] + it->second.shape[d]);
+            src_off[d] = lo - start[d];
+            dst_off[d] = lo - offset[d];
+            box[d] = hi - lo;
+        }
+
+        util::copyBlock(it->second.data.data(), it->second.shape, src_off, out, count, dst_off, box, element_size);
+    });
+
+    evict();
+
+    if (convert) {
+        h5x::DataType src_type = data_type_to_h5_memtype(native_type);
+        h5x::DataType dst_type = data_type_to_h5_memtype(dtype);
+        HErr res = H5Tconvert(src_type.h5id(), dst_type.h5id(), nelms, out, nullptr, H5P_DEFAULT);
+        res.check("ChunkCache::read(): Could not convert data");
+        std::memcpy(buffer, out, nelms * out_size);
+    }
+
+    return true;
+}
+
+
+void ChunkCache::load(const DataSet &data, const NDSize &extent, const NDSize &first, const NDSize &last) {
+    const size_t rank = chunk_shape.size();
+
+    NDSize start(rank), count(rank);
+    for (size_t d = 0; d < rank; d++) {
+        start[d] = first[d] * chunk_shape[d];
+        count[d] = std::min((last[d] + 1) * chunk_shape[d], extent[d]) - start[d];
+    }
+
+    std::vector<char> region(count.nelms() * element_size);
+
+    Selection fileSel = data.createSelection();
+    fileSel.select(count, start);
+    Selection memSel(DataSpace::create(count, false));
+    data.read(native_type, region.data(), fileSel, memSel);
+
+    for_each_index(first, last, [&](const ChunkIndex &idx) {
+        if (chunks.count(idx)) {
+            return;
+        }
+
+        Chunk &chunk = chunks[idx];
+        NDSize src_off(rank);
+        chunk.shape = NDSize(rank);
+        for (size_t d = 0; d < rank; d++) {
+            ndsize_t chunk_start = idx[d] * chunk_shape[d];
+            src_off[d] = chunk_start - start[d];
+            chunk.shape[d] = std::min(chunk_shape[d], extent[d] - chunk_start);
+        }
+
+        chunk.data.resize(chunk.shape.nelms() * element_size);
+        util::copyBlock(region.data(), count, src_off, chunk.data.data(), chunk.shape, NDSize(rank, 0),
+                        chunk.shape, element_size);
+
+        // chunks that were only read ahead are the first to go, the
+        // requested ones are moved to the front by read()
+        chunk.lru_pos = lru.insert(lru.end(), idx);
+        counters.size += chunk.data.size();
+    });
+}
+
+
+void ChunkCache::touch(Chunk &chunk) {
+    lru.splice(lru.begin(), lru, chunk.lru_pos);
+}
+
+
+void ChunkCache::evict() {
+    while (counters.size > counters.capacity && !lru.empty()) {
+        auto it = chunks.find(lru.back());
+        counters.size -= it->second.data.size();
+        counters.evictions++;
+        chunks.erase(it);
+        lru.pop_back();
+    }
+}
+
+
+void ChunkCache::invalidate(const NDSize &count, const NDSize &offset) {
+    const size_t rank = chunk_shape.size();
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (count.size() != rank || offset.size() != rank) {
+        chunks.clear();
+        lru.clear();
+        counters.size = 0;
+        return;
+    }
+
+    for (auto it = chunks.begin(); it != chunks.end(); ) {
+        bool overlaps = true;
+        for (size_t d = 0; d < rank && overlaps; d++) {
+            ndsize_t start = it->first[d] * chunk_shape[d];
+            overlaps = start < offset[d] + count[d] && offset[d] < start + it->second.shape[d];
+        }
+
+        if (overlaps) {
+            counters.size -= it->second.data.size();
+            lru.erase(it->second.lru_pos);
+            it = chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+
+void ChunkCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    chunks.clear();
+    lru.clear();
+    counters.size = 0;
+}
+
+
+ChunkCacheStats ChunkCache::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+
+std::shared_ptr<ChunkCache> ChunkCache::find(const DataSet &data) {
+    if (enabled_count == 0) {
+        return std::shared_ptr<ChunkCache>();
+    }
+
+    ObjectAddress address = data.address();
+    std::shared_ptr<chunk_caches> caches = FileState::find<chunk_caches>(address.first);
+    if (!caches) {
+        return std::shared_ptr<ChunkCache>();
+    }
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    auto it = caches->entries.find(address.second);
+    return it != caches->entries.end() ? it->second : std::shared_ptr<ChunkCache>();
+}
+
+
+void ChunkCache::enable(const DataSet &data, size_t capacity, size_t read_ahead) {
+    std::shared_ptr<ChunkCache> cache = std::make_shared<ChunkCache>(data, capacity, read_ahead);
+
+    ObjectAddress address = data.address();
+    std::shared_ptr<chunk_caches> caches = FileState::get<chunk_caches>(address.first);
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    std::shared_ptr<ChunkCache> &entry = caches->entries[address.second];
+    if (!entry) {
+        enabled_count++;
+    }
+    entry = cache;
+}
+
+
+void ChunkCache::disable(const DataSet &data) {
+    if (enabled_count == 0) {
+        return;
+    }
+
+    ObjectAddress address = data.address();
+    std::shared_ptr<chunk_caches> caches = FileState::find<chunk_caches>(address.first);
+    if (!caches) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    enabled_count -= caches->entries.erase(address.second);
+}
+
+
+void ChunkCache::clearCache(const LocID &file) {
+    if (enabled_count == 0) {
+        return;
+    }
+
+    std::shared_ptr<chunk_caches> caches = FileState::find<chunk_caches>(file);
+    if (!caches) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    enabled_count -= caches->entries.size();
+    caches->entries.clear();
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -11,6 +11,14 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/DataSetHDF5.hpp>
 #include <nix/hdf5/DimensionHDF5.hpp>
+#include <nix/hdf5/ChunkCache.hpp>
+#include <nix/hdf5/ParallelReader.hpp>
+#include <nix/hdf5/Overview.hpp>
+#include <nix/hdf5/Filters.hpp>
+#include <nix/hdf5/FileState.hpp>
+
+#include <map>
+#include <mutex>
 
 using namespace std;
 using namespace nix::base;
@@ -18,6 +26,54 @@ using namespace nix::base;
 namespace nix {
 namespace hdf5 {
 
+namespace {
+
+// the extents reported by dataExtent(), keyed by the address of the group
+// of the data array, so that all handles of an array see every change
+struct extent_cache {
+    std::mutex lock;
+    std::map<haddr_t, NDSize> entries;
+};
+
+
+bool find_extent(const Group &group, NDSize &extent) {
+    ObjectAddress address = group.address();
+    std::shared_ptr<extent_cache> cache = FileState::find<extent_cache>(address.first);
+    if (!cache) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(cache->lock);
+    auto it = cache->entries.find(address.second);
+    if (it == cache->entries.end()) {
+        return false;
+    }
+
+    extent = it->second;
+    return true;
+}
+
+
+void store_extent(const Group &group, const NDSize &extent) {
+    ObjectAddress address = group.address();
+    std::shared_ptr<extent_cache> cache = FileState::get<extent_cache>(address.first);
+
+    std::lock_guard<std::mutex> guard(cache->lock);
+    cache->entries[address.second] = extent;
+}
+
+
+void drop_extent(const Group &group) {
+    ObjectAddress address = group.address();
+    std::shared_ptr<extent_cache> cache = FileState::find<extent_cache>(address.first);
+    if (cache) {
+        std::lock_guard<std::mutex> guard(cache->lock);
+        cache->entries.erase(address.second);
+    }
+}
+
+} // anonymous namespace
+
 
 DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const Group &group)
         : EntityWithSourcesHDF5(file, block, group) {
@@ -35,6 +91,8 @@ DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBl
                              const string &id, const string &type, const string &name, time_t time)
         : EntityWithSourcesHDF5(file, block, group, id, type, name, time) {
     dimension_group = this->group().openOptGroup("dimensions");
+    // the group might reuse the address of a deleted data array
+    drop_extent(this->group());
 }
 
 //--------------------------------------------------
@@ -261,13 +319,35 @@ DataArrayHDF5::~DataArrayHDF5() {
 }
 
 
-void DataArrayHDF5::createData(DataType dtype, const NDSize &size) {
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const ChunkingHint &hint,
+                               const Compression &compression) {
     if (group().hasData("data")) {
-        throw new std::runtime_error("DataArray alread exists"); //TODO: FIXME, better exception
+        throw runtime_error("Data field already exists in DataArray!");
     }
 
-    group().createData("data", dtype, size); //FIXME: check if this 2-step creation is needed
-    DataSet ds = group().openData("data");
+    checkData(dtype, size, hint, compression);
+    h5x::DataType fileType = data_type_to_h5_filetype(dtype);
+    drop_extent(group());
+
+    if (hint.contiguous) {
+        group().createData("data", fileType, size, size, {}, false, false);
+        return;
+    }
+
+    NDSize chunks = DataSet::planChunking(size, fileType.size(), hint);
+    group().createData("data", fileType, size, {}, chunks, true, true, compression);
+}
+
+void DataArrayHDF5::checkData(DataType dtype, const NDSize &size, const ChunkingHint &hint,
+                              const Compression &compression) {
+    if (hint.contiguous) {
+        if (hint.append_axis || compression.codec != Codec::None || compression.shuffle) {
+            throw std::invalid_argument("Contiguous data can neither grow nor be compressed");
+        }
+    } else {
+        DataSet::planChunking(size, data_type_to_h5_filetype(dtype).size(), hint);
+    }
+    checkFilters(compression);
 }
 
 bool DataArrayHDF5::hasData() const {
@@ -280,10 +360,16 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     if (!group().hasData("data")) {
         //FIXME: this case should actually never be possible, replace with exception?
         ds = group().createData("data", dtype, count);
+        drop_extent(group());
     } else {
         ds = group().openData("data");
     }
 
+    std::shared_ptr<ChunkCache> cache = ChunkCache::find(ds);
+    if (cache) {
+        cache->invalidate(count, offset);
+    }
+
     if (offset.size()) {
         Selection fileSel = ds.createSelection();
         fileSel.select(count, offset);
@@ -293,6 +379,8 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     } else {
         ds.write(dtype, count, data);
     }
+
+    updateOverview(count, offset);
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
@@ -300,13 +388,30 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
         return;
     }
 
+    checkBounds(count, offset);
     DataSet ds = group().openData("data");
+    NDSize start = offset.size() ? offset : NDSize(count.size(), 0);
 
-    if (offset.size()) {
+    std::shared_ptr<ChunkCache> cache = ChunkCache::find(ds);
+    if (cache && cache->read(ds, dataExtent(), dtype, data, count, start)) {
+        return;
+    }
+
+    size_t threads = file()->readThreads();
+    if (threads > 1) {
+        ParallelReader reader(ds, threads);
+        if (reader.read(dtype, data, count, start)) {
+            return;
+        }
+    }
+
+    // the whole data is selected from the origin as well: the data set can
+    // be larger than its logical extent while an appender grows it
+    if (start.size()) {
         Selection fileSel = ds.createSelection();
         // if count.size() == 0, i.e. we want to read a scalar,
         // we have to supply something that fileSel can make sense of
-        fileSel.select(count ? count : NDSize(offset.size(), 1), offset);
+        fileSel.select(count ? count : NDSize(start.size(), 1), start);
         Selection memSel(DataSpace::create(count, false));
 
         ds.read(dtype, data, fileSel, memSel);
@@ -316,13 +421,91 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
 
 }
 
+void DataArrayHDF5::read(DataType dtype, void *data, const DataSelection &selection) const {
+    if (!group().hasData("data") || selection.empty()) {
+        return;
+    }
+
+    DataSet ds = group().openData("data");
+
+    Selection fileSel = ds.createSelection();
+    fileSel.select(selection);
+
+    if (!fileSel.isValid()) {
+        throw OutOfBounds("DataArray: selection is outside of the data");
+    }
+
+    const ndsize_t n = fileSel.npoints();
+    if (n != selection.nelms()) {
+        throw std::invalid_argument("DataArray: hyperslabs of a selection must not overlap");
+    }
+
+    Selection memSel(DataSpace::create(NDSize({n}), false));
+    ds.read(dtype, data, fileSel, memSel);
+}
+
+void DataArrayHDF5::write(const StringColumn &data, const NDSize &count, const NDSize &offset) {
+    DataSet ds;
+
+    if (!group().hasData("data")) {
+        ds = group().createData("data", DataType::String, count);
+        drop_extent(group());
+    } else {
+        ds = group().openData("data");
+    }
+
+    if (offset.size()) {
+        Selection fileSel = ds.createSelection();
+        fileSel.select(count, offset);
+        Selection memSel(DataSpace::create(count, false));
+
+        ds.write(data, fileSel, memSel);
+    } else {
+        ds.write(data);
+    }
+}
+
+void DataArrayHDF5::read(StringColumn &data, const NDSize &count, const NDSize &offset) const {
+    if (!group().hasData("data")) {
+        data.clear();
+        return;
+    }
+
+    checkBounds(count, offset);
+    DataSet ds = group().openData("data");
+    NDSize start = offset.size() ? offset : NDSize(count.size(), 0);
+
+    if (start.size()) {
+        Selection fileSel = ds.createSelection();
+        fileSel.select(count ? count : NDSize(start.size(), 1), start);
+        Selection memSel(DataSpace::create(count, false));
+
+        ds.read(data, fileSel, memSel);
+    } else {
+        ds.read(data);
+    }
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
+    NDSize extent;
+    if (find_extent(group(), extent)) {
+        return extent;
+    }
+
     if (!group().hasData("data")) {
         return NDSize{};
     }
 
-    DataSet ds = group().openData("data");
-    return ds.size();
+    std::vector<uint64_t> logical;
+    if (group().getAttr("logical_extent", logical)) {
+        extent = NDSize(logical.size());
+        std::copy(logical.begin(), logical.end(), extent.begin());
+    } else {
+        extent = group().openData("data").size();
+    }
+
+    store_extent(group(), extent);
+    return extent;
 }
 
 void DataArrayHDF5::dataExtent(const NDSize &extent) {
@@ -331,7 +514,50 @@ void DataArrayHDF5::dataExtent(const NDSize &extent) {
     }
 
     DataSet ds = group().openData("data");
+
+    std::shared_ptr<ChunkCache> cache = ChunkCache::find(ds);
+    if (cache) {
+        cache->clear();
+    }
+
     ds.setExtent(extent);
+    logicalExtent(none);
+}
+
+
+void DataArrayHDF5::logicalExtent(const NDSize &extent) {
+    std::vector<uint64_t> logical(extent.begin(), extent.end());
+    group().setAttr("logical_extent", logical);
+    store_extent(group(), extent);
+    updateOverview(NDSize{}, NDSize{});
+}
+
+
+void DataArrayHDF5::logicalExtent(const none_t t) {
+    if (group().hasAttr("logical_extent")) {
+        group().removeAttr("logical_extent");
+    }
+    drop_extent(group());
+    updateOverview(NDSize{}, NDSize{});
+}
+
+
+void DataArrayHDF5::checkBounds(const NDSize &count, const NDSize &offset) const {
+    NDSize extent = dataExtent();
+    NDSize start = offset.size() ? offset : NDSize(count.size(), 0);
+    // a scalar is read if count is empty
+    NDSize shape = count.size() ? count : NDSize(start.size(), 1);
+
+    // mismatching ranks are left to hdf5 to report
+    if (start.size() != extent.size() || shape.size() != extent.size()) {
+        return;
+    }
+
+    for (size_t d = 0; d < extent.size(); d++) {
+        if (start[d] + shape[d] > extent[d]) {
+            throw OutOfBounds("DataArray: read outside of the data extent");
+        }
+    }
 }
 
 DataType DataArrayHDF5::dataType(void) const {
@@ -343,5 +569,116 @@ DataType DataArrayHDF5::dataType(void) const {
     return ds.dataType();
 }
 
+
+void DataArrayHDF5::chunkCache(size_t capacity, size_t read_ahead) {
+    if (!group().hasData("data")) {
+        throw runtime_error("Data field not found in DataArray!");
+    }
+
+    ChunkCache::enable(group().openData("data"), capacity, read_ahead);
+}
+
+
+void DataArrayHDF5::chunkCache(const none_t t) {
+    if (group().hasData("data")) {
+        ChunkCache::disable(group().openData("data"));
+    }
+}
+
+
+ChunkCacheStats DataArrayHDF5::chunkCacheStats() const {
+    std::shared_ptr<ChunkCache> cache;
+
+    if (group().hasData("data")) {
+        cache = ChunkCache::find(group().openData("data"));
+    }
+
+    return cache ? cache->stats() : ChunkCacheStats();
+}
+
+
+NDSize DataArrayHDF5::chunkShape() const {
+    if (!group().hasData("data")) {
+        return NDSize();
+    }
+
+    return group().openData("data").chunking();
+}
+
+
+bool DataArrayHDF5::dataLocation(std::string &path, ndsize_t &offset) const {
+    if (!group().hasData("data")) {
+        return false;
+    }
+
+    DataSet ds = group().openData("data");
+    haddr_t addr = ds.contiguousOffset();
+
+    if (addr == HADDR_UNDEF) {
+        return false;
+    }
+
+    path = file()->location();
+    offset = addr;
+    return true;
+}
+
+
+void DataArrayHDF5::overview(size_t bin_size, size_t axis) {
+    if (!group().hasData("data")) {
+        throw runtime_error("Data field not found in DataArray!");
+    }
+
+    DataSet ds = group().openData("data");
+    DataType dtype = ds.dataType();
+    if (dtype == DataType::String || dtype == DataType::Opaque || dtype == DataType::Nothing) {
+        throw std::invalid_argument("Overviews are only supported for numeric data");
+    }
+
+    Overview::create(group(), ds, dataExtent(), axis, bin_size);
+}
+
+
+void DataArrayHDF5::overview(const none_t t) {
+    Overview::remove(group());
+}
+
+
+bool DataArrayHDF5::hasOverview() const {
+    return Overview::exists(group());
+}
+
+
+Envelope DataArrayHDF5::envelope(ndsize_t start, ndsize_t count, size_t points) const {
+    if (!group().hasData("data")) {
+        return Envelope();
+    }
+
+    DataSet ds = group().openData("data");
+    if (Overview::exists(group())) {
+        return Overview::open(group()).envelope(ds, dataExtent(), start, count, points);
+    }
+
+    return Overview::compute(ds, dataExtent(), 0, start, count, points);
+}
+
+
+void DataArrayHDF5::updateOverview(const NDSize &count, const NDSize &offset) {
+    if (!Overview::exists(group()) || !group().hasData("data")) {
+        return;
+    }
+
+    Overview overview = Overview::open(group());
+    NDSize extent = dataExtent();
+    ndsize_t begin = 0, end = 0;
+
+    if (count.size() == extent.size()) {
+        begin = offset.size() ? offset[overview.axis()] : 0;
+        end = begin + count[overview.axis()];
+    }
+
+    overview.update(group().openData("data"), extent, begin, end);
+}
+
 } // ns nix::hdf5
 } // ns nix
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 #include <nix/hdf5/DataSetHDF5.hpp>
 #include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+#include <nix/base/IDataArray.hpp>
 
 #include <iostream>
 #include <cmath>
@@ -42,12 +44,24 @@ DataSet::DataSet(const DataSet &other)
 
 void DataSet::read(hid_t memType, void *data) const
 {
+    IOProbe probe(hid, IOOperation::DataRead);
+    probe.transfer(memType, H5S_ALL);
     HErr res = H5Dread(hid, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
     res.check("DataSet::read() IO error");
 }
 
+void DataSet::read(hid_t memType, void *data, const VlenArena &arena) const
+{
+    IOProbe probe(hid, IOOperation::DataRead);
+    probe.transfer(memType, H5S_ALL);
+    HErr res = H5Dread(hid, memType, H5S_ALL, H5S_ALL, arena.xfer(), data);
+    res.check("DataSet::read() IO error");
+}
+
 void DataSet::write(hid_t memType, const void *data)
 {
+    IOProbe probe(hid, IOOperation::DataWrite);
+    probe.transfer(memType, H5S_ALL);
     HErr res = H5Dwrite(hid, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
     res.check("DataSet::write() IOError");
 }
@@ -57,10 +71,10 @@ void DataSet::read(DataType dtype, const NDSize &size, void *data) const
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
 
     if (dtype == DataType::String) {
+        VlenArena arena;
         StringWriter writer(size, static_cast<std::string *>(data));
-        read(memType.h5id(), *writer);
+        read(memType.h5id(), *writer, arena);
         writer.finish();
-        vlenReclaim(memType.h5id(), *writer);
     } else {
         read(memType.h5id(), data);
     }
@@ -85,19 +99,21 @@ void DataSet::read(DataType        dtype,
                    const Selection &memSel) const
 {
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    IOProbe probe(hid, IOOperation::DataRead);
+    probe.transfer(memType.h5id(), memSel.h5space().h5id());
 
     HErr res;
     if (dtype == DataType::String) {
         NDSize size = memSel.size();
+        VlenArena arena;
         StringWriter writer(size, static_cast<std::string *>(data));
-        res = H5Dread(hid, memType.h5id(), memSel.h5space().h5id(), fileSel.h5space().h5id(), H5P_DEFAULT, *writer);
+        res = H5Dread(hid, memType.h5id(), memSel.h5space().h5id(), fileSel.h5space().h5id(), arena.xfer(), *writer);
+        res.check("DataSet::read() IO error");
         writer.finish();
-        vlenReclaim(memType.h5id(), *writer);
     } else {
         res = H5Dread(hid, memType.h5id(), memSel.h5space().h5id(), fileSel.h5space().h5id(), H5P_DEFAULT, data);
+        res.check("DataSet::read() IO error");
     }
-
-    res.check("DataSet::read() IO error");
 }
 
 void DataSet::write(DataType         dtype,
@@ -106,6 +122,8 @@ void DataSet::write(DataType         dtype,
                     const Selection &memSel)
 {
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    IOProbe probe(hid, IOOperation::DataWrite);
+    probe.transfer(memType.h5id(), memSel.h5space().h5id());
     HErr res;
 
     if (dtype == DataType::String) {
@@ -119,10 +137,80 @@ void DataSet::write(DataType         dtype,
     res.check("DataSet::write(): IO error");
 }
 
+static void read_string_column(hid_t ds, hid_t memSpace, hid_t fileSpace, ndsize_t nelms, StringColumn &data)
+{
+    h5x::DataType memType = data_type_to_h5_memtype(DataType::String);
+    size_t n = nix::check::fits_in_size_t(nelms, "Cannot allocate storage (exceeds memory)");
+
+    VlenArena arena;
+    std::vector<char *> buffer(n);
+    IOProbe probe(ds, IOOperation::DataRead);
+    probe.bytes(n * sizeof(char *));
+    HErr res = H5Dread(ds, memType.h5id(), memSpace, fileSpace, arena.xfer(), buffer.data());
+    res.check("DataSet::read() IO error");
+
+    data.clear();
+    data.reserve(n, arena.used());
+    for (const char *str : buffer) {
+        data.push_back(str);
+    }
+}
+
+static void write_string_column(hid_t ds, hid_t memSpace, hid_t fileSpace, ndsize_t nelms, const StringColumn &data)
+{
+    if (nelms != data.size()) {
+        throw std::invalid_argument("DataSet::write(): number of strings does not match the selection");
+    }
+
+    h5x::DataType memType = data_type_to_h5_memtype(DataType::String);
+
+    std::vector<const char *> buffer(data.size());
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = data.c_str(i);
+    }
+
+    IOProbe probe(ds, IOOperation::DataWrite);
+    probe.bytes(buffer.size() * sizeof(const char *));
+    HErr res = H5Dwrite(ds, memType.h5id(), memSpace, fileSpace, H5P_DEFAULT, buffer.data());
+    res.check("DataSet::write(): IO error");
+}
+
+void DataSet::read(StringColumn &data) const
+{
+    read_string_column(hid, H5S_ALL, H5S_ALL, size().nelms(), data);
+}
+
+void DataSet::write(const StringColumn &data)
+{
+    write_string_column(hid, H5S_ALL, H5S_ALL, size().nelms(), data);
+}
+
+void DataSet::read(StringColumn &data, const Selection &fileSel, const Selection &memSel) const
+{
+    read_string_column(hid, memSel.h5space().h5id(), fileSel.h5space().h5id(), memSel.size().nelms(), data);
+}
+
+void DataSet::write(const StringColumn &data, const Selection &fileSel, const Selection &memSel)
+{
+    write_string_column(hid, memSel.h5space().h5id(), fileSel.h5space().h5id(), memSel.size().nelms(), data);
+}
+
 #define CHUNK_BASE   16*1024
 #define CHUNK_MIN     8*1024
 #define CHUNK_MAX  1024*1024
 
+static double chunk_target_size(const NDSize &dims, size_t element_size) {
+    double product = static_cast<double>(dims.nelms() * element_size);
+    double target_size = CHUNK_BASE * pow(2, log10(product/(1024.0 * 1024.0)));
+
+    if (target_size > CHUNK_MAX)
+        target_size = CHUNK_MAX;
+    else if (target_size < CHUNK_MIN)
+        target_size = CHUNK_MIN;
+
+    return target_size;
+}
+
 /**
  * Infer the chunk size from the supplied size information
  *
@@ -164,21 +252,13 @@ NDSize DataSet::guessChunking(NDSize chunks, size_t element_size)
         throw InvalidRank("Cannot guess chunks for 0-dimensional data");
     }
 
-    double product = 1;
     std::for_each(chunks.begin(), chunks.end(), [&](hsize_t &val) {
         //todo: check for +infinity
         if (val == 0)
             val = 1024;
-
-        product *= val;
     });
 
-    product *= element_size;
-    double target_size = CHUNK_BASE * pow(2, log10(product/(1024.0 * 1024.0)));
-    if (target_size > CHUNK_MAX)
-        target_size = CHUNK_MAX;
-    else if (target_size < CHUNK_MIN)
-        target_size = CHUNK_MIN;
+    double target_size = chunk_target_size(chunks, element_size);
 
     size_t i = 0;
     while (true) {
@@ -203,6 +283,167 @@ NDSize DataSet::guessChunking(NDSize chunks, size_t element_size)
     return chunks;
 }
 
+/**
+ * Plan the chunk layout for data with a known access pattern
+ *
+ * @param dims          Size information to base the planning on
+ * @param element_size  The size of a single element in bytes
+ * @param hint          The expected access pattern
+ *
+ * Dimensions covered by the read shape of the hint are kept at the read
+ * shape (or below) so a typical read touches as few chunks as possible.
+ * When the chunk is larger than the target size it is first shrunk along
+ * the append axis, then along the dimensions without a read shape and
+ * only then along the read shape; each step halves the largest of these
+ * dimensions. A chunk that is smaller than the target is grown along the
+ * append axis, since the extent in that direction is not yet known.
+ *
+ * Without any hint this is the same as guessChunking().
+ *
+ * @return The chunk size
+ */
+NDSize DataSet::planChunking(NDSize dims, size_t element_size, const ChunkingHint &hint)
+{
+    const size_t rank = dims.size();
+
+    if (rank == 0) {
+        throw InvalidRank("Cannot plan chunks for 0-dimensional data");
+    }
+
+    if (hint.read_shape && hint.read_shape.size() != rank) {
+        throw InvalidRank("Read shape of the chunking hint must match the rank of the data");
+    }
+
+    if (hint.append_axis && *hint.append_axis >= rank) {
+        throw OutOfBounds("Append axis of the chunking hint is out of bounds", *hint.append_axis);
+    }
+
+    if (!hint.append_axis && !hint.read_shape && hint.target_bytes == 0) {
+        return guessChunking(dims, element_size);
+    }
+
+    NDSize chunks(dims);
+    std::vector<int> priority(rank, 1);
+
+    for (size_t d = 0; d < rank; d++) {
+        if (chunks[d] == 0) {
+            chunks[d] = 1024;
+        }
+
+        if (hint.read_shape && hint.read_shape[d] > 0) {
+            chunks[d] = hint.append_axis && *hint.append_axis == d ?
+                        hint.read_shape[d] : std::min(chunks[d], hint.read_shape[d]);
+            priority[d] = 2;
+        }
+    }
+
+    if (hint.append_axis) {
+        priority[*hint.append_axis] = 0;
+    }
+
+    const double target_size = hint.target_bytes > 0 ?
+                               static_cast<double>(hint.target_bytes) : chunk_target_size(chunks, element_size);
+
+    while (static_cast<double>(chunks.nelms() * element_size) > target_size) {
+        size_t idx = rank;
+        for (size_t d = 0; d < rank; d++) {
+            if (chunks[d] > 1 && (idx == rank || priority[d] < priority[idx] ||
+                                  (priority[d] == priority[idx] && chunks[d] > chunks[idx]))) {
+                idx = d;
+            }
+        }
+
+        if (idx == rank) {
+            break;
+        }
+
+        chunks[idx] = (chunks[idx] + 1) / 2;
+    }
+
+    if (hint.append_axis) {
+        size_t axis = *hint.append_axis;
+        while (static_cast<double>(chunks.nelms() * element_size * 2) <= target_size) {
+            chunks[axis] *= 2;
+        }
+    }
+
+    return chunks;
+}
+
+NDSize DataSet::chunking() const
+{
+    BaseHDF5 dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunking(): Could not get data set creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize();
+    }
+
+    int rank = H5Pget_chunk(dcpl.h5id(), 0, nullptr);
+    NDSize dims(static_cast<size_t>(std::max(rank, 0)));
+    HErr res = H5Pget_chunk(dcpl.h5id(), rank, dims.data());
+    res.check("DataSet::chunking(): Could not get chunk dimensions");
+    return dims;
+}
+
+haddr_t DataSet::contiguousOffset() const
+{
+    BaseHDF5 dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::contiguousOffset(): Could not get data set creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CONTIGUOUS || H5Pget_external_count(dcpl.h5id()) != 0) {
+        return HADDR_UNDEF;
+    }
+
+    // the bytes in the file must be what a read would return
+    DataType dtype = dataType();
+    if (dtype == DataType::String || dtype == DataType::Opaque || dtype == DataType::Nothing) {
+        return HADDR_UNDEF;
+    }
+
+    h5x::DataType fileType = H5Dget_type(hid);
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    if (H5Tequal(fileType.h5id(), memType.h5id()) <= 0) {
+        return HADDR_UNDEF;
+    }
+
+    // only the default driver stores the data at its address in the file
+    BaseHDF5 file = H5Iget_file_id(hid);
+    BaseHDF5 fapl = H5Fget_access_plist(file.h5id());
+    fapl.check("DataSet::contiguousOffset(): Could not get file access plist");
+    if (H5Pget_driver(fapl.h5id()) != H5FD_SEC2) {
+        return HADDR_UNDEF;
+    }
+
+    unsigned intent = 0;
+    HErr res = H5Fget_intent(file.h5id(), &intent);
+    res.check("DataSet::contiguousOffset(): Could not get file intent");
+
+    // pending writes of the data set must be on disk, the rest of the file does not matter
+    if (intent & H5F_ACC_RDWR) {
+#if H5_VERSION_GE(1, 10, 0)
+        res = H5Dflush(hid);
+#else
+        res = H5Fflush(hid, H5F_SCOPE_LOCAL);
+#endif
+        res.check("DataSet::contiguousOffset(): Could not flush data set");
+    }
+
+    haddr_t offset = H5Dget_offset(hid);
+    if (offset == HADDR_UNDEF) {
+        return offset;   // not written yet
+    }
+
+    // addresses are relative to the end of the user block
+    BaseHDF5 fcpl = H5Fget_create_plist(file.h5id());
+    fcpl.check("DataSet::contiguousOffset(): Could not get file creation plist");
+    hsize_t userblock = 0;
+    res = H5Pget_userblock(fcpl.h5id(), &userblock);
+    res.check("DataSet::contiguousOffset(): Could not get user block size");
+
+    return offset + userblock;
+}
+
 void DataSet::setExtent(const NDSize &dims)
 {
     DataSpace space = getSpace();
@@ -432,7 +673,9 @@ void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
     fileValues.resize(size);
     values.resize(size);
 
-    h5ds.read(memType.h5id(), fileValues.data());
+    // the strings of the values are copied into Value objects below
+    VlenArena arena;
+    h5ds.read(memType.h5id(), fileValues.data(), arena);
 
     std::transform(fileValues.begin(), fileValues.end(), values.begin(), [](const file_value_t &val) {
             Value temp(val.val());
@@ -443,8 +686,6 @@ void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
             temp.checksum = val.checksum;
             return temp;
         });
-
-    h5ds.vlenReclaim(memType, fileValues.data());
 }
 
 void DataSet::read(std::vector<Value> &values) const
@@ -349,20 +349,84 @@ void RangeDimensionHDF5::unit(const none_t t) {
 }
 
 
-vector<double> RangeDimensionHDF5::ticks() const {
-    vector<double> ticks;
+const size_t RangeDimensionHDF5::MAX_CACHED_TICKS = 1 << 20;
 
-    if (group.hasData("ticks")) {
-        group.getData("ticks", ticks);
-        return ticks;
-    } else {
+
+shared_ptr<const vector<double>> RangeDimensionHDF5::loadTicks() const {
+    if (cached_ticks) {
+        return cached_ticks;
+    }
+
+    if (!group.hasData("ticks")) {
         throw MissingAttr("ticks");
     }
+
+    DataSet ds = group.openData("ticks");
+    if (ds.size().nelms() <= MAX_CACHED_TICKS) {
+        shared_ptr<vector<double>> ticks = make_shared<vector<double>>();
+        ds.read(*ticks, true);
+        cached_ticks = ticks;
+    }
+
+    return cached_ticks;
+}
+
+
+vector<double> RangeDimensionHDF5::ticks() const {
+    shared_ptr<const vector<double>> cached = loadTicks();
+    if (cached) {
+        return *cached;
+    }
+
+    vector<double> ticks;
+    group.getData("ticks", ticks);
+    return ticks;
 }
 
 
 void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
     group.setData("ticks", ticks);
+
+    if (ticks.size() <= MAX_CACHED_TICKS) {
+        cached_ticks = make_shared<const vector<double>>(ticks);
+    } else {
+        cached_ticks.reset();
+    }
+}
+
+
+vector<double> RangeDimensionHDF5::ticks(ndsize_t start, size_t count) const {
+    shared_ptr<const vector<double>> cached = loadTicks();
+    ndsize_t size = cached ? cached->size() : group.openData("ticks").size().nelms();
+
+    if (start + count > size) {
+        throw OutOfBounds("RangeDimensionHDF5::ticks: range is out of bounds of the ticks");
+    }
+
+    if (cached) {
+        auto first = cached->begin() + static_cast<ptrdiff_t>(start);
+        return vector<double>(first, first + count);
+    }
+
+    vector<double> ticks(count);
+    if (count > 0) {
+        DataSet ds = group.openData("ticks");
+        Selection sel = ds.createSelection();
+        sel.select(NDSize({static_cast<ndsize_t>(count)}), NDSize({start}));
+        ds.read(ticks, sel);
+    }
+
+    return ticks;
+}
+
+
+ndsize_t RangeDimensionHDF5::tickCount() const {
+    shared_ptr<const vector<double>> cached = loadTicks();
+    if (cached) {
+        return cached->size();
+    }
+
+    return group.openData("ticks").size().nelms();
 }
 
 RangeDimensionHDF5::~RangeDimensionHDF5() {}
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/hdf5/EntityHDF5.hpp>
+#include <nix/hdf5/UpdateLog.hpp>
 
 #include <nix/util/util.hpp>
 
@@ -22,72 +23,74 @@ namespace hdf5 {
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const Group &group)
     : entity_file(file), entity_group(group)
 {
-    setUpdatedAt();
-    setCreatedAt();
 }
 
 
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const Group &group, const string &id, time_t time)
     : entity_file(file), entity_group(group)
 {
-    group.setAttr("entity_id", id);
-    setUpdatedAt();
+    attributes().set(group, "entity_id", id);
     forceCreatedAt(time);
+    UpdateLog::markUpdated(group, util::getTime());
 }
 
 
 string EntityHDF5::id() const {
     string t;
-    
-    if (group().hasAttr("entity_id")) {
-        group().getAttr("entity_id", t);
-    }
-    else {
+
+    if (!attributes().get(group(), "entity_id", t)) {
         throw runtime_error("Entity has no id!");
     }
-    
+
     return t;
 }
 
 
 time_t EntityHDF5::updatedAt() const {
+    time_t pending;
+    if (UpdateLog::pending(group(), pending)) {
+        return pending;
+    }
+
     string t;
-    group().getAttr("updated_at", t);
+    if (!attributes().get(group(), "updated_at", t)) {
+        // written by a version that stamped entities on open only
+        attributes().get(group(), "created_at", t);
+    }
     return util::strToTime(t);
 }
 
 
 void EntityHDF5::setUpdatedAt() {
-    if (!group().hasAttr("updated_at")) {
-        time_t t = util::getTime();
-        group().setAttr("updated_at", util::timeToStr(t));
+    time_t t;
+    if (!UpdateLog::pending(group(), t) && !attributes().has(group(), "updated_at")) {
+        UpdateLog::markUpdated(group(), util::getTime());
     }
 }
 
 
 void EntityHDF5::forceUpdatedAt() {
-    time_t t = util::getTime();
-    group().setAttr("updated_at", util::timeToStr(t));
+    UpdateLog::markUpdated(group(), util::getTime());
 }
 
 
 time_t EntityHDF5::createdAt() const {
     string t;
-    group().getAttr("created_at", t);
+    attributes().get(group(), "created_at", t);
     return util::strToTime(t);
 }
 
 
 void EntityHDF5::setCreatedAt() {
-    if (!group().hasAttr("created_at")) {
+    if (!attributes().has(group(), "created_at")) {
         time_t t = util::getTime();
-        group().setAttr("created_at", util::timeToStr(t));
+        attributes().set(group(), "created_at", util::timeToStr(t));
     }
 }
 
 
 void EntityHDF5::forceCreatedAt(time_t t) {
-    group().setAttr("created_at", util::timeToStr(t));
+    attributes().set(group(), "created_at", util::timeToStr(t));
 }
 
 
@@ -101,6 +104,14 @@ std::shared_ptr<base::IFile> EntityHDF5::file() const {
 }
 
 
+AttributeCache &EntityHDF5::attributes() const {
+    if (!attr_cache) {
+        attr_cache = AttributeCache::forObject(entity_group);
+    }
+    return *attr_cache;
+}
+
+
 bool EntityHDF5::operator==(const EntityHDF5 &other) const {
     return group() == other.group() && id() == other.id();
 }
@@ -0,0 +1,383 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/EntityIndex.hpp>
+
+#include <nix/util/util.hpp>
+#include <nix/StringColumn.hpp>
+#include <nix/hdf5/DataSetHDF5.hpp>
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// version of the layout of the index data sets
+const int INDEX_VERSION = 1;
+
+struct IndexCache {
+    std::unordered_map<std::string, std::string> names;
+    std::string path;        // path of the container when the cache was created
+    bool loaded = false;     // the index stored in the file was read, if there is one
+    bool complete = false;
+    bool dirty = false;      // differs from the index stored in the file
+    ndsize_t links = 0;
+    int64_t order = 0;
+};
+
+// part of the file state; containers are identified by their address,
+// since the same container can be opened via different handles and paths
+struct index_caches {
+    std::mutex lock;
+    std::map<haddr_t, IndexCache> entries;
+};
+
+
+IndexCache &cache_for(index_caches &caches, const Group &container, haddr_t address) {
+    auto it = caches.entries.find(address);
+    if (it == caches.entries.end()) {
+        it = caches.entries.emplace(address, IndexCache()).first;
+        it->second.path = container.name();
+    }
+
+    return it->second;
+}
+
+
+LocID open_object(const LocID &loc, const std::string &name) {
+    IOProbe probe(loc.h5id(), IOOperation::ObjectOpen);
+    return LocID(H5Oopen(loc.h5id(), name.c_str(), H5P_DEFAULT));
+}
+
+
+bool entity_id_matches(const Group &container, const std::string &name, const std::string &id) {
+    if (!container.hasObject(name)) {
+        return false;
+    }
+
+    LocID obj = open_object(container, name);
+    std::string obj_id;
+    return obj.isValid() && obj.getAttr("entity_id", obj_id) && obj_id == id;
+}
+
+
+// the number of links in the container and its highest link creation order;
+// adding a link raises the latter, removing one lowers the former
+void link_state(const Group &container, ndsize_t &links, int64_t &order) {
+    H5G_info_t info;
+    HErr res = H5Gget_info(container.h5id(), &info);
+    res.check("EntityIndex: Could not get group info");
+    links = info.nlinks;
+    order = info.max_corder;
+}
+
+
+bool up_to_date(const IndexCache &cache, const Group &container) {
+    ndsize_t links;
+    int64_t order;
+    link_state(container, links, order);
+    return cache.complete && cache.links == links && cache.order == order;
+}
+
+
+// the parent group of the container, which holds the stored index
+Group index_parent(const Group &container, const std::string &path) {
+    size_t pos = path.rfind('/');
+    std::string parent = pos == 0 ? "/" : path.substr(0, pos);
+    return Group(H5Gopen2(container.h5id(), parent.c_str(), H5P_DEFAULT));
+}
+
+
+std::string index_name(const std::string &path) {
+    return path.substr(path.rfind('/') + 1) + "_index";
+}
+
+
+/*
+ * Fills the cache from the index stored in the file, if the container did
+ * not change since the index was written. The container may already hold
+ * the links of entities that are being added.
+ */
+void load(IndexCache &cache, const Group &container, ndsize_t added) {
+    cache.loaded = true;
+
+    if (cache.path.empty() || cache.path == "/") {
+        return;
+    }
+
+    Group parent = index_parent(container, cache.path);
+    std::string name = index_name(cache.path);
+    if (!parent.isValid() || !parent.hasData(name)) {
+        return;
+    }
+
+    DataSet index = parent.openData(name);
+    int version = 0;
+    uint64_t stored_links = 0;
+    int64_t stored_order = 0;
+    if (!index.getAttr("index_version", version) || version != INDEX_VERSION ||
+        !index.getAttr("link_count", stored_links) || !index.getAttr("link_order", stored_order)) {
+        return;
+    }
+
+    ndsize_t links;
+    int64_t order;
+    link_state(container, links, order);
+    // containers that do not track the creation order always report 0
+    bool same_order = order == stored_order + static_cast<int64_t>(added) || (order == 0 && stored_order == 0);
+    if (links != stored_links + added || !same_order) {
+        return;
+    }
+
+    NDSize shape = index.size();
+    if (shape.size() != 2 || shape[1] != 2) {
+        return;
+    }
+
+    StringColumn column;
+    index.read(column);
+
+    cache.names.clear();
+    for (size_t i = 0; i + 1 < column.size(); i += 2) {
+        cache.names[column[i]] = column[i + 1];
+    }
+
+    cache.links = stored_links;
+    cache.order = stored_order;
+    cache.complete = true;
+}
+
+
+void store(const IndexCache &cache, const Group &container) {
+    Group parent = index_parent(container, cache.path);
+    std::string name = index_name(cache.path);
+
+    StringColumn column;
+    for (const auto &entry : cache.names) {
+        column.push_back(entry.first);
+        column.push_back(entry.second);
+    }
+
+    NDSize shape(2, 2);
+    shape[0] = cache.names.size();
+    DataSet index;
+    if (parent.hasData(name)) {
+        index = parent.openData(name);
+        index.setExtent(shape);
+    } else {
+        index = parent.createData(name, DataType::String, shape);
+    }
+
+    if (!column.empty()) {
+        index.write(column);
+    }
+
+    index.setAttr("index_version", INDEX_VERSION);
+    index.setAttr("link_count", static_cast<uint64_t>(cache.links));
+    index.setAttr("link_order", cache.order);
+}
+
+
+void rebuild(IndexCache &cache, const Group &container) {
+    link_state(container, cache.links, cache.order);
+
+    cache.names.clear();
+    container.visitLinks([&](const Link &link) {
+        LocID obj = open_object(container, link.name);
+        std::string id;
+
+        if (obj.isValid() && obj.getAttr("entity_id", id)) {
+            cache.names[id] = link.name;
+        }
+
+        return true;
+    });
+
+    cache.complete = true;
+    cache.dirty = true;
+}
+
+
+boost::optional<std::string> find_name(IndexCache &cache, const Group &container, const std::string &id) {
+    if (!cache.loaded) {
+        load(cache, container, 0);
+    }
+
+    auto it = cache.names.find(id);
+    if (it != cache.names.end()) {
+        if (entity_id_matches(container, it->second, id)) {
+            return it->second;
+        }
+        // stale entry, e.g. the entity got removed by another writer
+        cache.names.erase(it);
+        cache.complete = false;
+    }
+
+    if (up_to_date(cache, container)) {
+        return boost::none;
+    }
+
+    rebuild(cache, container);
+
+    it = cache.names.find(id);
+    if (it != cache.names.end()) {
+        return it->second;
+    }
+
+    return boost::none;
+}
+
+} // anonymous namespace
+
+
+boost::optional<std::string> EntityIndex::lookup(const Group &container, const std::string &id) const {
+    ObjectAddress address = container.address();
+    std::shared_ptr<index_caches> caches = FileState::get<index_caches>(address.first);
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    return find_name(cache_for(*caches, container, address.second), container, id);
+}
+
+
+boost::optional<Group> EntityIndex::findGroupByNameOrId(const Group &container, const std::string &name_or_id) const {
+    if (container.hasObject(name_or_id)) {
+        return boost::make_optional(container.openGroup(name_or_id, false));
+    } else if (util::looksLikeUUID(name_or_id)) {
+        boost::optional<std::string> name = lookup(container, name_or_id);
+        if (name && container.hasGroup(*name)) {
+            return boost::make_optional(container.openGroup(*name, false));
+        }
+    }
+
+    return boost::optional<Group>();
+}
+
+
+boost::optional<DataSet> EntityIndex::findDataByNameOrId(const Group &container, const std::string &name_or_id) const {
+    if (container.hasObject(name_or_id)) {
+        return boost::make_optional(container.openData(name_or_id));
+    } else if (util::looksLikeUUID(name_or_id)) {
+        boost::optional<std::string> name = lookup(container, name_or_id);
+        if (name && container.hasData(*name)) {
+            return boost::make_optional(container.openData(*name));
+        }
+    }
+
+    return boost::optional<DataSet>();
+}
+
+
+void EntityIndex::add(const Group &container, const std::string &id, const std::string &name) const {
+    ObjectAddress address = container.address();
+    std::shared_ptr<index_caches> caches = FileState::get<index_caches>(address.first);
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    IndexCache &cache = cache_for(*caches, container, address.second);
+
+    if (!cache.loaded) {
+        load(cache, container, 1);
+    }
+
+    ndsize_t links;
+    int64_t order;
+    link_state(container, links, order);
+
+    // the first entity of a container makes its index complete
+    if (!cache.complete && links == 1) {
+        cache.names.clear();
+        cache.complete = true;
+    }
+
+    cache.names[id] = name;
+    cache.links = links;
+    cache.order = order;
+    cache.dirty = true;
+}
+
+
+void EntityIndex::remove(const Group &container, const std::string &id, const std::string &name) const {
+    ObjectAddress address = container.address();
+    std::shared_ptr<index_caches> caches = FileState::get<index_caches>(address.first);
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    IndexCache &cache = cache_for(*caches, container, address.second);
+    std::string prefix = cache.path + "/" + name + "/";
+
+    if (!cache.loaded) {
+        load(cache, container, 0);
+    }
+
+    if (cache.names.erase(id) > 0 && cache.complete) {
+        cache.links--;
+    }
+    cache.dirty = true;
+
+    // containers nested in the removed entity go away with it, together
+    // with their stored indexes, and their addresses might get reused
+    for (auto jt = caches->entries.begin(); jt != caches->entries.end(); ) {
+        if (jt->second.path.compare(0, prefix.size(), prefix) == 0) {
+            jt = caches->entries.erase(jt);
+        } else {
+            ++jt;
+        }
+    }
+}
+
+
+void EntityIndex::flush(const LocID &file) {
+    hid_t fid = H5Iget_file_id(file.h5id());
+    unsigned intent = 0;
+    HErr res;
+    if (fid >= 0) {
+        res = H5Fget_intent(fid, &intent);
+        H5Idec_ref(fid);
+    }
+    res.check("EntityIndex::flush(): Could not get file intent");
+    if (!(intent & H5F_ACC_RDWR)) {
+        return;
+    }
+
+    std::shared_ptr<index_caches> caches = FileState::find<index_caches>(file);
+    if (!caches) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(caches->lock);
+    for (auto it = caches->entries.begin(); it != caches->entries.end(); ++it) {
+        IndexCache &cache = it->second;
+        if (!cache.dirty || cache.path.empty() || cache.path == "/") {
+            continue;
+        }
+
+        hid_t gid;
+        H5E_BEGIN_TRY {
+            gid = H5Gopen2(file.h5id(), cache.path.c_str(), H5P_DEFAULT);
+        } H5E_END_TRY;
+        if (gid < 0) {
+            continue;
+        }
+
+        // a container changed behind the back of the cache keeps its
+        // stored index, which no longer matches and gets rebuilt later
+        Group container(gid);
+        if (up_to_date(cache, container) && container.address().second == it->first) {
+            store(cache, container);
+        }
+        cache.dirty = false;
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
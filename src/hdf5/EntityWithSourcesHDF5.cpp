@@ -10,6 +10,9 @@
 
 #include <nix/util/util.hpp>
 #include <nix/Block.hpp>
+#include <nix/hdf5/BlockHDF5.hpp>
+#include <nix/hdf5/HandleCache.hpp>
+#include <nix/hdf5/SourceIndex.hpp>
 
 #include <algorithm>
 #include <functional>
@@ -81,6 +84,13 @@ shared_ptr<ISource> EntityWithSourcesHDF5::getSource(const size_t index) const {
     return getSource(id);
 }
 
+
+vector<shared_ptr<ISource>> EntityWithSourcesHDF5::sources() const {
+    return HandleCache::all<ISource, SourceHDF5>(sources_refs(), [this](const Group &grp) {
+        return make_shared<SourceHDF5>(file(), grp);
+    });
+}
+
 void EntityWithSourcesHDF5::sources(const std::vector<Source> &sources) {
     // extract vectors of ids from vectors of new & old sources
     std::vector<std::string> ids_new(sources.size());
@@ -102,10 +112,11 @@ void EntityWithSourcesHDF5::sources(const std::vector<Source> &sources) {
                         std::inserter(ids_rem, ids_rem.begin()));
     
     // check if all new sources exist
-    Block tmp(entity_block);
-    auto found = tmp.findSources(util::IdsFilter<Source>(ids_add));
-    if (ids_add.size() != found.size())
-        throw std::runtime_error("One or more sources do not exist in this block!");
+    auto blk = dynamic_pointer_cast<BlockHDF5>(entity_block);
+    for (const auto &id : ids_add) {
+        if (!blk->findSourceGroup(id))
+            throw std::runtime_error("One or more sources do not exist in this block!");
+    }
     // add sources
     for (auto id : ids_add) {
         addSource(id);
@@ -121,14 +132,14 @@ void EntityWithSourcesHDF5::addSource(const string &id) {
         throw EmptyString("addSource");
     boost::optional<Group> g = sources_refs(true);
 
-    Block tmp(entity_block);
-    auto found = tmp.findSources(util::IdFilter<Source>(id));
-    if (found.empty())
+    // a lookup in the block, the whole-file indexes stay untouched
+    auto blk = dynamic_pointer_cast<BlockHDF5>(entity_block);
+    boost::optional<Group> target = blk->findSourceGroup(id);
+    if (!target)
         throw std::runtime_error("EntityWithSourcesHDF5::addSource: Given source does not exist in this block!");
 
-    auto target = dynamic_pointer_cast<SourceHDF5>(found.front().impl());
-
-    g->createLink(target->group(), id);
+    g->createLink(*target, id);
+    SourceReferences::invalidate(*g);
 }
 
 
@@ -139,6 +150,7 @@ bool EntityWithSourcesHDF5::removeSource(const string &id) {
     if (g) {
         g->removeGroup(id);
         removed = true;
+        SourceReferences::invalidate(*g);
     }
 
     return removed;
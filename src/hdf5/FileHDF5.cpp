@@ -12,8 +12,16 @@
 #include <nix/hdf5/BlockHDF5.hpp>
 #include <nix/hdf5/SectionHDF5.hpp>
 #include <nix/hdf5/ExceptionHDF5.hpp>
-
+#include <nix/hdf5/ChunkCache.hpp>
+#include <nix/hdf5/Filters.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+#include <nix/hdf5/MetadataIndex.hpp>
+#include <nix/hdf5/SourceIndex.hpp>
+#include <nix/hdf5/UpdateLog.hpp>
+
+#include <algorithm>
 #include <fstream>
+#include <thread>
 #include <vector>
 #include <ctime>
 
@@ -47,7 +55,11 @@ static unsigned int map_file_mode(FileMode mode) {
 
 
 FileHDF5::FileHDF5(const string &name, FileMode mode)
+    : read_threads(1)
 {
+    // data compressed by our own filters must be readable right away
+    registerFilters();
+
     if (!fileExists(name)) {
         mode = FileMode::Overwrite;
     }
@@ -73,6 +85,7 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
 
     root = Group(H5Gopen2(hid, "/", H5P_DEFAULT));
     root.check("Could not root group");
+    state = FileState::open(root);
 
     metadata = root.openGroup("metadata");
     data = root.openGroup("data");
@@ -98,7 +111,7 @@ bool FileHDF5::hasBlock(const std::string &name_or_id) const {
 shared_ptr<base::IBlock> FileHDF5::getBlock(const std::string &name_or_id) const {
     shared_ptr<BlockHDF5> block;
 
-    boost::optional<Group> group = data.findGroupByNameOrAttribute("entity_id", name_or_id);
+    boost::optional<Group> group = block_index.findGroupByNameOrId(data, name_or_id);
     if (group)
         block = make_shared<BlockHDF5>(file(), *group);
 
@@ -112,6 +125,20 @@ shared_ptr<base::IBlock> FileHDF5::getBlock(size_t index) const {
 }
 
 
+vector<shared_ptr<base::IBlock>> FileHDF5::blocks() const {
+    vector<shared_ptr<base::IBlock>> blocks;
+
+    data.visitLinks([&](const Link &link) {
+        if (link.type == H5O_TYPE_GROUP) {
+            blocks.push_back(make_shared<BlockHDF5>(file(), data.openGroup(link.name, false)));
+        }
+        return true;
+    }, true);
+
+    return blocks;
+}
+
+
 shared_ptr<base::IBlock> FileHDF5::createBlock(const string &name, const string &type) {
     if (hasBlock(name)) {
         throw DuplicateName("createBlock");
@@ -119,7 +146,10 @@ shared_ptr<base::IBlock> FileHDF5::createBlock(const string &name, const string
     string id = util::createId();
 
     Group group = data.openGroup(name, true);
-    return make_shared<BlockHDF5>(file(), group, id, type, name);
+    auto block = make_shared<BlockHDF5>(file(), group, id, type, name);
+    block_index.add(data, id, name);
+
+    return block;
 }
 
 
@@ -127,8 +157,14 @@ bool FileHDF5::deleteBlock(const std::string &name_or_id) {
     bool deleted = false;
 
     if (hasBlock(name_or_id)) {
+        shared_ptr<base::IBlock> block = getBlock(name_or_id);
+        block_index.remove(data, block->id(), block->name());
+        // data sets of the block go away and their addresses might get reused
+        ChunkCache::clearCache(root);
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = data.removeAllLinks(getBlock(name_or_id)->name());
+        deleted = data.removeAllLinks(block->name());
+        SourceIndex::invalidate(root);
+        SourceReferences::invalidate(root);
     }
 
     return deleted;
@@ -153,7 +189,7 @@ bool FileHDF5::hasSection(const std::string &name_or_id) const {
 shared_ptr<base::ISection> FileHDF5::getSection(const std::string &name_or_id) const {
     shared_ptr<SectionHDF5> sec;
 
-    boost::optional<Group> group = metadata.findGroupByNameOrAttribute("entity_id", name_or_id);
+    boost::optional<Group> group = section_index.findGroupByNameOrId(metadata, name_or_id);
     if (group)
         sec = make_shared<SectionHDF5>(file(), *group);
 
@@ -167,6 +203,20 @@ shared_ptr<base::ISection> FileHDF5::getSection(size_t index) const{
 }
 
 
+vector<shared_ptr<base::ISection>> FileHDF5::sections() const {
+    vector<shared_ptr<base::ISection>> sections;
+
+    metadata.visitLinks([&](const Link &link) {
+        if (link.type == H5O_TYPE_GROUP) {
+            sections.push_back(make_shared<SectionHDF5>(file(), metadata.openGroup(link.name, false)));
+        }
+        return true;
+    }, true);
+
+    return sections;
+}
+
+
 shared_ptr<base::ISection> FileHDF5::createSection(const string &name, const  string &type) {
     if (hasSection(name)) {
         throw DuplicateName("createSection");
@@ -174,7 +224,11 @@ shared_ptr<base::ISection> FileHDF5::createSection(const string &name, const  st
     string id = util::createId();
 
     Group group = metadata.openGroup(name, true);
-    return make_shared<SectionHDF5>(file(), group, id, type, name);
+    auto section = make_shared<SectionHDF5>(file(), group, id, type, name);
+    section_index.add(metadata, id, name);
+    MetadataIndex::invalidate(root);
+
+    return section;
 }
 
 
@@ -190,7 +244,9 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
             section.deleteSection(child.id());
         }
         // if hasSection is true then section_group always exists
+        section_index.remove(metadata, section.id(), section.name());
         deleted = metadata.removeAllLinks(section.name());
+        MetadataIndex::invalidate(root);
     }
 
     return deleted;
@@ -279,11 +335,24 @@ string FileHDF5::location() const {
 }
 
 
+void FileHDF5::flush() {
+    UpdateLog::flush(root);
+    EntityIndex::flush(root);
+
+    HErr res = H5Fflush(hid, H5F_SCOPE_LOCAL);
+    res.check("FileHDF5::flush(): Could not flush file");
+}
+
+
 void FileHDF5::close() {
 
     if (!isOpen())
         return;
 
+    UpdateLog::flush(root);
+    EntityIndex::flush(root);
+    state.reset();
+
     data.close();
     metadata.close();
     root.close();
@@ -323,6 +392,45 @@ bool FileHDF5::isOpen() const {
 }
 
 
+void FileHDF5::readThreads(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    if (threads > 1) {
+        unsigned intent = 0;
+        HErr res = H5Fget_intent(hid, &intent);
+        res.check("FileHDF5::readThreads(): Could not get file intent");
+
+        if (intent & H5F_ACC_RDWR) {
+            throw std::runtime_error("Parallel reads are only supported for files opened read-only");
+        }
+    }
+
+    read_threads = threads;
+}
+
+
+size_t FileHDF5::readThreads() const {
+    return read_threads;
+}
+
+
+void FileHDF5::collectIOStats(bool enable) {
+    IOMonitor::enable(hid, enable);
+}
+
+
+IOStats FileHDF5::ioStats() const {
+    return IOMonitor::stats(hid);
+}
+
+
+void FileHDF5::resetIOStats() {
+    IOMonitor::reset(hid);
+}
+
+
 shared_ptr<base::IFile> FileHDF5::file() const {
     return  const_pointer_cast<FileHDF5>(shared_from_this());
 }
@@ -0,0 +1,66 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/FileState.hpp>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+std::mutex &registry_lock() {
+    static std::mutex lock;
+    return lock;
+}
+
+// only weak references, the states are owned by the files
+std::map<unsigned long, std::weak_ptr<FileState>> &registry() {
+    static std::map<unsigned long, std::weak_ptr<FileState>> registry;
+    return registry;
+}
+
+} // anonymous namespace
+
+
+std::shared_ptr<FileState> FileState::open(unsigned long fileno) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    auto &states = registry();
+
+    auto it = states.find(fileno);
+    if (it != states.end()) {
+        std::shared_ptr<FileState> state = it->second.lock();
+        if (state) {
+            return state;
+        }
+    }
+
+    // drop the entries of closed files
+    for (auto jt = states.begin(); jt != states.end(); ) {
+        if (jt->second.expired()) {
+            jt = states.erase(jt);
+        } else {
+            ++jt;
+        }
+    }
+
+    std::shared_ptr<FileState> state = std::make_shared<FileState>();
+    states[fileno] = state;
+    return state;
+}
+
+
+std::shared_ptr<FileState> FileState::lookup(unsigned long fileno) {
+    std::lock_guard<std::mutex> guard(registry_lock());
+    auto &states = registry();
+
+    auto it = states.find(fileno);
+    return it != states.end() ? it->second.lock() : std::shared_ptr<FileState>();
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,559 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/Filters.hpp>
+#include <nix/hdf5/ExceptionHDF5.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#ifdef NIX_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+//--------------------------------------------------
+// LZ4 block format
+//--------------------------------------------------
+
+const size_t LZ4_MIN_MATCH = 4;
+const size_t LZ4_LAST_LITERALS = 5;   // the last bytes of a block are always literals
+const size_t LZ4_MATCH_LIMIT = 12;    // the last match starts at least this far from the end
+const size_t LZ4_MAX_OFFSET = 65535;
+const int LZ4_HASH_BITS = 14;
+
+inline uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+inline uint32_t lz4_hash(uint32_t seq) {
+    return (seq * 2654435761U) >> (32 - LZ4_HASH_BITS);
+}
+
+
+inline void lz4_put_length(std::vector<uint8_t> &out, size_t len) {
+    while (len >= 255) {
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(len));
+}
+
+
+void lz4_put_sequence(std::vector<uint8_t> &out, const uint8_t *literals, size_t nlit,
+                      size_t offset, size_t match_len) {
+    const bool last = match_len == 0;
+    size_t ml = last ? 0 : match_len - LZ4_MIN_MATCH;
+
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(nlit, 15) << 4) | std::min<size_t>(ml, 15));
+    out.push_back(token);
+
+    if (nlit >= 15) {
+        lz4_put_length(out, nlit - 15);
+    }
+    out.insert(out.end(), literals, literals + nlit);
+
+    if (last) {
+        return;
+    }
+
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+
+    if (ml >= 15) {
+        lz4_put_length(out, ml - 15);
+    }
+}
+
+
+// greedy single pass compressor with a hash table of the last positions
+void lz4_compress(const uint8_t *src, size_t n, std::vector<uint8_t> &out) {
+    size_t anchor = 0;
+
+    if (n > LZ4_MATCH_LIMIT) {
+        std::vector<uint32_t> table(size_t(1) << LZ4_HASH_BITS, 0); // position + 1, 0 for empty
+        const size_t match_end = n - LZ4_LAST_LITERALS;
+        size_t ip = 0;
+
+        while (ip + LZ4_MATCH_LIMIT <= n) {
+            const uint32_t seq = read32(src + ip);
+            const uint32_t h = lz4_hash(seq);
+            const size_t candidate = table[h];
+            table[h] = static_cast<uint32_t>(ip + 1);
+
+            if (candidate == 0 || ip - (candidate - 1) > LZ4_MAX_OFFSET || read32(src + candidate - 1) != seq) {
+                ip++;
+                continue;
+            }
+
+            const size_t ref = candidate - 1;
+            size_t len = LZ4_MIN_MATCH;
+            while (ip + len < match_end && src[ref + len] == src[ip + len]) {
+                len++;
+            }
+
+            lz4_put_sequence(out, src + anchor, ip - anchor, ip - ref, len);
+            ip += len;
+            anchor = ip;
+        }
+    }
+
+    lz4_put_sequence(out, src + anchor, n - anchor, 0, 0);
+}
+
+
+bool lz4_read_length(const uint8_t *src, size_t n, size_t &ip, size_t &len) {
+    uint8_t b;
+    do {
+        if (ip >= n) {
+            return false;
+        }
+        b = src[ip++];
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+
+bool lz4_decompress(const uint8_t *src, size_t n, uint8_t *dst, size_t dst_len) {
+    size_t ip = 0, op = 0;
+
+    while (ip < n) {
+        const uint8_t token = src[ip++];
+
+        size_t nlit = token >> 4;
+        if (nlit == 15 && !lz4_read_length(src, n, ip, nlit)) {
+            return false;
+        }
+
+        if (nlit > n - ip || nlit > dst_len - op) {
+            return false;
+        }
+
+        std::memcpy(dst + op, src + ip, nlit);
+        ip += nlit;
+        op += nlit;
+
+        if (ip == n) {
+            break;
+        }
+
+        if (n - ip < 2) {
+            return false;
+        }
+
+        const size_t offset = src[ip] | (static_cast<size_t>(src[ip + 1]) << 8);
+        ip += 2;
+
+        size_t len = token & 0x0F;
+        if (len == 15 && !lz4_read_length(src, n, ip, len)) {
+            return false;
+        }
+        len += LZ4_MIN_MATCH;
+
+        if (offset == 0 || offset > op || len > dst_len - op) {
+            return false;
+        }
+
+        // matches may overlap their own output, copy byte-wise
+        const uint8_t *ref = dst + op - offset;
+        for (size_t i = 0; i < len; i++) {
+            dst[op + i] = ref[i];
+        }
+        op += len;
+    }
+
+    return op == dst_len;
+}
+
+//--------------------------------------------------
+// HDF5 filter
+//--------------------------------------------------
+
+// the chunk is split in blocks of at most this size
+const size_t LZ4_BLOCK_SIZE = size_t(1) << 30;
+
+// no lz4 sequence expands to more than this many bytes per input byte
+const size_t LZ4_MAX_RATIO = 255;
+
+inline void put_be(uint8_t *p, uint64_t v, size_t nbytes) {
+    for (size_t i = 0; i < nbytes; i++) {
+        p[i] = static_cast<uint8_t>(v >> (8 * (nbytes - i - 1)));
+    }
+}
+
+
+inline uint64_t get_be(const uint8_t *p, size_t nbytes) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < nbytes; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+
+// a chunk decodes to at most max_size bytes, larger sizes in the header are
+// refused before anything is allocated for them
+bool lz4_decode(const uint8_t *in, size_t nbytes, size_t max_size, std::vector<uint8_t> &out) {
+    if (nbytes < 12) {
+        return false;
+    }
+
+    const uint64_t orig_size = get_be(in, 8);
+    if (orig_size > max_size) {
+        return false;
+    }
+
+    uint64_t block_size = get_be(in + 8, 4);
+    if (block_size > orig_size) {
+        block_size = orig_size;
+    }
+
+    out.resize(static_cast<size_t>(orig_size));
+
+    size_t ip = 12;
+    uint64_t done = 0;
+    while (done < orig_size) {
+        const size_t this_block = static_cast<size_t>(std::min(block_size, orig_size - done));
+
+        if (nbytes - ip < 4) {
+            return false;
+        }
+        const size_t comp_size = static_cast<size_t>(get_be(in + ip, 4));
+        ip += 4;
+
+        if (comp_size > nbytes - ip) {
+            return false;
+        }
+
+        if (comp_size == this_block) {
+            std::memcpy(out.data() + done, in + ip, this_block);
+        } else if (!lz4_decompress(in + ip, comp_size, out.data() + done, this_block)) {
+            return false;
+        }
+
+        ip += comp_size;
+        done += this_block;
+    }
+
+    return true;
+}
+
+
+/*
+ * Stores the size of a chunk in bytes as the second client value, behind
+ * the block size of the HDF5 LZ4 filter plugin; it stays 0 for variable
+ * length data, whose size in the file is not known here.
+ */
+herr_t lz4_set_local(hid_t dcpl, hid_t type, hid_t space) {
+    hsize_t dims[H5S_MAX_RANK];
+    const int rank = H5Pget_chunk(dcpl, H5S_MAX_RANK, dims);
+    const size_t esize = H5Tget_size(type);
+    const htri_t vlen = H5Tdetect_class(type, H5T_VLEN);
+    const htri_t vstr = H5Tis_variable_str(type);
+    if (rank < 0 || esize == 0 || vlen < 0 || vstr < 0) {
+        return -1;
+    }
+
+    hsize_t chunk_bytes = esize;
+    for (int i = 0; i < rank; i++) {
+        chunk_bytes *= dims[i];
+    }
+
+    unsigned int flags = 0;
+    size_t cd_nelmts = 2;
+    unsigned int cd_values[2] = {0, 0};
+    if (H5Pget_filter_by_id2(dcpl, FILTER_LZ4, &flags, &cd_nelmts, cd_values, 0, nullptr, nullptr) < 0) {
+        return -1;
+    }
+
+    if (cd_nelmts == 0) {
+        cd_values[0] = 0;
+    }
+    cd_values[1] = vlen || vstr || chunk_bytes > UINT32_MAX ? 0 : static_cast<unsigned int>(chunk_bytes);
+
+    return H5Pmodify_filter(dcpl, FILTER_LZ4, flags, 2, cd_values);
+}
+
+
+/*
+ * Layout (as used by the HDF5 LZ4 filter plugin):
+ *   uint64 BE   size of the uncompressed data
+ *   uint32 BE   block size
+ *   per block:
+ *     uint32 BE compressed size of the block (== block size if stored raw)
+ *     data
+ *
+ * Exceptions must not unwind through the HDF5 library, any error is
+ * reported as a failure of the filter.
+ */
+size_t lz4_filter(unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[],
+                  size_t nbytes, size_t *buf_size, void **buf) try {
+    const uint8_t *in = static_cast<const uint8_t *>(*buf);
+    std::vector<uint8_t> out;
+
+    if (flags & H5Z_FLAG_REVERSE) {
+        // chunks written without their size are bounded by the lz4 format
+        size_t max_size = nbytes > SIZE_MAX / LZ4_MAX_RATIO ? SIZE_MAX : nbytes * LZ4_MAX_RATIO;
+        if (cd_nelmts >= 2 && cd_values[1] > 0) {
+            max_size = cd_values[1];
+        }
+
+        if (!lz4_decode(in, nbytes, max_size, out)) {
+            return 0;
+        }
+    } else {
+        const size_t block_size = std::min(nbytes, LZ4_BLOCK_SIZE);
+
+        out.resize(12);
+        put_be(out.data(), nbytes, 8);
+        put_be(out.data() + 8, block_size, 4);
+
+        std::vector<uint8_t> block;
+        for (size_t done = 0; done < nbytes; done += block_size) {
+            const size_t this_block = std::min(block_size, nbytes - done);
+
+            block.clear();
+            lz4_compress(in + done, this_block, block);
+
+            const size_t pos = out.size();
+            out.resize(pos + 4);
+
+            if (block.size() >= this_block) {
+                put_be(out.data() + pos, this_block, 4);
+                out.insert(out.end(), in + done, in + done + this_block);
+            } else {
+                put_be(out.data() + pos, block.size(), 4);
+                out.insert(out.end(), block.begin(), block.end());
+            }
+        }
+    }
+
+    void *result = H5allocate_memory(out.size(), false);
+    if (result == nullptr) {
+        return 0;
+    }
+
+    std::memcpy(result, out.data(), out.size());
+    H5free_memory(*buf);
+    *buf = result;
+    *buf_size = out.size();
+    return out.size();
+} catch (...) {
+    return 0;
+}
+
+//--------------------------------------------------
+// decoding without the HDF5 library
+//--------------------------------------------------
+
+// the inverse of the HDF5 shuffle filter; trailing bytes that do not
+// make up a whole element are stored as they are
+void unshuffle(const uint8_t *in, size_t nbytes, size_t esize, uint8_t *out) {
+    const size_t nelms = nbytes / esize;
+
+    for (size_t b = 0; b < esize; b++) {
+        const uint8_t *src = in + b * nelms;
+        for (size_t i = 0; i < nelms; i++) {
+            out[i * esize + b] = src[i];
+        }
+    }
+
+    std::memcpy(out + nelms * esize, in + nelms * esize, nbytes - nelms * esize);
+}
+
+
+#ifdef NIX_HAVE_ZLIB
+
+bool inflate_chunk(const uint8_t *in, size_t nbytes, size_t size_hint, std::vector<uint8_t> &out) {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+
+    out.resize(std::max<size_t>(size_hint, 64));
+    stream.next_in = const_cast<Bytef *>(in);
+    stream.avail_in = static_cast<uInt>(nbytes);
+
+    int res = Z_OK;
+    while (res == Z_OK) {
+        if (stream.total_out == out.size()) {
+            out.resize(out.size() * 2);
+        }
+        stream.next_out = out.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+        res = inflate(&stream, Z_NO_FLUSH);
+    }
+
+    out.resize(stream.total_out);
+    inflateEnd(&stream);
+    return res == Z_STREAM_END;
+}
+
+#endif
+
+} // anonymous namespace
+
+
+FilterPipeline::FilterPipeline(const BaseHDF5 &dcpl)
+    : supported(true)
+{
+    int nfilters = H5Pget_nfilters(dcpl.h5id());
+    if (nfilters < 0) {
+        throw H5Exception("FilterPipeline: Could not get the filters of the data set");
+    }
+
+    for (unsigned int i = 0; i < static_cast<unsigned int>(nfilters); i++) {
+        Filter filter;
+        unsigned int flags = 0;
+        size_t nvalues = 8;
+        filter.values.resize(nvalues);
+
+        filter.id = H5Pget_filter2(dcpl.h5id(), i, &flags, &nvalues, filter.values.data(), 0, nullptr, nullptr);
+        if (filter.id < 0) {
+            throw H5Exception("FilterPipeline: Could not get a filter of the data set");
+        }
+        filter.values.resize(std::min<size_t>(nvalues, filter.values.size()));
+
+        switch (filter.id) {
+        case H5Z_FILTER_SHUFFLE:
+            supported = supported && filter.values.size() > 0 && filter.values[0] > 0;
+            break;
+        case H5Z_FILTER_DEFLATE:
+#ifndef NIX_HAVE_ZLIB
+            supported = false;
+#endif
+            break;
+        case FILTER_LZ4:
+            break;
+        default:
+            supported = false;
+        }
+
+        filters.push_back(filter);
+    }
+}
+
+
+void FilterPipeline::decode(uint32_t mask, std::vector<uint8_t> &chunk, size_t size_hint) const {
+    std::vector<uint8_t> out;
+
+    for (size_t i = filters.size(); i-- > 0; ) {
+        // filters that were skipped when the chunk was written
+        if (mask & (1u << i)) {
+            continue;
+        }
+
+        const uint8_t *in = chunk.data();
+        const size_t nbytes = chunk.size();
+        bool ok = true;
+
+        switch (filters[i].id) {
+        case H5Z_FILTER_SHUFFLE:
+            out.resize(nbytes);
+            unshuffle(in, nbytes, filters[i].values[0], out.data());
+            break;
+#ifdef NIX_HAVE_ZLIB
+        case H5Z_FILTER_DEFLATE:
+            ok = inflate_chunk(in, nbytes, size_hint, out);
+            break;
+#endif
+        case FILTER_LZ4:
+            ok = lz4_decode(in, nbytes, size_hint, out);
+            break;
+        default:
+            ok = false;
+        }
+
+        if (!ok) {
+            throw std::runtime_error("FilterPipeline: Could not decode chunk");
+        }
+
+        chunk.swap(out);
+    }
+}
+
+
+void registerFilters() {
+    static std::once_flag registered;
+
+    std::call_once(registered, [] {
+        H5Z_class2_t lz4_class = {
+            H5Z_CLASS_T_VERS,
+            FILTER_LZ4,
+            1, 1,
+            "lz4",
+            nullptr,
+            lz4_set_local,
+            lz4_filter
+        };
+
+        HErr res = H5Zregister(&lz4_class);
+        res.check("Could not register the LZ4 filter");
+    });
+}
+
+
+void checkFilters(const Compression &compression) {
+    if (compression.shuffle && H5Zfilter_avail(H5Z_FILTER_SHUFFLE) <= 0) {
+        throw std::runtime_error("The shuffle filter is not available in this HDF5 library");
+    }
+
+    if (compression.codec == Codec::Deflate) {
+        if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+            throw std::runtime_error("Deflate compression is not available in this HDF5 library");
+        }
+        if (compression.level < 0 || compression.level > 9) {
+            throw std::invalid_argument("Deflate compression level must be between 0 and 9");
+        }
+    }
+}
+
+
+void setFilters(const BaseHDF5 &dcpl, const Compression &compression) {
+    HErr res;
+
+    checkFilters(compression);
+
+    if (compression.shuffle) {
+        res = H5Pset_shuffle(dcpl.h5id());
+        res.check("Could not set the shuffle filter on data set creation plist");
+    }
+
+    switch (compression.codec) {
+    case Codec::None:
+        break;
+
+    case Codec::Deflate:
+        res = H5Pset_deflate(dcpl.h5id(), static_cast<unsigned int>(compression.level));
+        res.check("Could not set the deflate filter on data set creation plist");
+        break;
+
+    case Codec::LZ4:
+        registerFilters();
+        res = H5Pset_filter(dcpl.h5id(), FILTER_LZ4, H5Z_FLAG_MANDATORY, 0, nullptr);
+        res.check("Could not set the LZ4 filter on data set creation plist");
+        break;
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -11,6 +11,10 @@
 #include <nix/util/util.hpp>
 
 #include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/Filters.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+
+#include <exception>
 
 
 namespace nix {
@@ -45,6 +49,7 @@ bool Group::hasObject(const std::string &name) const {
         return false;
     }
 
+    IOProbe probe(hid, IOOperation::LinkLookup);
     HTri res = H5Lexists(hid, name.c_str(), H5P_DEFAULT);
     return res.check("Group::hasObject(): H5Lexists failed");
 }
@@ -52,13 +57,21 @@ bool Group::hasObject(const std::string &name) const {
 bool Group::objectOfType(const std::string &name, H5O_type_t type) const {
     H5O_info_t info;
 
-    hid_t obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
+    hid_t obj;
+    {
+        IOProbe probe(hid, IOOperation::ObjectOpen);
+        obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
+    }
 
     if (!H5Iis_valid(obj)) {
         return false;
     }
 
+#if H5_VERSION_GE(1, 10, 3)
+    HErr err = H5Oget_info2(obj, &info, H5O_INFO_BASIC);
+#else
     HErr err = H5Oget_info(obj, &info);
+#endif
     err.check("Could not obtain object info");
 
     bool res = info.type == type;
@@ -67,11 +80,96 @@ bool Group::objectOfType(const std::string &name, H5O_type_t type) const {
     return res;
 }
 
+namespace {
+
+struct link_visit {
+    unsigned long fileno;
+    bool object_type;
+    const LinkVisitor *visitor;
+    std::exception_ptr error;
+};
+
+H5O_type_t object_type(hid_t group, const char *name) {
+    // dangling links are not an error, their type is just unknown
+    HErr err;
+#if H5_VERSION_GE(1, 12, 0)
+    H5O_info2_t info;
+    H5E_BEGIN_TRY {
+        err = H5Oget_info_by_name3(group, name, &info, H5O_INFO_BASIC, H5P_DEFAULT);
+    } H5E_END_TRY;
+#elif H5_VERSION_GE(1, 10, 3)
+    H5O_info_t info;
+    H5E_BEGIN_TRY {
+        err = H5Oget_info_by_name2(group, name, &info, H5O_INFO_BASIC, H5P_DEFAULT);
+    } H5E_END_TRY;
+#else
+    H5O_info_t info;
+    H5E_BEGIN_TRY {
+        err = H5Oget_info_by_name(group, name, &info, H5P_DEFAULT);
+    } H5E_END_TRY;
+#endif
+    return err ? info.type : H5O_TYPE_UNKNOWN;
+}
+
+#if H5_VERSION_GE(1, 12, 0)
+herr_t visit_link(hid_t group, const char *name, const H5L_info2_t *info, void *op_data) {
+    link_visit *visit = static_cast<link_visit *>(op_data);
+    haddr_t addr = HADDR_UNDEF;
+    if (info->type == H5L_TYPE_HARD && H5VLnative_token_to_addr(group, info->u.token, &addr) < 0) {
+        addr = HADDR_UNDEF;
+    }
+#else
+herr_t visit_link(hid_t group, const char *name, const H5L_info_t *info, void *op_data) {
+    link_visit *visit = static_cast<link_visit *>(op_data);
+    haddr_t addr = info->type == H5L_TYPE_HARD ? info->u.address : HADDR_UNDEF;
+#endif
+    H5O_type_t type = H5O_TYPE_UNKNOWN;
+    if (visit->object_type && info->type == H5L_TYPE_HARD) {
+        type = object_type(group, name);
+    }
+
+    // exceptions must not unwind through the HDF5 library
+    try {
+        return (*visit->visitor)(Link{name, ObjectAddress(visit->fileno, addr), type}) ? 0 : 1;
+    } catch (...) {
+        visit->error = std::current_exception();
+        return -1;
+    }
+}
+
+} // anonymous namespace
+
+
+void Group::visitLinks(const LinkVisitor &visitor, bool object_type) const {
+    link_visit visit = {address().first, object_type, &visitor, nullptr};
+
+    hsize_t idx = 0;
+    IOProbe probe(hid, IOOperation::LinkIteration);
+    HErr res = H5Literate(hid, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, visit_link, &visit);
+    if (visit.error) {
+        std::rethrow_exception(visit.error);
+    }
+    res.check("Group::visitLinks(): Could not iterate over links");
+}
+
+
+std::vector<Link> Group::links(bool object_type) const {
+    std::vector<Link> links;
+
+    visitLinks([&links](const Link &link) {
+        links.push_back(link);
+        return true;
+    }, object_type);
+
+    return links;
+}
+
+
 ndsize_t Group::objectCount() const {
-    hsize_t n_objs;
-    HErr res = H5Gget_num_objs(hid, &n_objs);
+    H5G_info_t info;
+    HErr res = H5Gget_info(hid, &info);
     res.check("Could not get object count");
-    return n_objs;
+    return info.nlinks;
 }
 
 
@@ -79,87 +177,70 @@ boost::optional<Group> Group::findGroupByAttribute(const std::string &attribute,
     boost::optional<Group> ret;
 
     // look up first direct sub-group that has given attribute with given value
-    for (ndsize_t index = 0; index < objectCount(); index++) {
-        std::string obj_name = objectName(index);
-        if(hasGroup(obj_name)) {
-            Group group = openGroup(obj_name, false);
-            if(group.hasAttr(attribute)) {
-                std::string attr_value;
-                group.getAttr(attribute, attr_value);
-                if (attr_value == value) {
-                    ret = group;
-                    break;
-                }
-            }
+    visitLinks([&](const Link &link) {
+        if (link.type != H5O_TYPE_GROUP) {
+            return true;
+        }
+
+        Group group = openGroup(link.name, false);
+        std::string attr_value;
+        if (group.getAttr(attribute, attr_value) && attr_value == value) {
+            ret = group;
+            return false;
         }
-    }
+
+        return true;
+    }, true);
 
     return ret;
 }
 
 
 boost::optional<DataSet> Group::findDataByAttribute(const std::string &attribute, const std::string &value) const {
-    std::vector<DataSet> dsets;
     boost::optional<DataSet> ret;
 
-    // look up all direct sub-datasets that have the given attribute
-    for (ndsize_t index = 0; index < objectCount(); index++) {
-        std::string obj_name = objectName(index);
-        if(hasData(obj_name)) {
-            DataSet ds = openData(obj_name);
+    // look up first direct sub-dataset that has given attribute set to given value
+    visitLinks([&](const Link &link) {
+        if (link.type != H5O_TYPE_DATASET) {
+            return true;
+        }
 
-            if (ds.hasAttr(attribute)) {
-                dsets.push_back(ds);
-            }
+        DataSet ds = openData(link.name);
+        std::string attr_value;
+        if (ds.getAttr(attribute, attr_value) && attr_value == value) {
+            ret = ds;
+            return false;
         }
-    }
-    // look for first dataset with given attribute set to given value
-    auto found = std::find_if(dsets.begin(), dsets.end(),
-                 [value, attribute](DataSet &dset) {
-                     std::string attr_value;
-                     dset.getAttr(attribute, attr_value);
-                     return attr_value == value; });
-    if(found != dsets.end()) ret = *found;
+
+        return true;
+    }, true);
 
     return ret;
 }
 
 
 std::string Group::objectName(ndsize_t index) const {
-    // check if index valid
-    if(index > objectCount()) {
-		//FIXME: issue #473
-        throw OutOfBounds("No object at given index",
-			              static_cast<size_t>(index));
-    }
-
-    std::string str_name;
-    // check whether name is found by index
-    ssize_t name_len = H5Lget_name_by_idx(hid,
-                                                  ".",
-                                                  H5_INDEX_NAME,
-                                                  H5_ITER_NATIVE,
-                                                  (hsize_t) index,
-                                                  NULL,
-                                                  0,
-                                                  H5P_DEFAULT);
-    if (name_len > 0) {
-        char* name = new char[name_len+1];
-        name_len = H5Lget_name_by_idx(hid,
-                                      ".",
-                                      H5_INDEX_NAME,
-                                      H5_ITER_NATIVE,
-                                      (hsize_t) index,
-                                      name,
-                                      name_len+1,
-                                      H5P_DEFAULT);
-        str_name = name;
-        delete [] name;
-    } else {
+    // most names fit into the buffer, so that a single lookup is enough
+    char buffer[256];
+    ssize_t name_len = -1;
+    IOProbe probe(hid, IOOperation::LinkIteration);
+    H5E_BEGIN_TRY {
+        name_len = H5Lget_name_by_idx(hid, ".", H5_INDEX_NAME, H5_ITER_NATIVE, (hsize_t) index,
+                                      buffer, sizeof(buffer), H5P_DEFAULT);
+    } H5E_END_TRY;
+    if (name_len < 0) {
+        //FIXME: issue #473
+        throw OutOfBounds("No object at given index", static_cast<size_t>(index));
+    } else if (name_len == 0) {
         throw H5Exception("objectName: No object found, H5Lget_name_by_idx returned no name");
+    } else if (static_cast<size_t>(name_len) < sizeof(buffer)) {
+        return std::string(buffer, static_cast<size_t>(name_len));
     }
 
-    return str_name;
+    std::vector<char> name(static_cast<size_t>(name_len) + 1);
+    H5Lget_name_by_idx(hid, ".", H5_INDEX_NAME, H5_ITER_NATIVE, (hsize_t) index,
+                       name.data(), name.size(), H5P_DEFAULT);
+    return std::string(name.data(), static_cast<size_t>(name_len));
 }
 
 
@@ -190,7 +271,8 @@ DataSet Group::createData(const std::string &name,
         const NDSize &maxsize,
         NDSize chunks,
         bool max_size_unlimited,
-        bool guess_chunks) const
+        bool guess_chunks,
+        const Compression &compression) const
 {
     DataSpace space;
 
@@ -215,6 +297,13 @@ DataSet Group::createData(const std::string &name,
         res.check("Could not set chunk size on data set creation plist");
     }
 
+    if (compression.codec != Codec::None || compression.shuffle) {
+        if (!chunks) {
+            throw std::invalid_argument("Group::createData: Compressed data sets must be chunked");
+        }
+        setFilters(dcpl, compression);
+    }
+
     DataSet ds = H5Dcreate(hid, name.c_str(), fileType.h5id(), space.h5id(), H5P_DEFAULT, dcpl.h5id(), H5P_DEFAULT);
     ds.check("Group::createData: Could not create DataSet with name " + name);
 
@@ -223,6 +312,7 @@ DataSet Group::createData(const std::string &name,
 
 
 DataSet Group::openData(const std::string &name) const {
+    IOProbe probe(hid, IOOperation::ObjectOpen);
     DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
     ds.check("Group::openData(): Could not open DataSet");
     return ds;
@@ -240,6 +330,7 @@ Group Group::openGroup(const std::string &name, bool create) const {
     Group g;
 
     if (hasGroup(name)) {
+        IOProbe probe(hid, IOOperation::ObjectOpen);
         g = Group(H5Gopen(hid, name.c_str(), H5P_DEFAULT));
         g.check("Group::openGroup(): Could not open group: " + name);
     } else if (create) {
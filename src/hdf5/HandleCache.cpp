@@ -0,0 +1,85 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/HandleCache.hpp>
+
+#include <nix/hdf5/FileState.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+struct cache_entry {
+    std::type_index type;
+    std::weak_ptr<void> obj;
+};
+
+// part of the file state
+struct handle_cache {
+    std::mutex lock;
+    std::map<haddr_t, cache_entry> entries;
+    size_t prune_at = 64;
+};
+
+} // anonymous namespace
+
+
+std::shared_ptr<void> HandleCache::lookup(const ObjectAddress &address, const std::type_index &type) {
+    if (address.second == HADDR_UNDEF) {
+        return std::shared_ptr<void>();
+    }
+
+    std::shared_ptr<handle_cache> cache = FileState::find<handle_cache>(address.first);
+    if (!cache) {
+        return std::shared_ptr<void>();
+    }
+
+    std::lock_guard<std::mutex> guard(cache->lock);
+    auto it = cache->entries.find(address.second);
+    if (it == cache->entries.end() || it->second.type != type) {
+        return std::shared_ptr<void>();
+    }
+
+    return it->second.obj.lock();
+}
+
+
+void HandleCache::insert(const ObjectAddress &address, const std::type_index &type, const std::shared_ptr<void> &obj) {
+    if (address.second == HADDR_UNDEF) {
+        return;
+    }
+
+    std::shared_ptr<handle_cache> cache = FileState::get<handle_cache>(address.first);
+    std::lock_guard<std::mutex> guard(cache->lock);
+
+    // drop the entries of objects that are gone, now and then
+    if (cache->entries.size() >= cache->prune_at) {
+        for (auto it = cache->entries.begin(); it != cache->entries.end(); ) {
+            if (it->second.obj.expired()) {
+                it = cache->entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        cache->prune_at = std::max<size_t>(64, 2 * cache->entries.size());
+    }
+
+    auto it = cache->entries.find(address.second);
+    if (it != cache->entries.end()) {
+        it->second = cache_entry{type, obj};
+    } else {
+        cache->entries.emplace(address.second, cache_entry{type, obj});
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,172 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/IOMonitor.hpp>
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// number of files that collect statistics, checked before every operation
+std::atomic<size_t> &enabled_count() {
+    static std::atomic<size_t> count(0);
+    return count;
+}
+
+// part of the file state; operations may be recorded by the worker
+// threads of parallel reads
+struct monitor_state {
+    std::mutex lock;
+    bool enabled = false;
+    IOStats stats;
+
+    ~monitor_state() {
+        if (enabled) {
+            enabled_count()--;
+        }
+    }
+};
+
+size_t histogram_bin(double seconds) {
+    double us = seconds * 1e6;
+    size_t bin = 0;
+    for (double limit = 1; us >= limit && bin < IO_HISTOGRAM_BINS - 1; limit *= 2) {
+        bin++;
+    }
+    return bin;
+}
+
+bool file_number(hid_t obj, unsigned long &fileno) {
+    H5O_info_t info;
+    herr_t res;
+    H5E_BEGIN_TRY {
+#if H5_VERSION_GE(1, 10, 3)
+        res = H5Oget_info2(obj, &info, H5O_INFO_BASIC);
+#else
+        res = H5Oget_info(obj, &info);
+#endif
+    } H5E_END_TRY;
+
+    fileno = info.fileno;
+    return res >= 0;
+}
+
+std::shared_ptr<monitor_state> find_state(hid_t obj) {
+    unsigned long fileno;
+    if (!file_number(obj, fileno)) {
+        return std::shared_ptr<monitor_state>();
+    }
+    return FileState::find<monitor_state>(fileno);
+}
+
+} // anonymous namespace
+
+
+void IOMonitor::enable(hid_t file, bool enable) {
+    unsigned long fileno;
+    if (!file_number(file, fileno)) {
+        throw H5Exception("IOMonitor::enable(): Could not obtain file number");
+    }
+
+    std::shared_ptr<monitor_state> state = FileState::find<monitor_state>(fileno);
+    if (!state) {
+        if (!enable) {
+            return;
+        }
+        state = FileState::get<monitor_state>(fileno);
+    }
+
+    std::lock_guard<std::mutex> guard(state->lock);
+    if (state->enabled != enable) {
+        state->enabled = enable;
+        if (enable) {
+            enabled_count()++;
+        } else {
+            enabled_count()--;
+        }
+    }
+}
+
+
+IOStats IOMonitor::stats(hid_t file) {
+    std::shared_ptr<monitor_state> state = find_state(file);
+    if (!state) {
+        return IOStats();
+    }
+
+    std::lock_guard<std::mutex> guard(state->lock);
+    return state->stats;
+}
+
+
+void IOMonitor::reset(hid_t file) {
+    std::shared_ptr<monitor_state> state = find_state(file);
+    if (state) {
+        std::lock_guard<std::mutex> guard(state->lock);
+        state->stats = IOStats();
+    }
+}
+
+
+bool IOMonitor::active() {
+    return enabled_count().load(std::memory_order_relaxed) > 0;
+}
+
+
+void IOMonitor::record(hid_t obj, IOOperation op, size_t bytes, double seconds) {
+    std::shared_ptr<monitor_state> state;
+    try {
+        state = find_state(obj);
+    } catch (...) {
+        return;
+    }
+
+    if (!state) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(state->lock);
+    if (!state->enabled) {
+        return;
+    }
+
+    IOCounter &counter = state->stats[op];
+    counter.calls++;
+    counter.bytes += bytes;
+    counter.seconds += seconds;
+    counter.histogram[histogram_bin(seconds)]++;
+}
+
+
+void IOProbe::transfer(hid_t mem_type, hid_t mem_space) {
+    if (!running) {
+        return;
+    }
+
+    hid_t space = mem_space;
+    if (mem_space == H5S_ALL) {
+        H5I_type_t type = H5Iget_type(obj);
+        space = type == H5I_ATTR ? H5Aget_space(obj) : H5Dget_space(obj);
+    }
+
+    hssize_t npoints = space >= 0 ? H5Sget_select_npoints(space) : 0;
+    if (space != mem_space && space >= 0) {
+        H5Sclose(space);
+    }
+
+    nbytes = npoints > 0 ? H5Tget_size(mem_type) * static_cast<size_t>(npoints) : 0;
+}
+
+} // namespace hdf5
+} // namespace nix
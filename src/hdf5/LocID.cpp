@@ -9,6 +9,7 @@
 // Author: Christian Kellner <kellner@bio.lmu.de>
 
 #include <nix/hdf5/LocID.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
 
 namespace nix {
 
@@ -24,6 +25,7 @@ LocID::LocID(const LocID &other) : BaseHDF5(other) {}
 
 
 bool LocID::hasAttr(const std::string &name) const {
+    IOProbe probe(hid, IOOperation::AttrLookup);
     HTri res = H5Aexists(hid, name.c_str());
     return res.check("LocID.hasAttr() failed");
 }
@@ -36,6 +38,7 @@ void LocID::removeAttr(const std::string &name) const {
 
 
 Attribute LocID::openAttr(const std::string &name) const {
+    IOProbe probe(hid, IOOperation::AttrLookup);
     Attribute attr = H5Aopen(hid, name.c_str(), H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not open attribute " + name);
     return attr;
@@ -43,6 +46,7 @@ Attribute LocID::openAttr(const std::string &name) const {
 
 
 Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, const DataSpace &fileSpace) const {
+    IOProbe probe(hid, IOOperation::AttrLookup);
     Attribute attr = H5Acreate(hid, name.c_str(), fileType.h5id(), fileSpace.h5id(), H5P_DEFAULT, H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not create attribute " + name);
     return attr;
@@ -53,6 +57,19 @@ void LocID::deleteLink(std::string name, hid_t plist) {
     HErr res = H5Ldelete(hid, name.c_str(), plist);
     res.check("LocIDL::deleteLink: Could not delete link: " + name);
 }
+
+
+ObjectAddress LocID::address() const {
+    H5O_info_t info;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(hid, &info, H5O_INFO_BASIC);
+#else
+    HErr res = H5Oget_info(hid, &info);
+#endif
+    res.check("LocID::address(): Could not obtain object info");
+    return ObjectAddress(info.fileno, info.addr);
+}
+
 } // nix::hdf5
 
 } // nix::
\ No newline at end of file
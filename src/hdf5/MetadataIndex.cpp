@@ -0,0 +1,203 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/MetadataIndex.hpp>
+
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+
+#include <algorithm>
+#include <deque>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// part of the file state, so that all handles of a file share one index
+typedef FileState::Lazy<MetadataIndex> metadata_index;
+
+
+struct PendingSection {
+    Group container;
+    std::string link;
+    size_t parent;
+    size_t depth;
+};
+
+
+void push_sections(std::deque<PendingSection> &todo, const Group &container, size_t parent, size_t depth) {
+    container.visitLinks([&](const Link &link) {
+        if (link.type == H5O_TYPE_GROUP) {
+            todo.push_back(PendingSection{container, link.name, parent, depth});
+        }
+        return true;
+    }, true);
+}
+
+
+bool contains(const std::vector<size_t> &positions, size_t pos) {
+    return std::binary_search(positions.begin(), positions.end(), pos);
+}
+
+} // anonymous namespace
+
+
+const size_t MetadataIndex::npos;
+
+
+std::shared_ptr<const MetadataIndex> MetadataIndex::get(const LocID &obj) {
+    // built without holding the lock, the index is immutable once published
+    return FileState::get<metadata_index>(obj)->get([&obj]() {
+        auto index = std::make_shared<MetadataIndex>();
+        Group root(H5Gopen(obj.h5id(), "/", H5P_DEFAULT));
+        root.check("MetadataIndex: Could not open root group");
+        if (root.hasGroup("metadata")) {
+            index->build(root.openGroup("metadata", false));
+        }
+        return index;
+    });
+}
+
+
+void MetadataIndex::invalidate(const LocID &file) {
+    std::shared_ptr<metadata_index> index = FileState::find<metadata_index>(file);
+    if (index) {
+        index->invalidate();
+    }
+}
+
+
+void MetadataIndex::build(const Group &metadata) {
+    std::deque<PendingSection> todo;
+    push_sections(todo, metadata, npos, 0);
+
+    // breadth-first, so that the positions of the nodes are in breadth-first order
+    while (!todo.empty()) {
+        PendingSection current = todo.front();
+        todo.pop_front();
+
+        Group group = current.container.openGroup(current.link, false);
+        size_t pos = nodes.size();
+
+        Node node;
+        group.getAttr("entity_id", node.id);
+        group.getAttr("name", node.name);
+        group.getAttr("type", node.type);
+        node.link = current.link;
+        node.parent = current.parent;
+        node.depth = current.depth;
+
+        by_id[node.id] = pos;
+        by_name[node.name].push_back(pos);
+        by_type[node.type].push_back(pos);
+        if (current.parent != npos) {
+            nodes[current.parent].children.push_back(pos);
+        }
+        nodes.push_back(std::move(node));
+
+        if (group.hasGroup("properties")) {
+            group.openGroup("properties", false).visitLinks([this, pos](const Link &link) {
+                by_property[link.name].push_back(pos);
+                return true;
+            });
+        }
+
+        if (group.hasGroup("sections")) {
+            push_sections(todo, group.openGroup("sections", false), pos, current.depth + 1);
+        }
+    }
+}
+
+
+size_t MetadataIndex::find(const std::string &id) const {
+    auto it = by_id.find(id);
+    return it != by_id.end() ? it->second : npos;
+}
+
+
+std::vector<std::pair<size_t, size_t>> MetadataIndex::query(size_t start, const base::SectionQuery &query,
+                                                            size_t max_depth) const {
+    std::vector<std::pair<size_t, size_t>> result;
+    const Node &root = nodes.at(start);
+
+    // the smallest posting list of the query restricts the candidates
+    std::vector<size_t> id_match;
+    const std::vector<size_t> *candidates = nullptr;
+    auto restrict = [&candidates](const PostingMap &map, const std::string &key) {
+        static const std::vector<size_t> no_match;
+        auto it = map.find(key);
+        const std::vector<size_t> *list = it != map.end() ? &it->second : &no_match;
+        if (!candidates || list->size() < candidates->size()) {
+            candidates = list;
+        }
+    };
+
+    if (!query.id.empty()) {
+        size_t pos = find(query.id);
+        if (pos != npos) {
+            id_match.push_back(pos);
+        }
+        candidates = &id_match;
+    }
+    if (!query.name.empty()) {
+        restrict(by_name, query.name);
+    }
+    if (!query.type.empty()) {
+        restrict(by_type, query.type);
+    }
+    if (!query.property.empty()) {
+        restrict(by_property, query.property);
+    }
+
+    if (!candidates) {
+        // plain breadth-first traversal of the subtree
+        std::deque<size_t> todo = {start};
+        while (!todo.empty()) {
+            size_t pos = todo.front();
+            todo.pop_front();
+
+            size_t depth = nodes[pos].depth - root.depth;
+            result.emplace_back(pos, depth);
+            if (depth < max_depth) {
+                todo.insert(todo.end(), nodes[pos].children.begin(), nodes[pos].children.end());
+            }
+        }
+        return result;
+    }
+
+    // positions are in breadth-first order, so the candidates are as well
+    for (size_t pos : *candidates) {
+        const Node &node = nodes[pos];
+        if (node.depth < root.depth || node.depth - root.depth > max_depth) {
+            continue;
+        }
+        if ((!query.id.empty() && node.id != query.id) ||
+            (!query.name.empty() && node.name != query.name) ||
+            (!query.type.empty() && node.type != query.type)) {
+            continue;
+        }
+        if (!query.property.empty() && !contains(by_property.at(query.property), pos)) {
+            continue;
+        }
+
+        size_t ancestor = pos;
+        for (size_t d = node.depth; d > root.depth; d--) {
+            ancestor = nodes[ancestor].parent;
+        }
+        if (ancestor == start) {
+            result.emplace_back(pos, node.depth - root.depth);
+        }
+    }
+
+    return result;
+}
+
+
+} // namespace hdf5
+} // namespace nix
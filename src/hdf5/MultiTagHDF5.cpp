@@ -14,6 +14,7 @@
 #include <nix/hdf5/DataArrayHDF5.hpp>
 #include <nix/hdf5/BlockHDF5.hpp>
 #include <nix/hdf5/FeatureHDF5.hpp>
+#include <nix/hdf5/HandleCache.hpp>
 #include <nix/Exception.hpp>
 
 #include <algorithm>
@@ -54,7 +55,9 @@ shared_ptr<IDataArray> MultiTagHDF5::positions() const {
 
     if (group().hasGroup("positions")) {
         Group other_group = group().openGroup("positions", false);
-        da = make_shared<DataArrayHDF5>(file(), block(), other_group);
+        da = HandleCache::get<DataArrayHDF5>(other_group, [&] {
+            return make_shared<DataArrayHDF5>(file(), block(), other_group);
+        });
         if (!block()->hasDataArray(da->id())) 
             error = true;
     }
@@ -97,7 +100,9 @@ shared_ptr<IDataArray>  MultiTagHDF5::extents() const {
 
     if (group().hasGroup("extents")) {
         Group other_group = group().openGroup("extents", false);
-        da = make_shared<DataArrayHDF5>(file(), block(), other_group);
+        da = HandleCache::get<DataArrayHDF5>(other_group, [&] {
+            return make_shared<DataArrayHDF5>(file(), block(), other_group);
+        });
         if (!block()->hasDataArray(da->id())) 
             error = true;
     }
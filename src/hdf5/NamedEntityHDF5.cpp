@@ -42,7 +42,7 @@ NamedEntityHDF5::NamedEntityHDF5(const std::shared_ptr<IFile> &file, const Group
     if (name.empty()) {
         throw EmptyString("name");
     } else {
-        group.setAttr("name", name);
+        attributes().set(group, "name", name);
         forceUpdatedAt();
     }
 
@@ -53,7 +53,7 @@ void NamedEntityHDF5::type(const string &type) {
     if (type.empty()) {
         throw EmptyString("type");
     } else {
-        group().setAttr("type", type);
+        attributes().set(group(), "type", type);
         forceUpdatedAt();
     }
 }
@@ -61,23 +61,19 @@ void NamedEntityHDF5::type(const string &type) {
 
 string NamedEntityHDF5::type() const {
     string type;
-    if (group().hasAttr("type")) {
-        group().getAttr("type", type);
-        return type;
-    } else {
+    if (!attributes().get(group(), "type", type)) {
         throw MissingAttr("type");
     }
+    return type;
 }
 
 
 string NamedEntityHDF5::name() const {
     string name;
-    if (group().hasAttr("name")) {
-        group().getAttr("name", name);
-        return name;
-    } else {
+    if (!attributes().get(group(), "name", name)) {
         throw MissingAttr("name");
     }
+    return name;
 }
 
 
@@ -85,7 +81,7 @@ void NamedEntityHDF5::definition(const string &definition) {
     if (definition.empty()) {
         throw EmptyString("definition");
     } else {
-        group().setAttr("definition", definition);
+        attributes().set(group(), "definition", definition);
         forceUpdatedAt();
     }
 }
@@ -94,7 +90,7 @@ void NamedEntityHDF5::definition(const string &definition) {
 boost::optional<string> NamedEntityHDF5::definition() const {
     boost::optional<string> ret;
     string definition;
-    bool have_attr = group().getAttr("definition", definition);
+    bool have_attr = attributes().get(group(), "definition", definition);
     if (have_attr) {
         ret = definition;
     }
@@ -103,9 +99,7 @@ boost::optional<string> NamedEntityHDF5::definition() const {
 
 
 void NamedEntityHDF5::definition(const nix::none_t t) {
-    if (group().hasAttr("definition")) {
-        group().removeAttr("definition");
-    }
+    attributes().remove(group(), "definition");
     forceUpdatedAt();
 }
 
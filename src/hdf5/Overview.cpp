@@ -0,0 +1,397 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/Overview.hpp>
+#include <nix/hdf5/DataTypeHDF5.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+const char *OVERVIEW_GROUP = "overview";
+
+// number of doubles to hold in memory while building or querying
+const size_t BATCH_VALUES = 1024 * 1024;
+
+enum { STAT_MIN = 0, STAT_MAX = 1, STAT_MEAN = 2, STAT_COUNT = 3, NSTATS = 4 };
+
+// shape of the bins [start, start + bins) of a level, or their offset
+inline NDSize bin_shape(ndsize_t bins, size_t channels) {
+    return NDSize({bins, static_cast<ndsize_t>(channels), static_cast<ndsize_t>(NSTATS)});
+}
+
+inline NDSize bin_offset(ndsize_t start) {
+    return NDSize({start, ndsize_t(0), ndsize_t(0)});
+}
+
+inline ndsize_t div_up(ndsize_t a, ndsize_t b) {
+    return (a + b - 1) / b;
+}
+
+
+size_t channel_count(const NDSize &extent, size_t axis) {
+    return extent.size() == 2 ? nix::check::fits_in_size_t(extent[1 - axis], "Too many channels") : 1;
+}
+
+
+// samples [from, to) along the axis, as rows of one value per channel
+std::vector<double> read_samples(const DataSet &data, const NDSize &extent, size_t axis,
+                                 ndsize_t from, ndsize_t to) {
+    const size_t channels = channel_count(extent, axis);
+    const size_t n = nix::check::fits_in_size_t(to - from, "Cannot read samples: exceeds memory");
+
+    NDSize count(extent), offset(extent.size(), 0);
+    count[axis] = to - from;
+    offset[axis] = from;
+
+    std::vector<double> buf(n * channels);
+    if (buf.empty()) {
+        return buf;
+    }
+
+    Selection fileSel = data.createSelection();
+    fileSel.select(count, offset);
+    Selection memSel(DataSpace::create(count, false));
+    data.read(DataType::Double, buf.data(), fileSel, memSel);
+
+    if (axis == 1 && channels > 1) {
+        std::vector<double> rows(buf.size());
+        for (size_t c = 0; c < channels; c++) {
+            for (size_t s = 0; s < n; s++) {
+                rows[s * channels + c] = buf[c * n + s];
+            }
+        }
+        buf.swap(rows);
+    }
+
+    return buf;
+}
+
+
+// stats of consecutive groups of `step` rows
+void summarize(const std::vector<double> &samples, size_t channels, size_t step, std::vector<double> &stats) {
+    const size_t rows = samples.size() / channels;
+    const size_t groups = (rows + step - 1) / step;
+
+    stats.assign(groups * channels * NSTATS, 0.0);
+
+    for (size_t g = 0; g < groups; g++) {
+        const size_t first = g * step;
+        const size_t last = std::min(first + step, rows);
+
+        for (size_t c = 0; c < channels; c++) {
+            double lo = std::numeric_limits<double>::infinity();
+            double hi = -lo;
+            double sum = 0.0;
+
+            for (size_t r = first; r < last; r++) {
+                const double v = samples[r * channels + c];
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+                sum += v;
+            }
+
+            double *s = &stats[(g * channels + c) * NSTATS];
+            s[STAT_MIN] = lo;
+            s[STAT_MAX] = hi;
+            s[STAT_MEAN] = sum / (last - first);
+            s[STAT_COUNT] = static_cast<double>(last - first);
+        }
+    }
+}
+
+
+// stats of pairs of bins
+void combine(const std::vector<double> &bins, size_t channels, std::vector<double> &stats) {
+    const size_t nbins = bins.size() / (channels * NSTATS);
+    const size_t pairs = (nbins + 1) / 2;
+
+    stats.assign(pairs * channels * NSTATS, 0.0);
+
+    for (size_t p = 0; p < pairs; p++) {
+        for (size_t c = 0; c < channels; c++) {
+            const double *a = &bins[(2 * p * channels + c) * NSTATS];
+            double *s = &stats[(p * channels + c) * NSTATS];
+            std::copy(a, a + NSTATS, s);
+
+            if (2 * p + 1 < nbins) {
+                const double *b = &bins[((2 * p + 1) * channels + c) * NSTATS];
+                const double count = a[STAT_COUNT] + b[STAT_COUNT];
+                s[STAT_MIN] = std::min(a[STAT_MIN], b[STAT_MIN]);
+                s[STAT_MAX] = std::max(a[STAT_MAX], b[STAT_MAX]);
+                s[STAT_MEAN] = (a[STAT_MEAN] * a[STAT_COUNT] + b[STAT_MEAN] * b[STAT_COUNT]) / count;
+                s[STAT_COUNT] = count;
+            }
+        }
+    }
+}
+
+
+void read_bins(const DataSet &level, size_t channels, ndsize_t from, ndsize_t to, std::vector<double> &bins) {
+    bins.resize(nix::check::fits_in_size_t((to - from) * channels * NSTATS, "Cannot read bins: exceeds memory"));
+    if (bins.empty()) {
+        return;
+    }
+
+    NDSize count = bin_shape(to - from, channels);
+    Selection fileSel = level.createSelection();
+    fileSel.select(count, bin_offset(from));
+    Selection memSel(DataSpace::create(count, false));
+    level.read(DataType::Double, bins.data(), fileSel, memSel);
+}
+
+
+void write_bins(DataSet &level, size_t channels, ndsize_t from, const std::vector<double> &bins) {
+    if (bins.empty()) {
+        return;
+    }
+
+    NDSize count = bin_shape(bins.size() / (channels * NSTATS), channels);
+    Selection fileSel = level.createSelection();
+    fileSel.select(count, bin_offset(from));
+    Selection memSel(DataSpace::create(count, false));
+    level.write(DataType::Double, bins.data(), fileSel, memSel);
+}
+
+
+void append_points(Envelope &env, const std::vector<double> &stats, size_t channels) {
+    for (size_t i = 0; i < stats.size(); i += NSTATS) {
+        env.min.push_back(stats[i + STAT_MIN]);
+        env.max.push_back(stats[i + STAT_MAX]);
+        env.mean.push_back(stats[i + STAT_MEAN]);
+    }
+    env.shape = NDSize({static_cast<ndsize_t>(env.min.size() / channels), static_cast<ndsize_t>(channels)});
+}
+
+} // anonymous namespace
+
+
+Overview::Overview(const Group &group, size_t axis, ndsize_t bin_size)
+    : group(group), sample_axis(axis), bin_size(bin_size)
+{
+}
+
+
+bool Overview::exists(const Group &array_group) {
+    return array_group.hasGroup(OVERVIEW_GROUP);
+}
+
+
+Overview Overview::create(const Group &array_group, const DataSet &data, const NDSize &extent,
+                          size_t axis, size_t bin_size) {
+    if (extent.size() != 1 && extent.size() != 2) {
+        throw InvalidRank("Overviews are only supported for 1-D and 2-D data");
+    }
+
+    if (axis >= extent.size()) {
+        throw InvalidRank("Overview axis is out of bounds");
+    }
+
+    if (bin_size < 2) {
+        throw std::invalid_argument("Overview bin size must be at least 2");
+    }
+
+    remove(array_group);
+
+    Group g = array_group.openGroup(OVERVIEW_GROUP, true);
+    g.setAttr("axis", static_cast<uint64_t>(axis));
+    g.setAttr("bin_size", static_cast<uint64_t>(bin_size));
+    g.setAttr("length", static_cast<uint64_t>(0));
+
+    Overview overview(g, axis, bin_size);
+    overview.update(data, extent, 0, extent[axis]);
+    return overview;
+}
+
+
+Overview Overview::open(const Group &array_group) {
+    Group g = array_group.openGroup(OVERVIEW_GROUP, false);
+
+    uint64_t axis = 0, bin_size = 0;
+    g.getAttr("axis", axis);
+    g.getAttr("bin_size", bin_size);
+
+    return Overview(g, static_cast<size_t>(axis), bin_size);
+}
+
+
+void Overview::remove(const Group &array_group) {
+    if (exists(array_group)) {
+        Group g(array_group);
+        g.removeGroup(OVERVIEW_GROUP);
+    }
+}
+
+
+DataSet Overview::level(size_t index, size_t channels) const {
+    const std::string name = util::numToStr(index);
+
+    if (group.hasData(name)) {
+        return group.openData(name);
+    }
+
+    h5x::DataType fileType = data_type_to_h5_filetype(DataType::Double);
+    NDSize chunks = bin_shape(std::max<ndsize_t>(1, 4096 / channels), channels);
+    return group.createData(name, fileType, bin_shape(0, channels), {}, chunks, true, false);
+}
+
+
+void Overview::update(const DataSet &data, const NDSize &extent, ndsize_t begin, ndsize_t end) {
+    const size_t channels = channel_count(extent, sample_axis);
+    const ndsize_t length = extent[sample_axis];
+
+    uint64_t old_length = 0;
+    group.getAttr("length", old_length);
+
+    end = std::min(end, length);
+    if (begin >= end && old_length == length) {
+        return;
+    }
+
+    // bins of level 0 to recompute
+    const ndsize_t nbins = div_up(length, bin_size);
+    ndsize_t lo = begin / bin_size;
+    ndsize_t hi = div_up(end, bin_size);
+
+    if (old_length != length) {
+        // the data was resized, the bins from the old end on change
+        lo = std::min(lo, std::min<ndsize_t>(old_length, length) / bin_size);
+        hi = nbins;
+    }
+
+    lo = std::min(lo, nbins);
+    hi = std::min(std::max(hi, lo), nbins);
+
+    std::vector<double> samples, bins, stats;
+
+    DataSet current = level(0, channels);
+    current.setExtent(bin_shape(nbins, channels));
+
+    const ndsize_t batch = std::max<ndsize_t>(1, BATCH_VALUES / (bin_size * channels));
+    for (ndsize_t b = lo; b < hi; b += batch) {
+        const ndsize_t b_end = std::min(b + batch, hi);
+        samples = read_samples(data, extent, sample_axis, b * bin_size, std::min(b_end * bin_size, length));
+        summarize(samples, channels, static_cast<size_t>(bin_size), stats);
+        write_bins(current, channels, b, stats);
+    }
+
+    // combine pairs of bins until a single one is left
+    size_t index = 0;
+    ndsize_t below = nbins;
+
+    while (below > 1) {
+        const ndsize_t count = div_up(below, 2);
+        lo = lo / 2;
+        hi = std::min(div_up(hi, 2), count);
+
+        DataSet next = level(++index, channels);
+        next.setExtent(bin_shape(count, channels));
+
+        const ndsize_t pair_batch = std::max<ndsize_t>(1, BATCH_VALUES / (2 * channels * NSTATS));
+        for (ndsize_t b = lo; b < hi; b += pair_batch) {
+            const ndsize_t b_end = std::min(b + pair_batch, hi);
+            read_bins(current, channels, 2 * b, std::min(2 * b_end, below), bins);
+            combine(bins, channels, stats);
+            write_bins(next, channels, b, stats);
+        }
+
+        current = next;
+        below = count;
+    }
+
+    // drop the levels that are no longer needed
+    while (group.hasData(util::numToStr(++index))) {
+        group.removeData(util::numToStr(index));
+    }
+
+    group.setAttr("length", static_cast<uint64_t>(length));
+}
+
+
+Envelope Overview::envelope(const DataSet &data, const NDSize &extent,
+                            ndsize_t start, ndsize_t count, size_t points) const {
+    const size_t channels = channel_count(extent, sample_axis);
+    const ndsize_t length = extent[sample_axis];
+
+    start = std::min(start, length);
+    count = std::min(count, length - start);
+    const ndsize_t step = std::max<ndsize_t>(1, count / std::max<size_t>(points, 1));
+
+    if (step < bin_size || count == 0) {
+        return compute(data, extent, sample_axis, start, count, points);
+    }
+
+    // coarsest level with bins no larger than the step
+    size_t index = 0;
+    ndsize_t bin = bin_size;
+    while (bin * 2 <= step && group.hasData(util::numToStr(index + 1))) {
+        bin *= 2;
+        index++;
+    }
+
+    DataSet lvl = group.openData(util::numToStr(index));
+    const ndsize_t nbins = lvl.size()[0];
+    const ndsize_t first = start / bin;
+    const ndsize_t last = std::min(div_up(start + count, bin), nbins);
+
+    Envelope env;
+    env.start = first * bin;
+    env.step = bin;
+
+    std::vector<double> bins;
+    const ndsize_t batch = std::max<ndsize_t>(1, BATCH_VALUES / (channels * NSTATS));
+    for (ndsize_t b = first; b < last; b += batch) {
+        read_bins(lvl, channels, b, std::min(b + batch, last), bins);
+        append_points(env, bins, channels);
+    }
+
+    return env;
+}
+
+
+Envelope Overview::compute(const DataSet &data, const NDSize &extent, size_t axis,
+                           ndsize_t start, ndsize_t count, size_t points) {
+    if (extent.size() != 1 && extent.size() != 2) {
+        throw InvalidRank("Envelopes are only supported for 1-D and 2-D data");
+    }
+
+    if (axis >= extent.size()) {
+        throw InvalidRank("Envelope axis is out of bounds");
+    }
+
+    const size_t channels = channel_count(extent, axis);
+    const ndsize_t length = extent[axis];
+
+    start = std::min(start, length);
+    count = std::min(count, length - start);
+    const ndsize_t step = std::max<ndsize_t>(1, count / std::max<size_t>(points, 1));
+
+    Envelope env;
+    env.start = start;
+    env.step = step;
+    env.shape = NDSize({ndsize_t(0), static_cast<ndsize_t>(channels)});
+
+    std::vector<double> samples, stats;
+    const ndsize_t batch = std::max<ndsize_t>(1, BATCH_VALUES / (step * channels)) * step;
+    for (ndsize_t s = start; s < start + count; s += batch) {
+        samples = read_samples(data, extent, axis, s, std::min(s + batch, start + count));
+        summarize(samples, channels, static_cast<size_t>(step), stats);
+        append_points(env, stats, channels);
+    }
+
+    return env;
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,324 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/ParallelReader.hpp>
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/Filters.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// worker threads shared by all reads, started when first needed
+class WorkerPool {
+
+public:
+
+    static WorkerPool &instance() {
+        // never destroyed, so exiting the program does not wait for idle workers
+        static WorkerPool *pool = new WorkerPool();
+        return *pool;
+    }
+
+    void reserve(size_t threads) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (; workers < threads; workers++) {
+            std::thread(&WorkerPool::run, this).detach();
+        }
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+private:
+
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [this] { return !tasks.empty(); });
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> tasks;
+    size_t workers = 0;
+};
+
+
+// the tasks of one read; at most limit of them are queued or running
+class TaskGroup {
+
+public:
+
+    explicit TaskGroup(size_t limit)
+        : limit(limit), pending(0)
+    {
+    }
+
+    ~TaskGroup() {
+        // the tasks refer to buffers of the read
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [this] { return pending == 0; });
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            done.wait(guard, [this] { return pending < limit; });
+            pending++;
+        }
+
+        WorkerPool::instance().submit([this, task] {
+            std::exception_ptr failure;
+            try {
+                task();
+            } catch (...) {
+                failure = std::current_exception();
+            }
+
+            // notify while holding the lock, the group may be gone right after
+            std::lock_guard<std::mutex> guard(lock);
+            if (failure && !error) {
+                error = failure;
+            }
+            pending--;
+            done.notify_all();
+        });
+    }
+
+    bool failed() {
+        std::lock_guard<std::mutex> guard(lock);
+        return static_cast<bool>(error);
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [this] { return pending == 0; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+
+    std::mutex lock;
+    std::condition_variable done;
+    size_t limit;
+    size_t pending;
+    std::exception_ptr error;
+};
+
+} // anonymous namespace
+
+
+ParallelReader::ParallelReader(const DataSet &data, size_t threads)
+    : data(data), threads(threads)
+{
+}
+
+
+std::mutex &ParallelReader::libraryLock() {
+    static std::mutex lock;
+    return lock;
+}
+
+#if H5_VERSION_GE(1, 10, 2)
+
+bool ParallelReader::read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const {
+    const size_t rank = count.size();
+
+    if (threads < 2 || rank == 0 || offset.size() != rank ||
+        dtype == DataType::String || dtype == DataType::Opaque) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> guard(libraryLock());
+
+    const DataType native_type = data.dataType();
+    if (native_type == DataType::String || native_type == DataType::Opaque || native_type == DataType::Nothing) {
+        return false;
+    }
+
+    BaseHDF5 dcpl = H5Dget_create_plist(data.h5id());
+    dcpl.check("ParallelReader: Could not get data set creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return false;
+    }
+
+    const FilterPipeline pipeline(dcpl);
+    if (!pipeline.decodable()) {
+        return false;
+    }
+
+    // decoded chunks are copied as they are, so they must be in native layout
+    h5x::DataType file_type = H5Dget_type(data.h5id());
+    h5x::DataType native_mem_type = data_type_to_h5_memtype(native_type);
+    if (H5Tequal(file_type.h5id(), native_mem_type.h5id()) <= 0) {
+        return false;
+    }
+
+    NDSize chunk_shape(rank);
+    if (H5Pget_chunk(dcpl.h5id(), static_cast<int>(rank), chunk_shape.data()) != static_cast<int>(rank)) {
+        return false;
+    }
+
+    NDSize extent = data.size();
+    guard.unlock();
+
+    NDSize first(rank), last(rank);
+    for (size_t d = 0; d < rank; d++) {
+        if (count[d] == 0 || offset[d] + count[d] > extent[d]) {
+            return false;
+        }
+        first[d] = offset[d] / chunk_shape[d];
+        last[d] = (offset[d] + count[d] - 1) / chunk_shape[d];
+    }
+
+    // enumerate the chunks touched by the selection
+    std::vector<NDSize> chunks;
+    NDSize idx(first);
+    while (true) {
+        chunks.push_back(idx);
+
+        size_t d = rank;
+        while (d > 0 && idx[d - 1] == last[d - 1]) {
+            idx[d - 1] = first[d - 1];
+            d--;
+        }
+        if (d == 0) {
+            break;
+        }
+        idx[d - 1]++;
+    }
+
+    if (chunks.size() < 2) {
+        return false;
+    }
+
+    const size_t esize = data_type_to_size(native_type);
+    const size_t out_esize = data_type_to_size(dtype);
+    const bool convert = dtype != native_type;
+    const size_t chunk_bytes = chunk_shape.nelms() * esize;
+    const size_t nelms = count.nelms();
+
+    // chunks are assembled in the native type and converted at the end
+    std::vector<char> scratch;
+    char *out = static_cast<char *>(buffer);
+    if (convert) {
+        scratch.resize(nelms * std::max(esize, out_esize));
+        out = scratch.data();
+    }
+
+    WorkerPool::instance().reserve(threads - 1);
+
+    {
+        // the calling thread fetches the chunks, the workers decode them
+        TaskGroup group(threads);
+
+        for (size_t i = 0; i < chunks.size() && !group.failed(); i++) {
+            NDSize start(rank), src_off(rank), dst_off(rank), box(rank);
+            for (size_t d = 0; d < rank; d++) {
+                start[d] = chunks[i][d] * chunk_shape[d];
+                ndsize_t lo = std::max(offset[d], start[d]);
+                ndsize_t hi = std::min(offset[d] + count[d], start[d] + chunk_shape[d]);
+                src_off[d] = lo - start[d];
+                dst_off[d] = lo - offset[d];
+                box[d] = hi - lo;
+            }
+
+            auto raw = std::make_shared<std::vector<uint8_t>>();
+            uint32_t filters = 0;
+            {
+                std::lock_guard<std::mutex> lock(libraryLock());
+
+                // chunks that were never written make the library report an error
+                hsize_t storage = 0;
+                HErr res;
+                H5E_BEGIN_TRY {
+                    res = H5Dget_chunk_storage_size(data.h5id(), start.data(), &storage);
+                } H5E_END_TRY;
+
+                if (res.isError() || storage == 0) {
+                    // chunk was never written, let the library fill it in
+                    Selection fileSel = data.createSelection();
+                    fileSel.select(box, start + src_off);
+                    Selection memSel(DataSpace::create(count, false));
+                    memSel.select(box, dst_off);
+                    data.read(native_type, out, fileSel, memSel);
+                    continue;
+                }
+
+                raw->resize(static_cast<size_t>(storage));
+
+                {
+                    IOProbe probe(data.h5id(), IOOperation::DataRead);
+                    probe.bytes(static_cast<size_t>(storage));
+                    res = H5Dread_chunk(data.h5id(), H5P_DEFAULT, start.data(), &filters, raw->data());
+                }
+                res.check("ParallelReader: Could not read chunk");
+            }
+
+            group.submit([=, &pipeline] {
+                pipeline.decode(filters, *raw, chunk_bytes);
+                if (raw->size() < chunk_bytes) {
+                    throw std::runtime_error("ParallelReader: Decoded chunk is too small");
+                }
+                util::copyBlock(raw->data(), chunk_shape, src_off, out, count, dst_off, box, esize);
+            });
+        }
+
+        group.wait();
+    }
+
+    if (convert) {
+        std::lock_guard<std::mutex> lock(libraryLock());
+        h5x::DataType out_mem_type = data_type_to_h5_memtype(dtype);
+        HErr res = H5Tconvert(native_mem_type.h5id(), out_mem_type.h5id(), nelms, out, nullptr, H5P_DEFAULT);
+        res.check("ParallelReader: Could not convert data");
+        std::memcpy(buffer, out, nelms * out_esize);
+    }
+
+    return true;
+}
+
+#else
+
+bool ParallelReader::read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const {
+    // direct chunk reads are not available
+    return false;
+}
+
+#endif
+
+} // namespace hdf5
+} // namespace nix
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/hdf5/PropertyHDF5.hpp>
+#include <nix/hdf5/UpdateLog.hpp>
 
 #include <nix/util/util.hpp>
 
@@ -45,12 +46,11 @@ namespace hdf5 {
         throw EmptyString("name");
     } else {
         dataset.setAttr("name", name);
-        forceUpdatedAt();
     }
     
     dataset.setAttr("entity_id", id);
-    setUpdatedAt();
     forceCreatedAt(time);
+    UpdateLog::markUpdated(dataset, util::getTime());
 }
 
 
@@ -69,23 +69,29 @@ string PropertyHDF5::id() const {
 
 
 time_t PropertyHDF5::updatedAt() const {
+    time_t pending;
+    if (UpdateLog::pending(dataset(), pending)) {
+        return pending;
+    }
+
     string t;
-    dataset().getAttr("updated_at", t);
+    if (!dataset().getAttr("updated_at", t)) {
+        dataset().getAttr("created_at", t);
+    }
     return util::strToTime(t);
 }
 
 
 void PropertyHDF5::setUpdatedAt() {
-    if (!dataset().hasAttr("updated_at")) {
-        time_t t = util::getTime();
-        dataset().setAttr("updated_at", util::timeToStr(t));
+    time_t t;
+    if (!UpdateLog::pending(dataset(), t) && !dataset().hasAttr("updated_at")) {
+        UpdateLog::markUpdated(dataset(), util::getTime());
     }
 }
 
 
 void PropertyHDF5::forceUpdatedAt() {
-    time_t t = util::getTime();
-    dataset().setAttr("updated_at", util::timeToStr(t));
+    UpdateLog::markUpdated(dataset(), util::getTime());
 }
 
 
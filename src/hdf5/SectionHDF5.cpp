@@ -14,6 +14,10 @@
 #include <nix/Section.hpp>
 
 #include <nix/hdf5/PropertyHDF5.hpp>
+#include <nix/hdf5/MetadataIndex.hpp>
+
+#include <functional>
+#include <unordered_map>
 
 using namespace std;
 using namespace nix::base;
@@ -167,6 +171,11 @@ void SectionHDF5::mapping(const none_t t) {
     forceUpdatedAt();
 }
 
+void SectionHDF5::type(const string &type) {
+    NamedEntityHDF5::type(type);
+    MetadataIndex::invalidate(group());
+}
+
 //--------------------------------------------------
 // Methods for parent access
 //--------------------------------------------------
@@ -198,7 +207,7 @@ shared_ptr<ISection> SectionHDF5::getSection(const string &name_or_id) const {
     boost::optional<Group> g = section_group();
 
     if(g) {
-        boost::optional<Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<Group> group = section_index.findGroupByNameOrId(*g, name_or_id);
         if (group) {
             auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
             section = make_shared<SectionHDF5>(file(), p, *group);
@@ -216,6 +225,24 @@ shared_ptr<ISection> SectionHDF5::getSection(size_t index) const {
 }
 
 
+vector<shared_ptr<ISection>> SectionHDF5::sections() const {
+    vector<shared_ptr<ISection>> sections;
+    boost::optional<Group> g = section_group();
+
+    if (g) {
+        auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
+        g->visitLinks([&](const Link &link) {
+            if (link.type == H5O_TYPE_GROUP) {
+                sections.push_back(make_shared<SectionHDF5>(file(), p, g->openGroup(link.name, false)));
+            }
+            return true;
+        }, true);
+    }
+
+    return sections;
+}
+
+
 shared_ptr<ISection> SectionHDF5::createSection(const string &name, const string &type) {
     if (hasSection(name)) {
         throw DuplicateName("createSection");
@@ -225,7 +252,11 @@ shared_ptr<ISection> SectionHDF5::createSection(const string &name, const string
 
     auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
     Group grp = g->openGroup(name, true);
-    return make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
+    auto section = make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
+    section_index.add(*g, new_id, name);
+    MetadataIndex::invalidate(group());
+
+    return section;
 }
 
 
@@ -243,7 +274,9 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
                 section.deleteSection(child.id());
             }
             // if hasSection is true then section_group always exists
+            section_index.remove(*g, section.id(), section.name());
             deleted = g->removeAllLinks(section.name());
+            MetadataIndex::invalidate(group());
         }
     }
 
@@ -251,6 +284,47 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
 }
 
 
+vector<pair<shared_ptr<ISection>, size_t>> SectionHDF5::querySections(const SectionQuery &query,
+                                                                       size_t max_depth) const {
+    vector<pair<shared_ptr<ISection>, size_t>> results;
+    shared_ptr<const MetadataIndex> index = MetadataIndex::get(group());
+
+    size_t start = index->find(id());
+    if (start == MetadataIndex::npos) {
+        // the tree was changed behind our back, e.g. by another handle of the file
+        MetadataIndex::invalidate(group());
+        index = MetadataIndex::get(group());
+        start = index->find(id());
+        if (start == MetadataIndex::npos) {
+            return results;
+        }
+    }
+
+    // handles are created top-down from this section, so that every section gets its parent
+    unordered_map<size_t, shared_ptr<SectionHDF5>> handles;
+    handles[start] = const_pointer_cast<SectionHDF5>(shared_from_this());
+
+    function<shared_ptr<SectionHDF5>(size_t)> handle = [&](size_t pos) {
+        auto it = handles.find(pos);
+        if (it != handles.end()) {
+            return it->second;
+        }
+
+        const MetadataIndex::Node &node = index->node(pos);
+        shared_ptr<SectionHDF5> parent = handle(node.parent);
+        Group grp = parent->group().openGroup("sections", false).openGroup(node.link, false);
+        auto section = make_shared<SectionHDF5>(file(), parent, grp);
+        handles[pos] = section;
+        return section;
+    };
+
+    for (const auto &match : index->query(start, query, max_depth)) {
+        results.emplace_back(handle(match.first), match.second);
+    }
+
+    return results;
+}
+
 //--------------------------------------------------
 // Methods for property access
 //--------------------------------------------------
@@ -272,7 +346,7 @@ shared_ptr<IProperty> SectionHDF5::getProperty(const string &name_or_id) const {
     boost::optional<Group> g = property_group();
 
     if (g) {
-        boost::optional<DataSet> dset = g->findDataByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<DataSet> dset = property_index.findDataByNameOrId(*g, name_or_id);
         if (dset)
             prop = make_shared<PropertyHDF5>(file(), *dset);
     }
@@ -288,6 +362,23 @@ shared_ptr<IProperty> SectionHDF5::getProperty(size_t index) const {
 }
 
 
+vector<shared_ptr<IProperty>> SectionHDF5::properties() const {
+    vector<shared_ptr<IProperty>> properties;
+    boost::optional<Group> g = property_group();
+
+    if (g) {
+        g->visitLinks([&](const Link &link) {
+            if (link.type == H5O_TYPE_DATASET) {
+                properties.push_back(make_shared<PropertyHDF5>(file(), g->openData(link.name)));
+            }
+            return true;
+        }, true);
+    }
+
+    return properties;
+}
+
+
 shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const DataType &dtype) {
     if (hasProperty(name)) {
         throw DuplicateName("hasProperty");
@@ -297,8 +388,11 @@ shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const Data
 
     h5x::DataType fileType = DataSet::fileTypeForValue(dtype);
     DataSet dataset = g->createData(name, fileType, {0});
+    auto prop = make_shared<PropertyHDF5>(file(), dataset, new_id, name);
+    property_index.add(*g, new_id, name);
+    MetadataIndex::invalidate(group());
 
-    return make_shared<PropertyHDF5>(file(), dataset, new_id, name);
+    return prop;
 }
 
 
@@ -328,7 +422,10 @@ bool SectionHDF5::deleteProperty(const string &name_or_id) {
     bool deleted = false;
 
     if (g && hasProperty(name_or_id)) {
-        g->removeData(getProperty(name_or_id)->name());
+        shared_ptr<IProperty> prop = getProperty(name_or_id);
+        property_index.remove(*g, prop->id(), prop->name());
+        g->removeData(prop->name());
+        MetadataIndex::invalidate(group());
         deleted = true;
     }
 
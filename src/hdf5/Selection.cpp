@@ -29,6 +29,61 @@ void Selection::select(const NDSize &count, const NDSize &start, Mode mode)
 }
 
 
+void Selection::select(const NDSize &count, const NDSize &start, const NDSize &stride, const NDSize &block,
+                       Mode mode)
+{
+    H5S_seloper_t op = static_cast<H5S_seloper_t>(mode);
+    HErr status = H5Sselect_hyperslab(space.h5id(), op, start.data(), stride.data(), count.data(), block.data());
+    status.check("Selection::select(): Could not select hyperslab");
+}
+
+
+void Selection::select(const std::vector<NDSize> &points)
+{
+    const size_t rank = this->rank();
+    std::vector<hsize_t> coords;
+    coords.reserve(points.size() * rank);
+
+    for (const NDSize &p : points) {
+        coords.insert(coords.end(), p.data(), p.data() + p.size());
+    }
+
+    HErr status = H5Sselect_elements(space.h5id(), H5S_SELECT_SET, points.size(), coords.data());
+    status.check("Selection::select(): Could not select points");
+}
+
+
+void Selection::select(const DataSelection &selection)
+{
+    if (!selection.points().empty()) {
+        select(selection.points());
+        return;
+    }
+
+    if (selection.hyperslabs().empty()) {
+        HErr status = H5Sselect_none(space.h5id());
+        status.check("Selection::select(): Could not reset selection");
+        return;
+    }
+
+    Mode mode = Mode::Set;
+    for (const Hyperslab &slab : selection.hyperslabs()) {
+        select(slab.count, slab.start, slab.stride, slab.block, mode);
+        mode = Mode::Or;
+    }
+}
+
+
+ndsize_t Selection::npoints() const
+{
+    hssize_t n = H5Sget_select_npoints(space.h5id());
+    if (n < 0) {
+        throw H5Exception("Selection::npoints(): Could not get number of selected elements");
+    }
+    return static_cast<ndsize_t>(n);
+}
+
+
 NDSize Selection::size() const
 {
     size_t rank = this->rank();
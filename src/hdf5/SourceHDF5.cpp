@@ -9,6 +9,9 @@
 #include <nix/util/util.hpp>
 #include <nix/hdf5/SourceHDF5.hpp>
 #include <nix/Source.hpp>
+#include <nix/hdf5/HandleCache.hpp>
+
+#include <limits>
 
 using namespace std;
 using namespace nix::base;
@@ -37,6 +40,62 @@ SourceHDF5::SourceHDF5(const shared_ptr<IFile> &file, const Group &group, const
 }
 
 
+shared_ptr<SourceHDF5> SourceHDF5::fromIndex(const shared_ptr<IFile> &file, const LocID &loc,
+                                             const SourceIndex::Node &node) {
+    shared_ptr<SourceHDF5> source = HandleCache::find<SourceHDF5>(node.address);
+
+    if (!source) {
+        Group group(H5Gopen(loc.h5id(), node.path.c_str(), H5P_DEFAULT));
+        group.check("SourceHDF5::fromIndex: Could not open source " + node.path);
+        source = make_shared<SourceHDF5>(file, group);
+        HandleCache::add(node.address, source);
+    }
+
+    return source;
+}
+
+
+void SourceHDF5::deleteDescendants(const LocID &loc, const string &id) {
+    shared_ptr<const SourceIndex> index = SourceIndex::get(loc);
+
+    size_t start = index->find(id);
+    if (start == SourceIndex::npos) {
+        // the tree was changed behind our back, e.g. by another handle of the file
+        SourceIndex::invalidate(loc);
+        index = SourceIndex::get(loc);
+        start = index->find(id);
+        if (start == SourceIndex::npos) {
+            return;
+        }
+    }
+
+    auto subtree = index->query(start, SourceQuery(), numeric_limits<size_t>::max());
+
+    // deepest first, so that the parent of every source is still linked when it is removed
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        if (it->first == start) {
+            continue;
+        }
+
+        const SourceIndex::Node &node = index->node(it->first);
+        const SourceIndex::Node &parent = index->node(node.parent);
+
+        Group parent_group(H5Gopen(loc.h5id(), parent.path.c_str(), H5P_DEFAULT));
+        parent_group.check("SourceHDF5::deleteDescendants: Could not open source " + parent.path);
+        Group container = parent_group.openGroup("sources", false);
+
+        EntityIndex().remove(container, node.id, node.link);
+        container.removeAllLinks(node.link);
+    }
+}
+
+
+void SourceHDF5::type(const string &type) {
+    NamedEntityHDF5::type(type);
+    SourceIndex::invalidate(group());
+}
+
+
 bool SourceHDF5::hasSource(const string &name_or_id) const {
     return getSource(name_or_id) != nullptr;
 }
@@ -47,7 +106,7 @@ shared_ptr<ISource> SourceHDF5::getSource(const string &name_or_id) const {
     boost::optional<Group> g = source_group();
 
     if (g) {
-        boost::optional<Group> group = g->findGroupByNameOrAttribute("entity_id", name_or_id);
+        boost::optional<Group> group = source_index.findGroupByNameOrId(*g, name_or_id);
         if (group)
             source = make_shared<SourceHDF5>(file(), *group);
     }
@@ -63,6 +122,13 @@ shared_ptr<ISource> SourceHDF5::getSource(size_t index) const {
 }
 
 
+vector<shared_ptr<ISource>> SourceHDF5::sources() const {
+    return HandleCache::all<ISource, SourceHDF5>(source_group(), [this](const Group &grp) {
+        return make_shared<SourceHDF5>(file(), grp);
+    });
+}
+
+
 ndsize_t SourceHDF5::sourceCount() const {
     boost::optional<Group> g = source_group(false);
     return g ? g->objectCount() : size_t(0);
@@ -81,25 +147,31 @@ shared_ptr<ISource> SourceHDF5::createSource(const string &name, const string &t
 
 
     Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), group, id, type, name);
+    auto source = make_shared<SourceHDF5>(file(), group, id, type, name);
+    HandleCache::add(group.address(), source);
+    source_index.add(*g, id, name);
+    SourceIndex::invalidate(group);
+
+    return source;
 }
 
 
 bool SourceHDF5::deleteSource(const string &name_or_id) {
     boost::optional<Group> g = source_group();
     bool deleted = false;
-    
-    if(g) {
-        // call deleteSource on sources to trigger recursive call to all sub-sources
-        if (hasSource(name_or_id)) {
-            // get instance of source about to get deleted
-            Source source = getSource(name_or_id);
-            // loop through all child sources and call deleteSource on them
-            for(auto &child : source.sources()) {
-                source.deleteSource(child.id());
-            }
-            // if hasSource is true then source_group always exists
-            deleted = g->removeAllLinks(source.name());
+
+    if (g) {
+        boost::optional<Group> group = source_index.findGroupByNameOrId(*g, name_or_id);
+        if (group) {
+            string id, name;
+            group->getAttr("entity_id", id);
+            group->getAttr("name", name);
+
+            // the sub-sources are removed with a single pass over the indexed tree
+            deleteDescendants(this->group(), id);
+            source_index.remove(*g, id, name);
+            deleted = g->removeAllLinks(name);
+            SourceIndex::invalidate(this->group());
         }
     }
 
@@ -107,6 +179,30 @@ bool SourceHDF5::deleteSource(const string &name_or_id) {
 }
 
 
+vector<pair<shared_ptr<ISource>, size_t>> SourceHDF5::querySources(const SourceQuery &query,
+                                                                     size_t max_depth) const {
+    vector<pair<shared_ptr<ISource>, size_t>> results;
+    shared_ptr<const SourceIndex> index = SourceIndex::get(group());
+
+    size_t start = index->find(id());
+    if (start == SourceIndex::npos) {
+        // the tree was changed behind our back, e.g. by another handle of the file
+        SourceIndex::invalidate(group());
+        index = SourceIndex::get(group());
+        start = index->find(id());
+        if (start == SourceIndex::npos) {
+            return results;
+        }
+    }
+
+    for (const auto &match : index->query(start, query, max_depth)) {
+        results.emplace_back(fromIndex(file(), group(), index->node(match.first)), match.second);
+    }
+
+    return results;
+}
+
+
 SourceHDF5::~SourceHDF5() {}
 
 } // ns nix::hdf5
@@ -0,0 +1,292 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/SourceIndex.hpp>
+
+#include <nix/hdf5/ExceptionHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+
+#include <deque>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+// parts of the file state, so that all handles of a file share one index
+typedef FileState::Lazy<SourceIndex> source_index;
+typedef FileState::Lazy<SourceReferences> source_references;
+
+
+struct PendingSource {
+    Group container;
+    std::string link;
+    std::string path;
+    ObjectAddress address;
+    std::string block;
+    size_t parent;
+    size_t depth;
+};
+
+
+void push_sources(std::deque<PendingSource> &todo, const Group &container, const std::string &path,
+                  const std::string &block, size_t parent, size_t depth) {
+    container.visitLinks([&](const Link &link) {
+        if (link.type == H5O_TYPE_GROUP) {
+            todo.push_back(PendingSource{container, link.name, path + "/" + link.name, link.address,
+                                         block, parent, depth});
+        }
+        return true;
+    }, true);
+}
+
+} // anonymous namespace
+
+
+const size_t SourceIndex::npos;
+
+
+std::shared_ptr<const SourceIndex> SourceIndex::get(const LocID &obj) {
+    // built without holding the lock, the index is immutable once published
+    return FileState::get<source_index>(obj)->get([&obj]() {
+        auto index = std::make_shared<SourceIndex>();
+        Group root(H5Gopen(obj.h5id(), "/", H5P_DEFAULT));
+        root.check("SourceIndex: Could not open root group");
+        if (root.hasGroup("data")) {
+            index->build(root.openGroup("data", false));
+        }
+        return index;
+    });
+}
+
+
+void SourceIndex::invalidate(const LocID &file) {
+    std::shared_ptr<source_index> index = FileState::find<source_index>(file);
+    if (index) {
+        index->invalidate();
+    }
+}
+
+
+void SourceIndex::build(const Group &data) {
+    std::deque<PendingSource> todo;
+
+    data.visitLinks([&](const Link &link) {
+        if (link.type != H5O_TYPE_GROUP) {
+            return true;
+        }
+
+        Group block = data.openGroup(link.name, false);
+        std::string block_id;
+        block.getAttr("entity_id", block_id);
+
+        if (block.hasGroup("sources")) {
+            push_sources(todo, block.openGroup("sources", false), "/data/" + link.name + "/sources",
+                         block_id, npos, 0);
+        }
+        return true;
+    }, true);
+
+    // breadth-first, so that the positions of the nodes are in breadth-first order
+    while (!todo.empty()) {
+        PendingSource current = todo.front();
+        todo.pop_front();
+
+        Group group = current.container.openGroup(current.link, false);
+        size_t pos = nodes.size();
+
+        Node node;
+        group.getAttr("entity_id", node.id);
+        group.getAttr("name", node.name);
+        group.getAttr("type", node.type);
+        node.link = current.link;
+        node.block = current.block;
+        node.path = current.path;
+        node.address = current.address;
+        node.parent = current.parent;
+        node.depth = current.depth;
+
+        by_id[node.id] = pos;
+        by_name[node.name].push_back(pos);
+        by_type[node.type].push_back(pos);
+        if (current.parent != npos) {
+            nodes[current.parent].children.push_back(pos);
+        } else {
+            by_block[node.block].push_back(pos);
+        }
+        nodes.push_back(std::move(node));
+
+        if (group.hasGroup("sources")) {
+            push_sources(todo, group.openGroup("sources", false), current.path + "/sources",
+                         current.block, pos, current.depth + 1);
+        }
+    }
+}
+
+
+size_t SourceIndex::find(const std::string &id) const {
+    auto it = by_id.find(id);
+    return it != by_id.end() ? it->second : npos;
+}
+
+
+const std::vector<size_t> &SourceIndex::roots(const std::string &block_id) const {
+    static const std::vector<size_t> none;
+    auto it = by_block.find(block_id);
+    return it != by_block.end() ? it->second : none;
+}
+
+
+std::vector<std::pair<size_t, size_t>> SourceIndex::query(size_t start, const base::SourceQuery &query,
+                                                          size_t max_depth) const {
+    std::vector<std::pair<size_t, size_t>> result;
+    const Node &root = nodes.at(start);
+
+    // the smallest posting list of the query restricts the candidates
+    std::vector<size_t> id_match;
+    const std::vector<size_t> *candidates = nullptr;
+    auto restrict = [&candidates](const PostingMap &map, const std::string &key) {
+        static const std::vector<size_t> no_match;
+        auto it = map.find(key);
+        const std::vector<size_t> *list = it != map.end() ? &it->second : &no_match;
+        if (!candidates || list->size() < candidates->size()) {
+            candidates = list;
+        }
+    };
+
+    if (!query.id.empty()) {
+        size_t pos = find(query.id);
+        if (pos != npos) {
+            id_match.push_back(pos);
+        }
+        candidates = &id_match;
+    }
+    if (!query.name.empty()) {
+        restrict(by_name, query.name);
+    }
+    if (!query.type.empty()) {
+        restrict(by_type, query.type);
+    }
+
+    if (!candidates) {
+        // plain breadth-first traversal of the subtree
+        std::deque<size_t> todo = {start};
+        while (!todo.empty()) {
+            size_t pos = todo.front();
+            todo.pop_front();
+
+            size_t depth = nodes[pos].depth - root.depth;
+            result.emplace_back(pos, depth);
+            if (depth < max_depth) {
+                todo.insert(todo.end(), nodes[pos].children.begin(), nodes[pos].children.end());
+            }
+        }
+        return result;
+    }
+
+    // positions are in breadth-first order, so the candidates are as well
+    for (size_t pos : *candidates) {
+        const Node &node = nodes[pos];
+        if (node.block != root.block || node.depth < root.depth || node.depth - root.depth > max_depth) {
+            continue;
+        }
+        if ((!query.id.empty() && node.id != query.id) ||
+            (!query.name.empty() && node.name != query.name) ||
+            (!query.type.empty() && node.type != query.type)) {
+            continue;
+        }
+
+        size_t ancestor = pos;
+        for (size_t d = node.depth; d > root.depth; d--) {
+            ancestor = nodes[ancestor].parent;
+        }
+        if (ancestor == start) {
+            result.emplace_back(pos, node.depth - root.depth);
+        }
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------
+// SourceReferences
+//--------------------------------------------------
+
+
+std::shared_ptr<const SourceReferences> SourceReferences::get(const LocID &obj) {
+    return FileState::get<source_references>(obj)->get([&obj]() {
+        auto map = std::make_shared<SourceReferences>();
+        Group root(H5Gopen(obj.h5id(), "/", H5P_DEFAULT));
+        root.check("SourceReferences: Could not open root group");
+        if (root.hasGroup("data")) {
+            map->build(root.openGroup("data", false));
+        }
+        return map;
+    });
+}
+
+
+void SourceReferences::invalidate(const LocID &file) {
+    std::shared_ptr<source_references> map = FileState::find<source_references>(file);
+    if (map) {
+        map->invalidate();
+    }
+}
+
+
+void SourceReferences::build(const Group &data) {
+    data.visitLinks([&](const Link &link) {
+        if (link.type != H5O_TYPE_GROUP) {
+            return true;
+        }
+
+        Group block = data.openGroup(link.name, false);
+        addReferences(block, "data_arrays", &References::data_arrays);
+        addReferences(block, "tags", &References::tags);
+        addReferences(block, "multi_tags", &References::multi_tags);
+        return true;
+    }, true);
+}
+
+
+void SourceReferences::addReferences(const Group &block, const std::string &container,
+                                       std::vector<Referrer> References::*list) {
+    if (!block.hasGroup(container)) {
+        return;
+    }
+
+    Group entities = block.openGroup(container, false);
+    entities.visitLinks([&](const Link &link) {
+        if (link.type != H5O_TYPE_GROUP) {
+            return true;
+        }
+
+        Group entity = entities.openGroup(link.name, false);
+        if (entity.hasGroup("sources")) {
+            // the links to the sources of an entity are named by the ids of the sources
+            Referrer referrer{link.name, link.address};
+            entity.openGroup("sources", false).visitLinks([&](const Link &source) {
+                (refs[source.name].*list).push_back(referrer);
+                return true;
+            });
+        }
+        return true;
+    }, true);
+}
+
+
+const SourceReferences::References &SourceReferences::of(const std::string &source_id) const {
+    static const References none;
+    auto it = refs.find(source_id);
+    return it != refs.end() ? it->second : none;
+}
+
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,104 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hdf5/UpdateLog.hpp>
+#include <nix/hdf5/AttributeCache.hpp>
+#include <nix/hdf5/FileState.hpp>
+#include <nix/util/util.hpp>
+
+#include <map>
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+struct log_entry {
+    LocID  obj;
+    time_t time;
+};
+
+// part of the file state
+struct update_log {
+    std::mutex lock;
+    std::map<haddr_t, log_entry> entries;
+};
+
+
+void write_update(const ObjectAddress &address, const LocID &obj, time_t time) {
+    std::string t = util::timeToStr(time);
+    obj.setAttr("updated_at", t);
+    AttributeCache::update(address, "updated_at", t);
+}
+
+} // anonymous namespace
+
+
+void UpdateLog::markUpdated(const LocID &obj, time_t time) {
+    ObjectAddress address = obj.address();
+
+    // there is nothing that would flush the log of other files
+    if (!FileState::exists(address.first)) {
+        write_update(address, obj, time);
+        return;
+    }
+
+    std::shared_ptr<update_log> log = FileState::get<update_log>(address.first);
+    std::lock_guard<std::mutex> guard(log->lock);
+
+    auto it = log->entries.find(address.second);
+    if (it != log->entries.end()) {
+        it->second.time = time;
+    } else {
+        log->entries.emplace(address.second, log_entry{obj, time});
+    }
+}
+
+
+bool UpdateLog::pending(const LocID &obj, time_t &time) {
+    ObjectAddress address = obj.address();
+
+    std::shared_ptr<update_log> log = FileState::find<update_log>(address.first);
+    if (!log) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(log->lock);
+    auto it = log->entries.find(address.second);
+    if (it == log->entries.end()) {
+        return false;
+    }
+
+    time = it->second.time;
+    return true;
+}
+
+
+void UpdateLog::flush(const LocID &file) {
+    unsigned long fileno = file.address().first;
+
+    std::shared_ptr<update_log> log = FileState::find<update_log>(fileno);
+    if (!log) {
+        return;
+    }
+
+    // take the entries out first, so a failed write does not leave them behind
+    std::map<haddr_t, log_entry> flushing;
+    {
+        std::lock_guard<std::mutex> guard(log->lock);
+        flushing.swap(log->entries);
+    }
+
+    for (const auto &entry : flushing) {
+        write_update(ObjectAddress(fileno, entry.first), entry.second.obj, entry.second.time);
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <algorithm>
+#include <numeric>
 
 #include <boost/optional.hpp>
 
@@ -22,6 +23,176 @@ using namespace std;
 namespace nix {
 namespace util {
 
+namespace {
+
+// Converts positions into indices along one dimension like positionToIndex()
+// does, but reads the dimension descriptor and resolves the units only once.
+class DimensionIndexer {
+
+public:
+
+    DimensionIndexer(const Dimension &dimension, const string &unit);
+
+    size_t operator()(double position) const;
+
+    vector<size_t> operator()(const vector<double> &positions) const;
+
+private:
+
+    DimensionType type;
+    double scaling = 1.0;
+    double offset = 0.0;
+    double sampling_interval = 1.0;
+    size_t label_count = 0;
+    SampledDimension sampled;
+    RangeDimension range;
+};
+
+
+DimensionIndexer::DimensionIndexer(const Dimension &dimension, const string &unit)
+    : type(dimension.dimensionType())
+{
+    if (type == DimensionType::Sample) {
+        sampled = dimension;
+        boost::optional<string> dim_unit = sampled.unit();
+        if (!dim_unit && unit != "none") {
+            throw nix::IncompatibleDimensions("Units of position and SampledDimension must both be given!", "nix::util::retrieveData");
+        }
+        if (dim_unit && unit != "none") {
+            try {
+                scaling = util::getSIScaling(unit, *dim_unit);
+            } catch (...) {
+                throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::retrieveData");
+            }
+        }
+        offset = sampled.offset() ? *sampled.offset() : 0.0;
+        sampling_interval = sampled.samplingInterval();
+    } else if (type == DimensionType::Set) {
+        if (unit.length() > 0 && unit != "none") {
+            throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::retrieveData");
+        }
+        SetDimension dim;
+        dim = dimension;
+        label_count = dim.labels().size();
+    } else {
+        range = dimension;
+        boost::optional<string> dim_unit = range.unit();
+        if (dim_unit && unit != "none") {
+            try {
+                scaling = util::getSIScaling(unit, *dim_unit);
+            } catch (...) {
+                throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::retrieveData");
+            }
+        }
+    }
+}
+
+
+size_t DimensionIndexer::operator()(double position) const {
+    if (type == DimensionType::Sample) {
+        ssize_t index = static_cast<ssize_t>(round((position * scaling - offset) / sampling_interval));
+        if (index < 0) {
+            throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+        }
+        return static_cast<size_t>(index);
+    } else if (type == DimensionType::Set) {
+        size_t index = static_cast<size_t>(round(position));
+        if (label_count > 0 && index > label_count) {
+            throw nix::OutOfBounds("Position is out of bounds in setDimension.", static_cast<int>(position));
+        }
+        return index;
+    }
+
+    return range.indexOf(position * scaling);
+}
+
+
+vector<size_t> DimensionIndexer::operator()(const vector<double> &positions) const {
+    if (type == DimensionType::Set) {
+        vector<size_t> indices(positions.size());
+        transform(positions.begin(), positions.end(), indices.begin(), [this](double p) { return (*this)(p); });
+        return indices;
+    }
+
+    vector<double> scaled(positions.size());
+    transform(positions.begin(), positions.end(), scaled.begin(), [this](double p) { return p * scaling; });
+    return type == DimensionType::Sample ? sampled.indexOf(scaled) : range.indexOf(scaled);
+}
+
+
+// Reads the slices given by origins and counts into the buffer of the result.
+// Slices close to each other are read together with a single read of their
+// bounding box, as long as the box is not much larger than the slices.
+void readSlices(const DataArray &array, MultiTagData &result) {
+    const size_t n = result.origins.size();
+    const size_t rank = array.dataExtent().size();
+    const DataType dtype = result.data.dtype();
+    const size_t esize = data_type_to_size(dtype);
+    const ndsize_t slack = 4096;
+    char *buffer = reinterpret_cast<char *>(result.data.data());
+
+    vector<size_t> order(n);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&result](size_t a, size_t b) {
+        return result.origins[a][0] < result.origins[b][0];
+    });
+
+    size_t begin = 0;
+    while (begin < n) {
+        NDSize lo = result.origins[order[begin]];
+        NDSize hi = lo + result.counts[order[begin]];
+        ndsize_t used = result.counts[order[begin]].nelms();
+
+        size_t end = begin + 1;
+        for (; end < n; end++) {
+            const NDSize &origin = result.origins[order[end]];
+            const NDSize &count = result.counts[order[end]];
+            NDSize box_lo(rank), box_hi(rank), box(rank);
+            for (size_t d = 0; d < rank; d++) {
+                box_lo[d] = min(lo[d], origin[d]);
+                box_hi[d] = max(hi[d], origin[d] + count[d]);
+                box[d] = box_hi[d] - box_lo[d];
+            }
+
+            if (box.nelms() > 2 * (used + count.nelms()) + slack) {
+                break;
+            }
+
+            lo = box_lo;
+            hi = box_hi;
+            used += count.nelms();
+        }
+
+        if (end - begin == 1) {
+            size_t k = order[begin];
+            array.getData(dtype, buffer + result.offsets[k] * esize, result.counts[k], result.origins[k]);
+        } else {
+            NDSize box(rank);
+            for (size_t d = 0; d < rank; d++) {
+                box[d] = hi[d] - lo[d];
+            }
+
+            vector<char> tmp(box.nelms() * esize);
+            array.getData(dtype, tmp.data(), box, lo);
+
+            for (size_t i = begin; i < end; i++) {
+                size_t k = order[i];
+                NDSize src_offset(rank);
+                for (size_t d = 0; d < rank; d++) {
+                    src_offset[d] = result.origins[k][d] - lo[d];
+                }
+                copyBlock(tmp.data(), box, src_offset,
+                          buffer + result.offsets[k] * esize, result.counts[k], NDSize(rank, 0),
+                          result.counts[k], esize);
+            }
+        }
+
+        begin = end;
+    }
+}
+
+} // anonymous namespace
+
 
 int positionToIndex(double position, const string &unit, const Dimension &dimension) {
     size_t pos;
@@ -43,8 +214,8 @@ int positionToIndex(double position, const string &unit, const Dimension &dimens
 }
 
 
-size_t positionToIndex(double position, const string &unit, const SampledDimension &dimension) {
-    size_t index;
+// The factor that converts positions given in unit into the unit of the dimension
+static double sampledScaling(const string &unit, const SampledDimension &dimension) {
     boost::optional<string> dim_unit = dimension.unit();
     double scaling = 1.0;
     if (!dim_unit && unit != "none") {
@@ -57,8 +228,24 @@ size_t positionToIndex(double position, const string &unit, const SampledDimensi
             throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
         }
     }
-    index = dimension.indexOf(position * scaling); 
-    return index;
+    return scaling;
+}
+
+
+size_t positionToIndex(double position, const string &unit, const SampledDimension &dimension) {
+    return dimension.indexOf(position * sampledScaling(unit, dimension));
+}
+
+
+vector<size_t> positionToIndex(const vector<double> &positions, const string &unit, const SampledDimension &dimension) {
+    const double scaling = sampledScaling(unit, dimension);
+
+    vector<double> scaled(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        scaled[i] = positions[i] * scaling;
+    }
+
+    return dimension.indexOf(scaled);
 }
 
 
@@ -102,10 +289,16 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
         throw std::runtime_error("Dimensionality of position or extent vector does not match dimensionality of data!");
     }
     for (size_t i = 0; i < position.size(); ++i) {
-        Dimension dim = array.getDimension(i+1);
-        temp_offset[i] = positionToIndex(position[i], i >= units.size() ? "none" : units[i], dim);
+        DimensionIndexer indexer(array.getDimension(i+1), i >= units.size() ? "none" : units[i]);
+        vector<double> bounds = {position[i]};
+        if (i < extent.size()) {
+            bounds.push_back(position[i] + extent[i]);
+        }
+
+        vector<size_t> indices = indexer(bounds);
+        temp_offset[i] = indices[0];
         if (i < extent.size()) {
-            ndsize_t c = positionToIndex(position[i] + extent[i], i >= units.size() ? "none" : units[i], dim) - temp_offset[i];
+            ndsize_t c = indices[1] - temp_offset[i];
             temp_count[i] = (c > 1) ? c : 1;
         }
     }
@@ -159,26 +352,23 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index
     NDSize data_offset(dimension_count, static_cast<size_t>(0));
     NDSize data_count(dimension_count, static_cast<size_t>(1));
     vector<string> units = tag.units();
-    
-    for (size_t i = 0; i < offset.size(); ++i) {
-        Dimension dimension = array.getDimension(i+1);
-        string unit = "none";
-        if (i <= units.size() && units.size() > 0) {
-            unit = units[i];
-        }
-        data_offset[i] = positionToIndex(offset[i], unit, dimension);
-    }
-    
+
+    vector<double> extent;
     if (extents) {
-        vector<double> extent;
         extents.getData(extent, temp_count, temp_offset);
-        for (size_t i = 0; i < extent.size(); ++i) {
-            Dimension dimension = array.getDimension(i+1);
-            string unit = "none";
-            if (i <= units.size() && units.size() > 0) {
-                unit = units[i];
-            }
-            ndsize_t c = positionToIndex(offset[i] + extent[i], unit, dimension) - data_offset[i];
+    }
+
+    for (size_t i = 0; i < offset.size(); ++i) {
+        DimensionIndexer indexer(array.getDimension(i+1), i < units.size() ? units[i] : "none");
+        vector<double> bounds = {offset[i]};
+        if (i < extent.size()) {
+            bounds.push_back(offset[i] + extent[i]);
+        }
+
+        vector<size_t> indices = indexer(bounds);
+        data_offset[i] = indices[0];
+        if (i < extent.size()) {
+            ndsize_t c = indices[1] - data_offset[i];
             data_count[i] = (c > 1) ? c : 1;
         }
     }
@@ -248,6 +438,125 @@ DataView retrieveData(const MultiTag &tag, size_t position_index, size_t referen
 }
 
 
+MultiTagData retrieveData(const MultiTag &tag, const vector<ndsize_t> &position_indices,
+                          size_t reference_index, DataType dtype) {
+    DataArray positions = tag.positions();
+    DataArray extents = tag.extents();
+
+    if (tag.referenceCount() == 0) {
+        throw nix::OutOfBounds("There are no references in this tag!", 0);
+    }
+    if (!(reference_index < tag.referenceCount())) {
+        throw nix::OutOfBounds("Reference index out of bounds.", 0);
+    }
+
+    DataArray ref = tag.getReference(reference_index);
+    size_t dimension_count = ref.dimensionCount();
+    NDSize position_size = positions.dataExtent();
+    NDSize extent_size = extents ? extents.dataExtent() : NDSize();
+
+    if (position_size.size() == 1 && dimension_count != 1) {
+        throw nix::IncompatibleDimensions("Number of dimensions in position or extent do not match dimensionality of data",
+                                          "util::retrieveData");
+    } else if (position_size.size() > 1) {
+        if (position_size[1] > dimension_count ||
+            (extents && extent_size.size() > 1 && extent_size[1] > dimension_count)) {
+            throw nix::IncompatibleDimensions("Number of dimensions in position or extent do not match dimensionality of data",
+                                              "util::retrieveData");
+        }
+    }
+
+    MultiTagData result(dtype);
+    if (position_indices.empty()) {
+        return result;
+    }
+
+    ndsize_t first = *min_element(position_indices.begin(), position_indices.end());
+    ndsize_t last = *max_element(position_indices.begin(), position_indices.end());
+    if (last >= position_size[0] || (extents && last >= extent_size[0])) {
+        throw nix::OutOfBounds("Index out of bounds of positions or extents!", 0);
+    }
+
+    // read positions and extents of all requested indices at once
+    size_t columns = position_size.size() > 1 ? position_size[1] : 1;
+    NDSize count(position_size.size(), columns), offset(position_size.size(), 0);
+    count[0] = last - first + 1;
+    offset[0] = first;
+
+    vector<double> position_data(count.nelms()), extent_data;
+    positions.getData(DataType::Double, position_data.data(), count, offset);
+
+    size_t extent_stride = 0, extent_columns = 0;
+    if (extents) {
+        extent_stride = extent_size.size() > 1 ? extent_size[1] : 1;
+        extent_columns = min(extent_stride, columns);
+        NDSize extent_count(extent_size.size(), extent_stride), extent_offset(extent_size.size(), 0);
+        extent_count[0] = last - first + 1;
+        extent_offset[0] = first;
+        extent_data.resize(extent_count.nelms());
+        extents.getData(DataType::Double, extent_data.data(), extent_count, extent_offset);
+    }
+
+    vector<string> units = tag.units();
+    vector<DimensionIndexer> indexers;
+    for (size_t i = 0; i < columns; i++) {
+        indexers.emplace_back(ref.getDimension(i + 1), i < units.size() ? units[i] : "none");
+    }
+
+    // resolve the starts and ends of all positions per dimension at once
+    const size_t n = position_indices.size();
+    vector<vector<size_t>> starts(columns), ends(extent_columns);
+    for (size_t i = 0; i < columns; i++) {
+        vector<double> pos(n), end(i < extent_columns ? n : 0);
+        for (size_t k = 0; k < n; k++) {
+            size_t row = static_cast<size_t>(position_indices[k] - first);
+            pos[k] = position_data[row * columns + i];
+            if (i < extent_columns) {
+                end[k] = pos[k] + extent_data[row * extent_stride + i];
+            }
+        }
+
+        starts[i] = indexers[i](pos);
+        if (i < extent_columns) {
+            ends[i] = indexers[i](end);
+        }
+    }
+
+    NDSize data_extent = ref.dataExtent();
+    ndsize_t total = 0;
+
+    for (size_t k = 0; k < n; k++) {
+        NDSize data_offset(dimension_count, 0);
+        NDSize data_count(dimension_count, 1);
+
+        for (size_t i = 0; i < columns; i++) {
+            data_offset[i] = starts[i][k];
+        }
+
+        for (size_t i = 0; i < extent_columns; i++) {
+            ndsize_t end_index = ends[i][k];
+            data_count[i] = end_index > data_offset[i] + 1 ? end_index - data_offset[i] : 1;
+        }
+
+        for (size_t i = 0; i < dimension_count; i++) {
+            if (data_offset[i] + data_count[i] > data_extent[i]) {
+                throw nix::OutOfBounds("References data slice out of the extent of the DataArray!", 0);
+            }
+        }
+
+        result.offsets.push_back(total);
+        result.origins.push_back(data_offset);
+        result.counts.push_back(data_count);
+        total += data_count.nelms();
+    }
+
+    result.data.resize(NDSize({total}));
+    readSlices(ref, result);
+
+    return result;
+}
+
+
 DataView retrieveData(const Tag &tag, size_t reference_index) {
     vector<double> positions = tag.position();
     vector<double> extents = tag.extent();
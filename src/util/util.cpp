@@ -11,13 +11,17 @@
 #include <nix/base/IDimensions.hpp>
 
 #include <string>
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <mutex>
 #include <random>
+#include <unordered_map>
 #include <math.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/regex.hpp>
 #include <boost/random.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -32,9 +36,9 @@ namespace util {
 // Base32hex alphabet (RFC 4648)
 const char*  ID_ALPHABET = "0123456789abcdefghijklmnopqrstuv";
 // Unit scaling, SI only, substitutions for micro and ohm...
-const string  PREFIXES = "(Y|Z|E|P|T|G|M|k|h|da|d|c|m|u|n|p|f|a|z|y)";
-const string  UNITS = "(m|g|s|A|K|mol|cd|Hz|N|Pa|J|W|C|V|F|S|Wb|T|H|lm|lx|Bq|Gy|Sv|kat|l|L|Ohm|%|dB|rad)";
-const string  POWER = "(\\^[+-]?[1-9]\\d*)";
+const char *PREFIXES[] = {"Y", "Z", "E", "P", "T", "G", "M", "k", "h", "da", "d", "c", "m", "u", "n", "p", "f", "a", "z", "y"};
+const char *UNITS[] = {"m", "g", "s", "A", "K", "mol", "cd", "Hz", "N", "Pa", "J", "W", "C", "V", "F", "S", "Wb", "T", "H",
+    "lm", "lx", "Bq", "Gy", "Sv", "kat", "l", "L", "Ohm", "%", "dB", "rad"};
 
 const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a", 1.0e-18}, {"f", 1.0e-15},
     {"p", 1.0e-12}, {"n",1.0e-9}, {"u", 1.0e-6}, {"m", 1.0e-3}, {"c", 1.0e-2}, {"d",1.0e-1}, {"da", 1.0e1}, {"h", 1.0e2},
@@ -115,35 +119,116 @@ std::string unitSanitizer(const std::string &unit) {
      return new_unit;
 }
 
+namespace {
+
+// An atomic SI unit split into its components, e.g. "mV^2" into "m", "V" and "2"
+struct AtomicUnit {
+    bool valid = false;
+    string prefix;
+    string unit;
+    string power;
+};
+
+
+// Matches "^" [+-] [1-9] [0-9]* up to the end
+bool isPower(const char *s, const char *end) {
+    if (s == end || *s++ != '^') {
+        return false;
+    }
+    if (s != end && (*s == '+' || *s == '-')) {
+        s++;
+    }
+    if (s == end || *s < '1' || *s > '9') {
+        return false;
+    }
+    while (++s != end) {
+        if (*s < '0' || *s > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Length of tok if [s, end) starts with it, 0 otherwise
+size_t startsWith(const char *s, const char *end, const char *tok) {
+    size_t n = strlen(tok);
+    return static_cast<size_t>(end - s) >= n && strncmp(s, tok, n) == 0 ? n : 0;
+}
+
+
+// Parses [s, end) as prefix? unit power?, preferring a prefix like the
+// greedy pattern would
+AtomicUnit parseAtomic(const char *s, const char *end) {
+    AtomicUnit res;
+
+    const size_t nprefixes = sizeof(PREFIXES) / sizeof(PREFIXES[0]);
+    for (size_t p = 0; p <= nprefixes; p++) {
+        size_t plen = 0;
+        if (p < nprefixes) {
+            plen = startsWith(s, end, PREFIXES[p]);
+            if (plen == 0) {
+                continue;
+            }
+        }
+
+        for (const char *unit : UNITS) {
+            size_t ulen = startsWith(s + plen, end, unit);
+            if (ulen == 0) {
+                continue;
+            }
+
+            const char *rest = s + plen + ulen;
+            if (rest == end || isPower(rest, end)) {
+                res.valid = true;
+                res.prefix.assign(s, plen);
+                res.unit.assign(unit, ulen);
+                res.power.assign(rest == end ? rest : rest + 1, end);
+                return res;
+            }
+        }
+    }
+
+    return res;
+}
+
+
+// Parsed units and scalings are memoized, the caches are bounded by
+// dropping everything once they grow too large
+const size_t UNIT_CACHE_SIZE = 1024;
+
+std::mutex unit_cache_lock;
+std::unordered_map<string, AtomicUnit> atomic_cache;
+std::unordered_map<string, double> scaling_cache;
+
+
+AtomicUnit parseAtomic(const string &unit) {
+    std::lock_guard<std::mutex> guard(unit_cache_lock);
+
+    auto it = atomic_cache.find(unit);
+    if (it != atomic_cache.end()) {
+        return it->second;
+    }
+
+    if (atomic_cache.size() >= UNIT_CACHE_SIZE) {
+        atomic_cache.clear();
+    }
+
+    AtomicUnit parsed = parseAtomic(unit.data(), unit.data() + unit.size());
+    atomic_cache.emplace(unit, parsed);
+    return parsed;
+}
+
+} // anonymous namespace
+
+
 void splitUnit(const string &combinedUnit, string &prefix, string &unit, string &power) {
-    boost::regex prefix_and_unit_and_power(PREFIXES + UNITS + POWER);
-    boost::regex prefix_and_unit(PREFIXES + UNITS);
-    boost::regex unit_and_power(UNITS + POWER);
-    boost::regex unit_only(UNITS);
-    boost::regex prefix_only(PREFIXES);
-
-    if (boost::regex_match(combinedUnit, prefix_and_unit_and_power)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        string suffix = m.suffix();
-        boost::regex_search(suffix, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, unit_and_power)) {
-        prefix = "";
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, prefix_and_unit)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        unit = m.suffix();
-        power = "";
+    AtomicUnit parsed = parseAtomic(combinedUnit);
+
+    if (parsed.valid) {
+        prefix = parsed.prefix;
+        unit = parsed.unit;
+        power = parsed.power;
     } else {
         unit = combinedUnit;
         prefix = "";
@@ -168,30 +253,25 @@ void invertPower(std::string &unit) {
 
 
 void splitCompoundUnit(const std::string &compoundUnit, std::vector<std::string> &atomicUnits) {
-    string s = compoundUnit;
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    boost::regex separator("(\\*|/)");
-    boost::match_results<std::string::const_iterator> m;
-    string sep;
-    while (boost::regex_search(s, m, opt_prefix_and_unit_and_power) && (m.suffix().length() > 0)) {
-        string suffix = m.suffix();
-        util::deblankString(suffix);
-        if (sep == "/") {
-            string unit = m[0];
+    char sep = 0;
+    size_t begin = 0;
+
+    while (begin <= compoundUnit.size()) {
+        size_t pos = compoundUnit.find_first_of("*/", begin);
+        if (pos == string::npos) {
+            pos = compoundUnit.size();
+        }
+
+        string unit = deblankString(compoundUnit.substr(begin, pos - begin));
+        if (sep == '/') {
             invertPower(unit);
-            atomicUnits.push_back(unit);
-        } else {
-            atomicUnits.push_back(m[0]);
         }
-        sep = suffix[0];
-        s = suffix.substr(1);
-    }
-    if (sep == "/") {
-        string unit = m[0];
-        invertPower(unit);
         atomicUnits.push_back(unit);
-    } else {
-        atomicUnits.push_back(m[0]);
+
+        if (pos < compoundUnit.size()) {
+            sep = compoundUnit[pos];
+        }
+        begin = pos + 1;
     }
 }
 
@@ -202,15 +282,29 @@ bool isSIUnit(const string &unit) {
 
 
 bool isAtomicSIUnit(const string &unit) {
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    return boost::regex_match(unit, opt_prefix_and_unit_and_power);
+    return parseAtomic(unit).valid;
 }
 
 
 bool isCompoundSIUnit(const string &unit) {
-    string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
-    boost::regex compound_unit("(" + atomic_unit + "(\\*|/))+"+ atomic_unit);
-    return boost::regex_match(unit, compound_unit);
+    const char *s = unit.data();
+    const char *end = s + unit.size();
+    size_t parts = 0;
+
+    while (true) {
+        const char *sep = std::find_if(s, end, [](char c) { return c == '*' || c == '/'; });
+        if (!parseAtomic(s, sep).valid) {
+            return false;
+        }
+        parts++;
+
+        if (sep == end) {
+            break;
+        }
+        s = sep + 1;
+    }
+
+    return parts > 1;
 }
 
 
@@ -274,11 +368,11 @@ bool isSetAtSamePos(const vector<string> &unitsA, const vector<string> &unitsB)
 }
 
 
-double getSIScaling(const string &originUnit, const string &destinationUnit) {
+// The scaling between two units, NaN if they are not scalable
+static double computeSIScaling(const string &originUnit, const string &destinationUnit) {
     double scaling = 1.0;
     if (!isScalable(originUnit, destinationUnit)) {
-        throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
-                               "nix::util::getSIScaling");
+        return std::numeric_limits<double>::quiet_NaN();
     }
     
     string org_unit, org_prefix, org_power;
@@ -303,30 +397,83 @@ double getSIScaling(const string &originUnit, const string &destinationUnit) {
     return scaling;
 }
 
+
+double getSIScaling(const string &originUnit, const string &destinationUnit) {
+    const string key = originUnit + '\n' + destinationUnit;
+    double scaling = 0.0;
+    bool cached = false;
+
+    {
+        std::lock_guard<std::mutex> guard(unit_cache_lock);
+        auto it = scaling_cache.find(key);
+        if (it != scaling_cache.end()) {
+            scaling = it->second;
+            cached = true;
+        }
+    }
+
+    if (!cached) {
+        // parsing takes the lock itself
+        scaling = computeSIScaling(originUnit, destinationUnit);
+
+        std::lock_guard<std::mutex> guard(unit_cache_lock);
+        if (scaling_cache.size() >= UNIT_CACHE_SIZE) {
+            scaling_cache.clear();
+        }
+        scaling_cache.emplace(key, scaling);
+    }
+
+    if (std::isnan(scaling)) {
+        throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
+                               "nix::util::getSIScaling");
+    }
+    return scaling;
+}
+
 void applyPolynomial(const std::vector<double> &coefficients,
                      double origin,
                      const double *input,
                      double *output,
                      size_t n) {
+    applyPolynomial<double, double>(coefficients, origin, input, output, n);
+}
+
+void copyBlock(const void *src, const NDSize &src_shape, const NDSize &src_offset,
+               void *dst, const NDSize &dst_shape, const NDSize &dst_offset,
+               const NDSize &count, size_t element_size) {
+    const size_t rank = count.size();
+    if (rank == 0 || count.nelms() == 0) {
+        return;
+    }
+
+    const char *src_bytes = static_cast<const char *>(src);
+    char *dst_bytes = static_cast<char *>(dst);
+    const size_t row = count[rank - 1] * element_size;
 
-    if (!coefficients.size()) {
-        // if we have no coefficients, i.e no polynomial specified we
-        // should still apply the the origin transformation
-        for (size_t k = 0; k < n; k++) {
-            output[k] = input[k] - origin;
+    std::vector<ndsize_t> src_stride(rank, 1), dst_stride(rank, 1);
+    for (size_t d = rank - 1; d > 0; d--) {
+        src_stride[d - 1] = src_stride[d] * src_shape[d];
+        dst_stride[d - 1] = dst_stride[d] * dst_shape[d];
+    }
+
+    // copy one row along the last dimension at a time
+    NDSize pos(rank, 0);
+    while (true) {
+        ndsize_t src_idx = 0, dst_idx = 0;
+        for (size_t d = 0; d < rank; d++) {
+            src_idx += (src_offset[d] + pos[d]) * src_stride[d];
+            dst_idx += (dst_offset[d] + pos[d]) * dst_stride[d];
         }
 
-    } else {
+        memcpy(dst_bytes + dst_idx * element_size, src_bytes + src_idx * element_size, row);
 
-        for (size_t k = 0; k < n; k++) {
-            const double x = input[k] - origin;
-            double value = 0.0;
-            double term = 1.0;
-            for (size_t i = 0; i < coefficients.size(); i++) {
-                value += coefficients[i] * term;
-                term *= x;
-            }
-            output[k] = value;
+        size_t d = rank - 1;
+        while (d > 0 && ++pos[d - 1] == count[d - 1]) {
+            pos[d - 1] = 0;
+            d--;
+        }
+        if (d == 0) {
+            return;
         }
     }
 }
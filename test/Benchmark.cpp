@@ -10,21 +10,28 @@
 
 #include <nix.hpp>
 #include <nix/NDArray.hpp>
+#include <nix/DataAppender.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
-#include <queue>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <random>
+#include <sstream>
 #include <type_traits>
 #include <iostream>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
 #include <stdexcept>
-#include <cstdio>
 #include <string>
 #include <cstdint>
 #include <utility>
 
+#include <boost/regex.hpp>
+
 /* ************************************ */
 namespace nix {
 
@@ -34,17 +41,38 @@ auto data_type_dispatch(nix::DataType dtype, Func &&F, Args&&... args)
 {
     switch (dtype) {
 
+        case DataType::Bool:
+            return std::forward<Func>(F)(bool(), std::forward<Args>(args)...);
+
+        case DataType::Float:
+            return std::forward<Func>(F)(float(), std::forward<Args>(args)...);
+
         case DataType::Double:
             return std::forward<Func>(F)(double(), std::forward<Args>(args)...);
-            break;
 
         case DataType::Int8:
             return std::forward<Func>(F)(int8_t(), std::forward<Args>(args)...);
-            break;
 
         case DataType::Int16:
             return std::forward<Func>(F)(int16_t(), std::forward<Args>(args)...);
-            break;
+
+        case DataType::Int32:
+            return std::forward<Func>(F)(int32_t(), std::forward<Args>(args)...);
+
+        case DataType::Int64:
+            return std::forward<Func>(F)(int64_t(), std::forward<Args>(args)...);
+
+        case DataType::UInt8:
+            return std::forward<Func>(F)(uint8_t(), std::forward<Args>(args)...);
+
+        case DataType::UInt16:
+            return std::forward<Func>(F)(uint16_t(), std::forward<Args>(args)...);
+
+        case DataType::UInt32:
+            return std::forward<Func>(F)(uint32_t(), std::forward<Args>(args)...);
+
+        case DataType::UInt64:
+            return std::forward<Func>(F)(uint64_t(), std::forward<Args>(args)...);
 
         default:
             throw std::invalid_argument("Unkown DataType");
@@ -71,18 +99,36 @@ public:
         return count;
     }
 
+    double us() {
+        time_point_t t_end = clock_t::now();
+        return std::chrono::duration<double, std::micro>(t_end - t_start).count();
+    }
+
 private:
     time_point_t t_start;
 };
 
 /* ************************************ */
 
+// All random data is derived from the seed given on the command line, so that
+// two runs with the same seed work on identical files. Every generator gets its
+// own stream, keyed by a name, so that adding a scenario does not change the
+// data of the others.
+static uint64_t derive_seed(uint64_t seed, const std::string &key) {
+    // FNV-1a, stable across platforms unlike std::hash
+    uint64_t h = 14695981039346656037ULL ^ seed;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
 class RndGenBase {
 public:
-    RndGenBase() : rd(), rd_gen(rd()) { };
+    RndGenBase(uint64_t seed) : rd_gen(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32))) { };
 
 protected:
-    std::random_device rd;
     std::mt19937 rd_gen;
 };
 
@@ -92,7 +138,7 @@ class RndGen { };
 template<typename T>
 class RndGen<T, typename std::enable_if<std::is_floating_point<T>::value >::type> : RndGenBase {
 public:
-    RndGen() : dis(-1024.0, +1024.0) { };
+    RndGen(uint64_t seed) : RndGenBase(seed), dis(-1024.0, +1024.0) { };
 
     T operator()(void) {
         return dis(rd_gen);
@@ -103,9 +149,24 @@ private:
 };
 
 template<typename T>
-class RndGen<T, typename std::enable_if<std::is_integral<T>::value >::type> : RndGenBase {
+class RndGen<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 1 && !std::is_same<T, bool>::value>::type>
+        : RndGenBase {
 public:
-    RndGen() : dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max()) { };
+    // uniform_int_distribution is not defined for char types
+    RndGen(uint64_t seed) : RndGenBase(seed), dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max()) { };
+
+    T operator()(void) {
+        return static_cast<T>(dis(rd_gen));
+    };
+
+private:
+    std::uniform_int_distribution<int> dis;
+};
+
+template<typename T>
+class RndGen<T, typename std::enable_if<std::is_integral<T>::value && (sizeof(T) > 1)>::type> : RndGenBase {
+public:
+    RndGen(uint64_t seed) : RndGenBase(seed), dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max()) { };
 
     T operator()(void) {
         return dis(rd_gen);
@@ -115,13 +176,418 @@ private:
     std::uniform_int_distribution<T> dis;
 };
 
+template<typename T>
+class RndGen<T, typename std::enable_if<std::is_same<T, bool>::value>::type> : RndGenBase {
+public:
+    RndGen(uint64_t seed) : RndGenBase(seed), dis(0.5) { };
+
+    T operator()(void) {
+        return dis(rd_gen);
+    };
+
+private:
+    std::bernoulli_distribution dis;
+};
+
+/* ************************************ */
+
+struct Options {
+
+    Options() : format("text"), cache("warm"), seed(42), repetitions(5),
+                entities(100000), blocks(500), quick(false) { }
+
+    std::string format;       //!< text, json or csv
+    std::string output;       //!< file for the report, stdout if empty
+    std::string filter;       //!< only run scenarios whose "suite/name" starts with it
+    std::string cache;        //!< warm, cold or both
+    uint64_t    seed;
+    size_t      repetitions;
+    size_t      entities;     //!< number of entities for the metadata scenarios
+    size_t      blocks;       //!< number of blocks per repetition for the I/O scenarios
+    bool        quick;
+
+    std::vector<std::string> cache_modes() const {
+        if (cache == "both") {
+            return {"warm", "cold"};
+        }
+        return {cache};
+    }
+};
+
+
+static void usage(std::ostream &out) {
+    out << "Usage: nix-bench [options]\n"
+        << "\n"
+        << "  --format=text|json|csv   report format (default: text)\n"
+        << "  --output=FILE            write the report to FILE instead of stdout\n"
+        << "  --filter=SUITE[/NAME]    only run the scenarios of a suite, or those starting with NAME\n"
+        << "  --cache=warm|cold|both   state of the caches for read scenarios (default: warm)\n"
+        << "  --seed=N                 seed of all random data (default: 42)\n"
+        << "  --repeat=N               repetitions of every scenario (default: 5)\n"
+        << "  --entities=N             entities of the metadata scenarios (default: 100000)\n"
+        << "  --blocks=N               blocks per repetition of the I/O scenarios (default: 500)\n"
+        << "  --quick                  small sizes and 2 repetitions, for smoke testing\n"
+        << "\n"
+        << "Warm runs read everything once before measuring and keep the file open,\n"
+        << "cold runs reopen the file before every repetition, which drops all\n"
+        << "caches of nix and HDF5 but not the page cache of the operating system.\n";
+}
+
+
+static Options parse_options(int argc, char **argv) {
+    Options opts;
+    bool have_entities = false, have_blocks = false, have_repeat = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string key = arg, value;
+
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos) {
+            key = arg.substr(0, eq);
+            value = arg.substr(eq + 1);
+        } else if (arg != "--quick" && arg != "--help" && i + 1 < argc) {
+            value = argv[++i];
+        }
+
+        if (key == "--help") {
+            usage(std::cout);
+            std::exit(0);
+        } else if (key == "--quick") {
+            opts.quick = true;
+        } else if (key == "--format") {
+            opts.format = value;
+        } else if (key == "--output") {
+            opts.output = value;
+        } else if (key == "--filter") {
+            opts.filter = value;
+        } else if (key == "--cache") {
+            opts.cache = value;
+        } else if (key == "--seed") {
+            opts.seed = std::stoull(value);
+        } else if (key == "--repeat") {
+            opts.repetitions = std::stoul(value);
+            have_repeat = true;
+        } else if (key == "--entities") {
+            opts.entities = std::stoul(value);
+            have_entities = true;
+        } else if (key == "--blocks") {
+            opts.blocks = std::stoul(value);
+            have_blocks = true;
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+
+    if (opts.format != "text" && opts.format != "json" && opts.format != "csv") {
+        throw std::invalid_argument("Unknown format: " + opts.format);
+    }
+    if (opts.cache != "warm" && opts.cache != "cold" && opts.cache != "both") {
+        throw std::invalid_argument("Unknown cache mode: " + opts.cache);
+    }
+    if (opts.quick) {
+        opts.entities = have_entities ? opts.entities : 2000;
+        opts.blocks = have_blocks ? opts.blocks : 50;
+        opts.repetitions = have_repeat ? opts.repetitions : 2;
+    }
+    if (opts.repetitions == 0 || opts.entities < 10 || opts.blocks == 0) {
+        throw std::invalid_argument("Repetitions, entities and blocks must be positive (entities >= 10)");
+    }
+
+    return opts;
+}
+
+/* ************************************ */
+
+// The measurements of one scenario. Every sample covers a number of items
+// (blocks, entities, lookups ...); the latencies are per item.
+class Result {
+
+public:
+    Result(const std::string &suite, const std::string &name, const std::string &params,
+           const std::string &cache, const std::string &unit, double bytes_per_item = 0)
+        : suite(suite), name(name), params(params), cache(cache), unit(unit),
+          bytes_per_item(bytes_per_item), items(0), micros(0) { }
+
+    void add(double count, double us) {
+        if (count <= 0) {
+            return;
+        }
+        latencies.push_back(us / count);
+        items += count;
+        micros += us;
+    }
+
+    double rate() const {
+        return micros > 0 ? items * 1e6 / micros : 0;
+    }
+
+    double mbs() const {
+        return rate() * bytes_per_item / (1024 * 1024);
+    }
+
+    double mean() const {
+        return items > 0 ? micros / items : 0;
+    }
+
+    // nearest-rank percentile of the per item latencies
+    double percentile(double p) const {
+        if (latencies.empty()) {
+            return 0;
+        }
+        std::vector<double> sorted(latencies);
+        std::sort(sorted.begin(), sorted.end());
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::max<size_t>(rank, 1) - 1];
+    }
+
+    size_t samples() const { return latencies.size(); }
+
+    const std::string suite, name, params, cache, unit;
+    const double bytes_per_item;
+    double items, micros;
+
+private:
+    std::vector<double> latencies;
+};
+
+
+class Report {
+
+public:
+    Report(const Options &opts) : opts(opts) { }
+
+    bool enabled(const std::string &suite, const std::string &name) const {
+        return (suite + "/" + name).compare(0, opts.filter.size(), opts.filter) == 0;
+    }
+
+    bool enabled(const std::string &suite) const {
+        return (suite + "/").compare(0, opts.filter.size(), opts.filter) == 0 ||
+               opts.filter.compare(0, suite.size() + 1, suite + "/") == 0;
+    }
+
+    Result &add(const std::string &suite, const std::string &name, const std::string &params,
+                const std::string &cache, const std::string &unit, double bytes_per_item = 0) {
+        results.emplace_back(suite, name, params, cache, unit, bytes_per_item);
+        std::cerr << "  " << suite << "/" << name;
+        if (!params.empty()) {
+            std::cerr << " [" << params << "]";
+        }
+        if (!cache.empty()) {
+            std::cerr << " (" << cache << ")";
+        }
+        std::cerr << std::endl;
+        return results.back();
+    }
+
+    void write(std::ostream &out) const;
+
+private:
+    void write_text(std::ostream &out) const;
+    void write_json(std::ostream &out) const;
+    void write_csv(std::ostream &out) const;
+
+    const Options &opts;
+    std::deque<Result> results;
+};
+
+
+static std::string json_escape(const std::string &str) {
+    std::string res;
+    for (char c : str) {
+        switch (c) {
+        case '"':  res += "\\\""; break;
+        case '\\': res += "\\\\"; break;
+        case '\n': res += "\\n"; break;
+        case '\t': res += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                res += buf;
+            } else {
+                res += c;
+            }
+        }
+    }
+    return res;
+}
+
+
+static std::string csv_escape(const std::string &str) {
+    if (str.find_first_of(",\"\n") == std::string::npos) {
+        return str;
+    }
+    std::string res = "\"";
+    for (char c : str) {
+        res += c;
+        if (c == '"') {
+            res += c;
+        }
+    }
+    return res + "\"";
+}
+
+
+static std::string compiler_version() {
+#if defined(__VERSION__)
+    return __VERSION__;
+#elif defined(_MSC_FULL_VER)
+    return "MSVC " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+
+static std::string utc_timestamp() {
+    std::time_t now = std::time(nullptr);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buf;
+}
+
+
+void Report::write(std::ostream &out) const {
+    out.precision(6);
+    if (opts.format == "json") {
+        write_json(out);
+    } else if (opts.format == "csv") {
+        write_csv(out);
+    } else {
+        write_text(out);
+    }
+}
+
+
+void Report::write_text(std::ostream &out) const {
+    out << " === Reports === (seed " << opts.seed << ", " << opts.repetitions << " repetitions)" << std::endl;
+    for (const Result &r : results) {
+        out << r.suite << "/" << r.name;
+        if (!r.params.empty()) {
+            out << ", " << r.params;
+        }
+        if (!r.cache.empty()) {
+            out << ", " << r.cache;
+        }
+        out << ", " << r.rate() << " " << r.unit << "/s";
+        if (r.bytes_per_item > 0) {
+            out << ", " << r.mbs() << " MB/s";
+        }
+        out << ", us/" << r.unit << " p50 " << r.percentile(50) << " p90 " << r.percentile(90)
+            << " p99 " << r.percentile(99) << std::endl;
+    }
+}
+
+
+void Report::write_json(std::ostream &out) const {
+    out << "{\n"
+        << "  \"benchmark\": \"nix-bench\",\n"
+        << "  \"timestamp\": \"" << utc_timestamp() << "\",\n"
+        << "  \"compiler\": \"" << json_escape(compiler_version()) << "\",\n"
+        << "  \"seed\": " << opts.seed << ",\n"
+        << "  \"repetitions\": " << opts.repetitions << ",\n"
+        << "  \"entities\": " << opts.entities << ",\n"
+        << "  \"blocks\": " << opts.blocks << ",\n"
+        << "  \"results\": [";
+
+    bool first = true;
+    for (const Result &r : results) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    {\"suite\": \"" << json_escape(r.suite) << "\", "
+            << "\"name\": \"" << json_escape(r.name) << "\", "
+            << "\"params\": \"" << json_escape(r.params) << "\", "
+            << "\"cache\": \"" << json_escape(r.cache) << "\", "
+            << "\"unit\": \"" << json_escape(r.unit) << "\", "
+            << "\"samples\": " << r.samples() << ", "
+            << "\"items\": " << r.items << ", "
+            << "\"rate\": " << r.rate() << ", "
+            << "\"mb_per_s\": " << r.mbs() << ", "
+            << "\"latency_us\": {\"mean\": " << r.mean()
+            << ", \"p50\": " << r.percentile(50)
+            << ", \"p90\": " << r.percentile(90)
+            << ", \"p99\": " << r.percentile(99)
+            << ", \"min\": " << r.percentile(0)
+            << ", \"max\": " << r.percentile(100) << "}}";
+    }
+
+    out << "\n  ]\n}" << std::endl;
+}
+
+
+void Report::write_csv(std::ostream &out) const {
+    out << "suite,name,params,cache,unit,samples,items,rate,mb_per_s,"
+        << "mean_us,p50_us,p90_us,p99_us,min_us,max_us,seed" << std::endl;
+    for (const Result &r : results) {
+        out << csv_escape(r.suite) << "," << csv_escape(r.name) << "," << csv_escape(r.params) << ","
+            << csv_escape(r.cache) << "," << csv_escape(r.unit) << "," << r.samples() << ","
+            << r.items << "," << r.rate() << "," << r.mbs() << "," << r.mean() << ","
+            << r.percentile(50) << "," << r.percentile(90) << "," << r.percentile(99) << ","
+            << r.percentile(0) << "," << r.percentile(100) << "," << opts.seed << std::endl;
+    }
+}
+
+/* ************************************ */
+
+// A benchmark file that can be reopened to measure with cold caches
+class Workspace {
+
+public:
+    Workspace(const std::string &path, const std::string &block_name)
+        : path(path), block_name(block_name) {
+        file = nix::File::open(path, nix::FileMode::Overwrite);
+        block = file.createBlock(block_name, "nix.bench");
+    }
+
+    void reopen() {
+        block = nix::none;
+        file.close();
+        file = nix::File::open(path, nix::FileMode::ReadWrite);
+        block = file.getBlock(block_name);
+    }
+
+    ~Workspace() {
+        block = nix::none;
+        file.close();
+        std::remove(path.c_str());
+    }
+
+    const std::string path;
+    const std::string block_name;
+    nix::File file;
+    nix::Block block;
+};
+
+
+// Runs a read scenario once per cache mode: warm runs do an untimed pass
+// first, cold runs reopen the file before every repetition.
+template<typename Setup, typename Measure>
+static void with_cache_modes(const Options &opts, Workspace &ws, Setup setup, Measure measure) {
+    for (const std::string &mode : opts.cache_modes()) {
+        if (mode == "warm") {
+            setup(mode);
+            measure(mode, nullptr);
+        } else {
+            setup(mode);
+        }
+        for (size_t rep = 0; rep < opts.repetitions; rep++) {
+            if (mode == "cold") {
+                ws.reopen();
+            }
+            measure(mode, &rep);
+        }
+    }
+}
+
 /* ************************************ */
 
 class Config {
 
 public:
-    Config(nix::DataType data_type, const nix::NDSize &blocksize)
-            : data_type(data_type), block_size(blocksize) {
+    Config(nix::DataType data_type, const nix::NDSize &blocksize,
+           const nix::Compression &compression = nix::Compression())
+            : data_type(data_type), block_size(blocksize), comp(compression) {
 
         sdim = find_single_dim();
         shape = blocksize;
@@ -150,7 +616,10 @@ public:
     const nix::NDSize& size() const { return block_size; }
     const nix::NDSize& extend() const { return shape; }
     size_t singleton_dimension() const { return sdim; }
+    const nix::Compression& compression() const { return comp; }
+    bool compressed() const { return comp.codec != nix::Codec::None || comp.shuffle; }
     const std::string & name() const { return my_name; };
+    size_t block_bytes() const { return block_size.nelms() * nix::data_type_to_size(data_type); }
 
 
 private:
@@ -163,12 +632,23 @@ private:
         }
         s << "}";
 
+        switch (comp.codec) {
+        case nix::Codec::None: break;
+        case nix::Codec::Deflate: s << "+deflate" << comp.level; break;
+        case nix::Codec::LZ4: s << "+lz4"; break;
+        }
+
+        if (comp.shuffle) {
+            s << "+shuffle";
+        }
+
         my_name = s.str();
     }
 
 private:
     const nix::DataType data_type;
     const nix::NDSize block_size;
+    const nix::Compression comp;
 
     size_t        sdim;
     nix::NDSize   shape;
@@ -181,10 +661,10 @@ private:
 class BlockGenerator : public RndGenBase {
 public:
 
-    BlockGenerator(const Config &cfg, size_t bufsize)
-            : blocksize(cfg.size()), dtype(cfg.dtype()), uni_dis(0, bufsize-1) {
+    BlockGenerator(const Config &cfg, size_t bufsize, uint64_t seed)
+            : RndGenBase(seed), blocksize(cfg.size()), dtype(cfg.dtype()), uni_dis(0, bufsize-1) {
         for(size_t i = 0; i < bufsize; i++) {
-            blocks.push_back(make_block());
+            blocks.push_back(make_block(derive_seed(seed, std::to_string(i))));
         }
     };
 
@@ -192,8 +672,8 @@ public:
 
     public:
         template<typename U>
-        nix::NDArray operator()(U tag, const nix::NDSize &size) {
-            RndGen<U> rnd_gen;
+        nix::NDArray operator()(U tag, const nix::NDSize &size, uint64_t seed) {
+            RndGen<U> rnd_gen(seed);
 
             nix::NDArray data(nix::to_data_type<U>::value, size);
             for(size_t i = 0; i < data.num_elements(); i++) {
@@ -204,41 +684,14 @@ public:
         };
     };
 
-    nix::NDArray make_block() {
+    nix::NDArray make_block(uint64_t seed) {
         BlockMaker maker;
-        return nix::data_type_dispatch(dtype, maker, std::ref(blocksize));
+        return nix::data_type_dispatch(dtype, maker, std::ref(blocksize), seed);
     }
 
-    nix::NDArray next_block() {
+    const nix::NDArray &next_block() {
         size_t index = uni_dis(rd_gen);
-        nix::NDArray block = blocks[index];
-        return block;
-    }
-
-    double speed_test(size_t &iterations) {
-
-        Stopwatch sw;
-
-        size_t N = 100;
-        iterations = 0;
-
-        do {
-            Stopwatch inner;
-
-            for (size_t i = 0; i < N; i++) {
-                nix::NDArray data = next_block();
-                assert(data.size() == blocksize);
-                iterations++;
-            }
-
-            if (inner.ms() < 100) {
-                N *= 2;
-            }
-
-        } while (sw.ms() < 1000);
-
-        ssize_t count = sw.ms();
-        return count;
+        return blocks[index];
     }
 
 private:
@@ -248,288 +701,754 @@ private:
     std::vector<nix::NDArray> blocks;
 };
 
+/* ************************************ */
+
+// Data I/O of one configuration: in-memory generation, raw stdio as baseline,
+// nix writes, reads and appends
+class IOSuite {
 
-class Benchmark {
 public:
-    Benchmark(const Config &cfg) : config(cfg) { }
-    const Config & cfg() const { return config; }
-
-    nix::DataArray openDataArray(nix::Block block) const {
-        const std::string &cfg_name = config.name();
-        std::vector<nix::DataArray> v = block.dataArrays(nix::util::NameFilter<nix::DataArray>(cfg_name));
-        if (v.empty()) {
-            return block.createDataArray(cfg_name, "nix.test.da", config.dtype(), config.extend());
-        } else {
-            return v[0];
-        }
-    }
+    IOSuite(const Options &opts, Report &report, Workspace &ws, const Config &cfg)
+        : opts(opts), report(report), ws(ws), cfg(cfg),
+          generator(cfg, 10, derive_seed(opts.seed, cfg.name())) { }
+
+    void run() {
+        if (enabled("generate")) generate();
+        if (!cfg.compressed() && enabled("disk-write")) disk_write();
+        if (!cfg.compressed() && enabled("disk-read")) disk_read();
 
-    virtual ~Benchmark() { }
+        if (enabled("write") || enabled("read") || enabled("read-poly")) {
+            write();
+        }
+        if (enabled("read")) read(false);
+        if (cfg.dtype() != nix::DataType::Bool && enabled("read-poly")) read(true);
 
-    virtual double speed_in_mbs() {
-        return count * config.size().nelms() * nix::data_type_to_size(config.dtype()) *
-                (1000.0/millis) / (1024 * 1024);
+        if (enabled("append")) append(false);
+        if (enabled("appender")) append(true);
     }
 
-    virtual double speed_in_nps() {
-        return count * config.size().nelms() * (1000.0/millis);
+private:
+    bool enabled(const std::string &name) const {
+        return report.enabled("io", name);
     }
 
-    template<typename F>
-    ssize_t time_it(F func) {
-        Stopwatch watch;
-        func();
-        return watch.ms();
+    Result &add(const std::string &name, const std::string &cache = "") {
+        return report.add("io", name, cfg.name(), cache, "blocks", cfg.block_bytes());
     }
 
+    nix::DataArray createDataArray(const std::string &name) {
+        nix::ChunkingHint hint;
+        if (cfg.compressed()) {
+            // compressed chunks are re-encoded on every partial write,
+            // so let each block fill exactly one chunk
+            hint.append_axis = cfg.singleton_dimension();
+            hint.read_shape = cfg.size();
+            hint.target_bytes = cfg.block_bytes();
+        }
+        return ws.block.createDataArray(name, "nix.test.da", cfg.dtype(), cfg.extend(), hint, cfg.compression());
+    }
 
-    virtual void run(nix::Block block) = 0;
-    virtual std::string id() = 0;
+    void generate() {
+        Result &res = add("generate");
+        for (size_t rep = 0; rep < opts.repetitions; rep++) {
+            Stopwatch sw;
+            for (size_t i = 0; i < opts.blocks; i++) {
+                const nix::NDArray &data = generator.next_block();
+                if (data.size() != cfg.size()) {
+                    throw std::runtime_error("Generator: block has the wrong size");
+                }
+            }
+            res.add(opts.blocks, sw.us());
+        }
+    }
 
-protected:
-    const Config config;
-    size_t       count;
-    double       millis;
-};
+    std::string raw_path() const {
+        return cfg.name() + "io.raw";
+    }
 
-class GeneratorBenchmark : public Benchmark {
-public:
-    GeneratorBenchmark(const Config &cfg)
-            : Benchmark(cfg) {
+    void disk_write() {
+        Result &res = add("disk-write");
+        for (size_t rep = 0; rep < opts.repetitions; rep++) {
+            std::FILE *fd = std::fopen(raw_path().c_str(), "wb");
+            if (!fd) {
+                throw std::runtime_error("Could not open " + raw_path());
+            }
+            setvbuf(fd, nullptr, _IONBF, 0);
 
-    };
+            for (size_t i = 0; i < opts.blocks; i++) {
+                const nix::NDArray &block = generator.next_block();
+                Stopwatch sw;
+                size_t nwritten = fwrite(block.data(), cfg.block_bytes(), 1, fd);
+                res.add(1, sw.us());
 
-    void run(nix::Block block) override {
-        BlockGenerator generator(config, 10);
-        this->millis = generator.speed_test(this->count);
-    }
+                if (nwritten != 1) {
+                    std::fclose(fd);
+                    throw std::runtime_error("Output error in disk write test.");
+                }
+            }
 
-    std::string id() override {
-        return "G";
+            std::fclose(fd);
+        }
     }
-};
 
+    void disk_read() {
+        Result &res = add("disk-read");
+        std::vector<char> buffer(cfg.block_bytes(), 0);
 
-class WriteBenchmark : public Benchmark {
-
-public:
-    WriteBenchmark(const Config &cfg)
-            : Benchmark(cfg) {
-    };
-
-    void run(nix::Block block) override {
-        nix::DataArray da = openDataArray(block);
+        for (size_t rep = 0; rep < opts.repetitions; rep++) {
+            std::FILE *fd = std::fopen(raw_path().c_str(), "rb");
+            if (!fd) {
+                throw std::runtime_error("Could not open " + raw_path() + ", run disk-write first");
+            }
+            setvbuf(fd, nullptr, _IONBF, 0);
+
+            size_t n;
+            do {
+                Stopwatch sw;
+                n = fread(buffer.data(), buffer.size(), 1, fd);
+                if (n > 0) {
+                    res.add(1, sw.us());
+                }
+            } while (n > 0);
 
-        BlockGenerator generator(config, 10);
+            std::fclose(fd);
+        }
 
-        size_t N = 100;
-        size_t iterations = 0;
+        std::remove(raw_path().c_str());
+    }
 
-        nix::NDSize pos = {0, 0};
-        Stopwatch sw;
-        ssize_t ms = 0;
-        do {
-            Stopwatch inner;
-
-            for (size_t i = 0; i < N; i++) {
-                nix::NDArray block = generator.next_block();
-                da.dataExtent(config.size() + pos);
-                da.setData(config.dtype(), block.data(), config.size(), pos);
-                pos[config.singleton_dimension()] += 1;
-                iterations++;
+    // one block after the other, growing the data array for each
+    void write() {
+        Result &res = add("write");
+        nix::DataArray da = createDataArray(cfg.name());
+        nix::NDSize pos(cfg.size().size(), 0);
+
+        for (size_t rep = 0; rep < opts.repetitions; rep++) {
+            for (size_t i = 0; i < opts.blocks; i++) {
+                const nix::NDArray &block = generator.next_block();
+                Stopwatch sw;
+                da.dataExtent(cfg.size() + pos);
+                da.setData(cfg.dtype(), block.data(), cfg.size(), pos);
+                res.add(1, sw.us());
+                pos[cfg.singleton_dimension()] += 1;
             }
+        }
+    }
 
-            if (inner.ms() < 100) {
-                N *= 2;
+    void read(bool poly) {
+        nix::NDArray array(cfg.dtype(), cfg.size());
+        nix::DataArray da;
+        Result *res = nullptr;
+
+        with_cache_modes(opts, ws, [&](const std::string &mode) {
+            res = &add(poly ? "read-poly" : "read", mode);
+        }, [&](const std::string &mode, const size_t *rep) {
+            da = ws.block.getDataArray(cfg.name());
+            if (poly) {
+                da.polynomCoefficients({3, 4, 5, 6});
             }
 
-        } while ((ms = sw.ms()) < 3*1000);
+            const size_t n = da.dataExtent()[cfg.singleton_dimension()];
+            nix::NDSize pos(cfg.size().size(), 0);
+            for (size_t i = 0; i < n; i++) {
+                Stopwatch sw;
+                da.getData(cfg.dtype(), array.data(), cfg.size(), pos);
+                if (rep) {
+                    res->add(1, sw.us());
+                }
+                pos[cfg.singleton_dimension()] += 1;
+            }
+        });
 
-        this->count = iterations;
-        this->millis = ms;
+        if (poly) {
+            da.polynomCoefficients(nix::none);
+        }
     }
 
-    std::string id() override {
-        return "W";
+    // streaming acquisition: appendData resizes and writes for each block,
+    // the DataAppender buffers and resizes in larger steps
+    void append(bool buffered) {
+        Result &res = add(buffered ? "appender" : "append");
+
+        for (size_t rep = 0; rep < opts.repetitions; rep++) {
+            std::string name = cfg.name() + (buffered ? "-appender-" : "-append-") + std::to_string(rep);
+            nix::DataArray da = createDataArray(name);
+            const size_t axis = cfg.singleton_dimension();
+
+            if (buffered) {
+                nix::DataAppender appender(da, axis);
+                Stopwatch sw;
+                for (size_t i = 0; i < opts.blocks; i++) {
+                    const nix::NDArray &block = generator.next_block();
+                    appender.append(cfg.dtype(), block.data(), cfg.size());
+                }
+                appender.close();
+                res.add(opts.blocks, sw.us());
+            } else {
+                Stopwatch sw;
+                for (size_t i = 0; i < opts.blocks; i++) {
+                    const nix::NDArray &block = generator.next_block();
+                    da.appendData(cfg.dtype(), block.data(), cfg.size(), axis);
+                }
+                res.add(opts.blocks, sw.us());
+            }
+
+            if (da.dataExtent()[axis] != opts.blocks) {
+                throw std::runtime_error("Append: wrong extent after appending");
+            }
+            ws.block.deleteDataArray(da);
+        }
     }
+
+    const Options &opts;
+    Report &report;
+    Workspace &ws;
+    const Config &cfg;
+    BlockGenerator generator;
 };
 
+/* ************************************ */
 
-class ReadBenchmark : public Benchmark {
+// Arrays of variable length strings, written at once and read either as
+// std::string or into a StringColumn
+class StringSuite {
 
 public:
-    ReadBenchmark(const Config &cfg)
-            : Benchmark(cfg) {
-    };
-
-    void test_read_io(nix::DataArray da) {
-
-        nix::NDArray array(config.dtype(), config.size());
-        nix::NDSize extend = da.dataExtent();
-        size_t N = extend[config.singleton_dimension()];
-
-        nix::NDSize pos = {0, 0};
+    StringSuite(const Options &opts, Report &report, Workspace &ws)
+        : opts(opts), report(report), ws(ws) { }
+
+    void run() {
+        const size_t n = opts.blocks * 100;
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(derive_seed(opts.seed, "strings")));
+        std::uniform_int_distribution<size_t> length(0, 64);
+        std::uniform_int_distribution<int> letter('a', 'z');
+
+        std::vector<std::string> words(n);
+        for (std::string &w : words) {
+            w.resize(length(gen));
+            for (char &c : w) {
+                c = static_cast<char>(letter(gen));
+            }
+        }
 
-        ssize_t ms = time_it([this, &da, &N, &pos, &array] {
-            for(size_t i = 0; i < N; i++) {
-                da.getData(config.dtype(), array.data(), config.size(), pos);
-                pos[config.singleton_dimension()] += 1;
+        if (report.enabled("strings", "write")) {
+            Result &res = report.add("strings", "write", std::to_string(n), "", "strings");
+            for (size_t rep = 0; rep < opts.repetitions; rep++) {
+                std::string name = "strings-" + std::to_string(rep);
+                Stopwatch sw;
+                ws.block.createDataArray(name, "nix.bench.strings", words);
+                res.add(n, sw.us());
+                if (rep > 0) {
+                    ws.block.deleteDataArray(name);
+                }
             }
-        });
+        } else if (report.enabled("strings")) {
+            ws.block.createDataArray("strings-0", "nix.bench.strings", words);
+        }
 
-        this->count = N;
-        this->millis = ms;
-    }
+        if (report.enabled("strings", "read")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("strings", "read", std::to_string(n), mode, "strings");
+            }, [&](const std::string &mode, const size_t *rep) {
+                std::vector<std::string> read;
+                nix::DataArray da = ws.block.getDataArray("strings-0");
+                Stopwatch sw;
+                da.getData(read);
+                if (rep) {
+                    res->add(n, sw.us());
+                }
+                if (read != words) {
+                    throw std::runtime_error("Strings: read data differs");
+                }
+            });
+        }
 
-    void run(nix::Block block) override {
-        nix::DataArray da = openDataArray(block);
-        test_read_io(da);
+        if (report.enabled("strings", "read-column")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("strings", "read-column", std::to_string(n), mode, "strings");
+            }, [&](const std::string &mode, const size_t *rep) {
+                nix::StringColumn column;
+                nix::DataArray da = ws.block.getDataArray("strings-0");
+                Stopwatch sw;
+                da.getData(column);
+                if (rep) {
+                    res->add(n, sw.us());
+                }
+                if (column.size() != n) {
+                    throw std::runtime_error("Strings: read column has the wrong size");
+                }
+            });
+        }
     }
 
-    std::string id() override {
-        return "R";
-    }
+private:
+    const Options &opts;
+    Report &report;
+    Workspace &ws;
 };
 
+/* ************************************ */
 
-class ReadPolyBenchmark : public ReadBenchmark {
+// Many small entities: sources of a block, a tree of sections and the
+// values of properties
+class MetadataSuite {
 
 public:
-    ReadPolyBenchmark(const Config &cfg)
-            : ReadBenchmark(cfg) {
-    };
-
-    void run(nix::Block block) override {
-        nix::DataArray da = openDataArray(block);
-        da.polynomCoefficients({3, 4, 5, 6});
-        test_read_io(da);
-    }
+    MetadataSuite(const Options &opts, Report &report, Workspace &ws)
+        : opts(opts), report(report), ws(ws), gen(static_cast<std::mt19937::result_type>(
+                                                      derive_seed(opts.seed, "metadata"))) { }
 
-    std::string id() override {
-        return "P";
+    void run() {
+        if (report.enabled("entities")) {
+            sources();
+        }
+        if (report.enabled("sections")) {
+            sections();
+        }
+        if (report.enabled("properties")) {
+            properties();
+        }
     }
-};
 
-class DiskBenchmark : public Benchmark {
-public:
-    DiskBenchmark(const Config &cfg)
-            : Benchmark(cfg), fd(nullptr) {
+private:
+    static const size_t BATCH = 100;
 
-    };
+    std::string count() const {
+        return std::to_string(opts.entities);
+    }
 
-    void openFile(bool readOnly) {
-        std::string path = config.name() + "io.raw";
-        const char *mode = readOnly ? "rb" : "wb";
-        fd = fopen(path.c_str(), mode);
-        setvbuf(fd, nullptr, _IONBF, 0);
+    // indices of the entities to look up, the same for every repetition
+    std::vector<size_t> sample(size_t n, size_t max_count) {
+        std::uniform_int_distribution<size_t> dis(0, n - 1);
+        std::vector<size_t> picks(std::min(n, max_count));
+        for (size_t &p : picks) {
+            p = dis(gen);
+        }
+        return picks;
     }
 
-    void read_test() {
-        const size_t nelms = config.size().nelms();
-        const size_t elmsize = nix::data_type_to_size(config.dtype());
-        const size_t nbytes = nelms * elmsize;
-        std::vector<char> buffer(nbytes, 0);
+    void sources() {
+        const size_t n = opts.entities;
+        std::vector<std::string> names(n), ids(n);
+
+        Result &create = report.add("entities", "create-sources", count(), "", "sources");
+        for (size_t i = 0; i < n; i += BATCH) {
+            Stopwatch sw;
+            size_t end = std::min(n, i + BATCH);
+            for (size_t k = i; k < end; k++) {
+                names[k] = "source-" + std::to_string(k);
+                ids[k] = ws.block.createSource(names[k], "nix.bench.source").id();
+            }
+            create.add(end - i, sw.us());
+        }
 
-        Stopwatch sw;
-        ssize_t n;
-        size_t count = 0;
+        std::vector<size_t> picks = sample(n, 10000);
 
-        while ((n = fread(buffer.data(), nbytes, 1, fd)) > 0) {
-            count += n;
+        if (report.enabled("entities", "lookup-name")) {
+            lookup("lookup-name", picks, names);
+        }
+        if (report.enabled("entities", "lookup-id")) {
+            lookup("lookup-id", picks, ids);
         }
 
-        this->millis = sw.ms();
-        this->count = count;
+        if (report.enabled("entities", "iterate-sources")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("entities", "iterate-sources", count(), mode, "sources");
+            }, [&](const std::string &mode, const size_t *rep) {
+                Stopwatch sw;
+                size_t chars = 0;
+                for (const nix::Source &src : ws.block.sources()) {
+                    chars += src.name().size();
+                }
+                if (rep) {
+                    res->add(n, sw.us());
+                }
+                if (chars == 0) {
+                    throw std::runtime_error("Sources: no names");
+                }
+            });
+        }
     }
 
-    void write_test() {
-        BlockGenerator generator(config, 10);
-
-        size_t N = 100;
-        size_t iterations = 0;
+    void lookup(const std::string &name, const std::vector<size_t> &picks, const std::vector<std::string> &keys) {
+        Result *res = nullptr;
+        with_cache_modes(opts, ws, [&](const std::string &mode) {
+            res = &report.add("entities", name, count(), mode, "lookups");
+        }, [&](const std::string &mode, const size_t *rep) {
+            for (size_t p : picks) {
+                Stopwatch sw;
+                nix::Source src = ws.block.getSource(keys[p]);
+                if (rep) {
+                    res->add(1, sw.us());
+                }
+                if (!src) {
+                    throw std::runtime_error("Sources: lookup failed for " + keys[p]);
+                }
+            }
+        });
+    }
 
-        nix::NDSize pos = {0, 0};
-        Stopwatch sw;
-        ssize_t ms = 0;
-        const size_t elm_size = nix::data_type_to_size(config.dtype());
-        do {
-            Stopwatch inner;
+    // a tree with a fan-out of 10 and a tenth of the entities as sections
+    void sections() {
+        const size_t n = std::max<size_t>(opts.entities / 10, 10);
+        const std::string params = std::to_string(n);
+        std::vector<std::vector<std::string>> paths;   // names from the root section
+        size_t max_depth = 0;
+
+        Result &create = report.add("sections", "create-tree", params, "", "sections");
+        std::deque<std::pair<nix::Section, std::vector<std::string>>> todo;
+        size_t created = 0;
+        Stopwatch batch;
+
+        auto made = [&](const nix::Section &s, const std::vector<std::string> &path) {
+            todo.emplace_back(s, path);
+            paths.push_back(path);
+            max_depth = std::max(max_depth, path.size() - 1);
+            if (++created % BATCH == 0 || created == n) {
+                create.add(created % BATCH == 0 ? BATCH : created % BATCH, batch.us());
+                batch = Stopwatch();
+            }
+        };
 
-            for (size_t i = 0; i < N; i++) {
-                nix::NDArray block = generator.next_block();
+        for (size_t i = 0; i < 10 && created < n; i++) {
+            std::string name = "section-" + std::to_string(i);
+            made(ws.file.createSection(name, "level0"), {name});
+        }
+        while (created < n) {
+            auto parent = todo.front();
+            todo.pop_front();
+            const std::string type = "level" + std::to_string(parent.second.size());
+            for (size_t i = 0; i < 10 && created < n; i++) {
+                std::vector<std::string> path = parent.second;
+                path.push_back("section-" + std::to_string(created));
+                made(parent.first.createSection(path.back(), type), path);
+            }
+        }
+        todo.clear();
+
+        const std::string deepest = "level" + std::to_string(max_depth);
+
+        if (report.enabled("sections", "find-type")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("sections", "find-type", params, mode, "queries");
+            }, [&](const std::string &mode, const size_t *rep) {
+                Stopwatch sw;
+                std::vector<nix::Section> found = ws.file.findSections(nix::util::TypeFilter<nix::Section>(deepest));
+                if (rep) {
+                    res->add(1, sw.us());
+                }
+                if (found.empty()) {
+                    throw std::runtime_error("Sections: no section of type " + deepest);
+                }
+            });
+        }
 
-                ssize_t nwritten = fwrite(block.data(), elm_size, block.num_elements(), fd);
+        if (report.enabled("sections", "find-all")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("sections", "find-all", params, mode, "sections");
+            }, [&](const std::string &mode, const size_t *rep) {
+                Stopwatch sw;
+                std::vector<nix::Section> found = ws.file.findSections();
+                if (rep) {
+                    res->add(found.size(), sw.us());
+                }
+                if (found.size() != n) {
+                    throw std::runtime_error("Sections: wrong number of sections found");
+                }
+            });
+        }
 
-                if (nwritten != block.num_elements()) {
-                    throw std::runtime_error("Output error in disk write test.");
+        if (report.enabled("sections", "find-related")) {
+            // sections of the deepest level, opened along their path so that
+            // cold runs do not warm the index before measuring
+            std::vector<size_t> leaves;
+            for (size_t i = 0; i < paths.size(); i++) {
+                if (paths[i].size() - 1 == max_depth) {
+                    leaves.push_back(i);
+                }
+            }
+            std::vector<size_t> picks = sample(leaves.size(), 200);
+
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("sections", "find-related", params, mode, "queries");
+            }, [&](const std::string &mode, const size_t *rep) {
+                for (size_t p : picks) {
+                    const std::vector<std::string> &path = paths[leaves[p]];
+                    nix::Section s = ws.file.getSection(path[0]);
+                    for (size_t k = 1; k < path.size(); k++) {
+                        s = s.getSection(path[k]);
+                    }
+
+                    Stopwatch sw;
+                    std::vector<nix::Section> related = s.findRelated(nix::util::TypeFilter<nix::Section>("level1"));
+                    if (rep) {
+                        res->add(1, sw.us());
+                    }
+                    if (max_depth > 1 && related.empty()) {
+                        throw std::runtime_error("Sections: no related section found");
+                    }
                 }
+            });
+        }
+    }
 
-                iterations++;
+    // a tenth of the entities as properties of one section, 16 values each
+    void properties() {
+        const size_t n = std::max<size_t>(opts.entities / 10, 10);
+        const std::string params = std::to_string(n) + "x16";
+        std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+        nix::Section section = ws.file.createSection("properties", "nix.bench.properties");
+        Result &create = report.add("properties", "create", params, "", "properties");
+        for (size_t i = 0; i < n; i += BATCH) {
+            size_t end = std::min(n, i + BATCH);
+            std::vector<std::vector<nix::Value>> values(end - i, std::vector<nix::Value>(16));
+            for (auto &vs : values) {
+                for (nix::Value &v : vs) {
+                    v.set(dis(gen));
+                }
             }
 
-            fflush(fd);
+            Stopwatch sw;
+            for (size_t k = i; k < end; k++) {
+                section.createProperty("property-" + std::to_string(k), values[k - i]);
+            }
+            create.add(end - i, sw.us());
+        }
 
-            if (inner.ms() < 100) {
-                N *= 2;
+        std::vector<size_t> picks = sample(n, 10000);
+        Result *res = nullptr;
+        with_cache_modes(opts, ws, [&](const std::string &mode) {
+            res = &report.add("properties", "read-values", params, mode, "properties");
+        }, [&](const std::string &mode, const size_t *rep) {
+            nix::Section s = ws.file.getSection("properties");
+            for (size_t p : picks) {
+                Stopwatch sw;
+                std::vector<nix::Value> values = s.getProperty("property-" + std::to_string(p)).values();
+                if (rep) {
+                    res->add(1, sw.us());
+                }
+                if (values.size() != 16) {
+                    throw std::runtime_error("Properties: wrong number of values");
+                }
             }
+        });
+    }
+
+    const Options &opts;
+    Report &report;
+    Workspace &ws;
+    std::mt19937 gen;
+};
 
-        } while ((ms = sw.ms()) < 3 * 1000);
+/* ************************************ */
 
-        count = iterations;
-        millis = ms;
-    }
+// Retrieval of the data tagged by Tags and a MultiTag in a sampled signal
+class TagSuite {
 
-    void closeFile() {
-        if (fd) {
-            fclose(fd);
-            fd = nullptr;
+public:
+    TagSuite(const Options &opts, Report &report, Workspace &ws)
+        : opts(opts), report(report), ws(ws) { }
+
+    void run() {
+        const size_t samples = opts.quick ? 100000 : 1000000;
+        const size_t ntags = std::max<size_t>(opts.entities / 100, 10);
+        const double interval = 0.001;
+        const double extent = 50 * interval;
+        const std::string params = std::to_string(ntags) + " of " + std::to_string(samples);
+
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(derive_seed(opts.seed, "tags")));
+        RndGen<double> rnd(derive_seed(opts.seed, "signal"));
+
+        std::vector<double> signal(samples);
+        for (double &x : signal) {
+            x = rnd();
         }
-    }
+        nix::DataArray da = ws.block.createDataArray("signal", "nix.bench.signal", signal);
+        da.appendSampledDimension(interval);
 
+        std::uniform_real_distribution<double> dis(0, (samples - 100) * interval);
+        std::vector<double> positions(ntags);
+        for (double &p : positions) {
+            p = dis(gen);
+        }
+
+        Result &create = report.add("tags", "create-tags", params, "", "tags");
+        Stopwatch sw;
+        for (size_t i = 0; i < ntags; i++) {
+            nix::Tag tag = ws.block.createTag("tag-" + std::to_string(i), "nix.bench.tag", {positions[i]});
+            tag.extent({extent});
+            tag.addReference(da);
+        }
+        create.add(ntags, sw.us());
+
+        nix::NDSize shape(2, 1);
+        shape[0] = ntags;
+        const nix::NDSize origin(2, 0);
+        nix::DataArray pos = ws.block.createDataArray("positions", "nix.bench.positions",
+                                                      nix::DataType::Double, shape);
+        pos.setData(nix::DataType::Double, positions.data(), shape, origin);
+        std::vector<double> extents(ntags, extent);
+        nix::DataArray ext = ws.block.createDataArray("extents", "nix.bench.extents",
+                                                      nix::DataType::Double, shape);
+        ext.setData(nix::DataType::Double, extents.data(), shape, origin);
+        nix::MultiTag mtag = ws.block.createMultiTag("multitag", "nix.bench.multitag", pos);
+        mtag.extents(ext);
+        mtag.addReference(da);
+
+        if (report.enabled("tags", "tag-retrieve")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("tags", "tag-retrieve", params, mode, "tags");
+            }, [&](const std::string &mode, const size_t *rep) {
+                std::vector<nix::Tag> tags = ws.block.tags();
+                std::vector<double> data;
+                for (const nix::Tag &tag : tags) {
+                    Stopwatch sw;
+                    nix::DataView view = tag.retrieveData(0);
+                    view.getData(data);
+                    if (rep) {
+                        res->add(1, sw.us());
+                    }
+                    if (data.empty()) {
+                        throw std::runtime_error("Tags: no data retrieved");
+                    }
+                }
+            });
+        }
+
+        if (report.enabled("tags", "multitag-retrieve")) {
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("tags", "multitag-retrieve", params, mode, "positions");
+            }, [&](const std::string &mode, const size_t *rep) {
+                nix::MultiTag mt = ws.block.getMultiTag("multitag");
+                std::vector<double> data;
+                for (size_t i = 0; i < ntags; i++) {
+                    Stopwatch sw;
+                    nix::DataView view = mt.retrieveData(i, 0);
+                    view.getData(data);
+                    if (rep) {
+                        res->add(1, sw.us());
+                    }
+                }
+            });
+        }
+
+        if (report.enabled("tags", "multitag-retrieve-batch")) {
+            std::vector<nix::ndsize_t> indices(ntags);
+            for (size_t i = 0; i < ntags; i++) {
+                indices[i] = i;
+            }
 
-    ~DiskBenchmark() {
-        closeFile();
+            Result *res = nullptr;
+            with_cache_modes(opts, ws, [&](const std::string &mode) {
+                res = &report.add("tags", "multitag-retrieve-batch", params, mode, "positions");
+            }, [&](const std::string &mode, const size_t *rep) {
+                nix::MultiTag mt = ws.block.getMultiTag("multitag");
+                Stopwatch sw;
+                nix::MultiTagData data = mt.retrieveData(indices, 0);
+                if (rep) {
+                    res->add(ntags, sw.us());
+                }
+                if (data.counts.size() != ntags) {
+                    throw std::runtime_error("MultiTag: wrong number of slices retrieved");
+                }
+            });
+        }
     }
 
 private:
-    std::FILE *fd;
+    const Options &opts;
+    Report &report;
+    Workspace &ws;
 };
 
-class DiskReadBenchmark : public DiskBenchmark {
-public:
-    DiskReadBenchmark(const Config &cfg)
-            : DiskBenchmark(cfg) {
+/* ************************************ */
 
-    };
+// Unit parsing as it was done with boost::regex, the baseline for UnitBenchmark
+namespace legacy {
 
-    void run(nix::Block b) override {
-        openFile(true);
-        read_test();
-        closeFile();
-    }
+const std::string PREFIXES = "(Y|Z|E|P|T|G|M|k|h|da|d|c|m|u|n|p|f|a|z|y)";
+const std::string UNITS = "(m|g|s|A|K|mol|cd|Hz|N|Pa|J|W|C|V|F|S|Wb|T|H|lm|lx|Bq|Gy|Sv|kat|l|L|Ohm|%|dB|rad)";
+const std::string POWER = "(\\^[+-]?[1-9]\\d*)";
 
-    std::string id() override {
-        return "I";
+static bool isSIUnit(const std::string &unit) {
+    std::string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
+    boost::regex atomic(atomic_unit);
+    boost::regex compound("(" + atomic_unit + "(\\*|/))+" + atomic_unit);
+    return boost::regex_match(unit, atomic) || boost::regex_match(unit, compound);
+}
+
+static void splitUnit(const std::string &combined, std::string &prefix, std::string &unit, std::string &power) {
+    boost::regex prefix_and_unit_and_power(PREFIXES + UNITS + POWER);
+    boost::regex prefix_and_unit(PREFIXES + UNITS);
+    boost::regex unit_and_power(UNITS + POWER);
+    boost::regex unit_only(UNITS);
+    boost::regex prefix_only(PREFIXES);
+    boost::match_results<std::string::const_iterator> m;
+
+    prefix = unit = power = "";
+    if (boost::regex_match(combined, prefix_and_unit_and_power)) {
+        boost::regex_search(combined, m, prefix_only);
+        prefix = m[0];
+        std::string suffix = m.suffix();
+        boost::regex_search(suffix, m, unit_only);
+        unit = m[0];
+        power = std::string(m.suffix()).substr(1);
+    } else if (boost::regex_match(combined, unit_and_power)) {
+        boost::regex_search(combined, m, unit_only);
+        unit = m[0];
+        power = std::string(m.suffix()).substr(1);
+    } else if (boost::regex_match(combined, prefix_and_unit)) {
+        boost::regex_search(combined, m, prefix_only);
+        prefix = m[0];
+        unit = m.suffix();
+    } else {
+        unit = combined;
     }
-};
+}
 
-class DiskWriteBenchmark : public DiskBenchmark {
-public:
-    DiskWriteBenchmark(const Config &cfg)
-            : DiskBenchmark(cfg) {
+}
 
-    };
 
-    void run(nix::Block b) override {
-        openFile(false);
-        write_test();
-        closeFile();
+// Validates and splits units the way tags and dimensions do, once with the
+// regex baseline and once with nix::util
+static void unit_benchmark(const Options &opts, Report &report, bool legacy) {
+    const std::vector<std::string> units = {"mV", "s", "ms", "kHz", "mV^2", "uA", "Ohm", "mV/cm^2", "dB", "foo"};
+    const size_t rounds = opts.quick ? 100 : 1000;
+    std::string prefix, unit, power;
+    size_t valid = 0;
+
+    Result &res = report.add("units", legacy ? "regex" : "parser", "", "", "units");
+    for (size_t rep = 0; rep < opts.repetitions; rep++) {
+        Stopwatch sw;
+        for (size_t i = 0; i < rounds; i++) {
+            for (const std::string &u : units) {
+                bool si = legacy ? legacy::isSIUnit(u) : nix::util::isSIUnit(u);
+                if (si) {
+                    valid++;
+                    if (legacy) {
+                        legacy::splitUnit(u, prefix, unit, power);
+                    } else {
+                        nix::util::splitUnit(u, prefix, unit, power);
+                    }
+                }
+            }
+        }
+        res.add(rounds * units.size(), sw.us());
     }
 
-    std::string id() override {
-        return "O";
+    if (valid == 0) {
+        throw std::runtime_error("UnitBenchmark: no valid units");
     }
-};
+}
 
 /* ************************************ */
 
@@ -537,72 +1456,83 @@ static std::vector<Config> make_configs() {
 
     std::vector<Config> configs;
 
+    // every numeric data type, one block is a row
+    const std::vector<nix::DataType> dtypes = {
+        nix::DataType::Bool, nix::DataType::Float, nix::DataType::Double,
+        nix::DataType::Int8, nix::DataType::Int16, nix::DataType::Int32, nix::DataType::Int64,
+        nix::DataType::UInt8, nix::DataType::UInt16, nix::DataType::UInt32, nix::DataType::UInt64
+    };
+    for (nix::DataType dtype : dtypes) {
+        configs.emplace_back(dtype, nix::NDSize{1, 2048});
+    }
+
+    // one block is a column
     configs.emplace_back(nix::DataType::Double, nix::NDSize{2048, 1});
-    configs.emplace_back(nix::DataType::Double, nix::NDSize{1, 2048});
+
+    // write and read throughput per codec
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{1, 2048}, nix::Compression(nix::Codec::Deflate));
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{1, 2048}, nix::Compression(nix::Codec::Deflate, true));
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{1, 2048}, nix::Compression(nix::Codec::LZ4));
+    configs.emplace_back(nix::DataType::Int16, nix::NDSize{1, 2048}, nix::Compression(nix::Codec::LZ4, true));
 
     return configs;
 }
 
 int main(int argc, char **argv)
 {
-    nix::File fd = nix::File::open("iospeed.h5", nix::FileMode::Overwrite);
-    nix::Block block = fd.createBlock("speed", "nix.test");
-
-    std::vector<Config> configs = make_configs();
-    std::vector<Benchmark *> marks;
-
-    std::cout << "Performing generators tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        GeneratorBenchmark *benchmark = new GeneratorBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    Options opts;
+    try {
+        opts = parse_options(argc, argv);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n\n";
+        usage(std::cerr);
+        return 1;
     }
 
-    std::cout << "Performing disk IO tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        DiskWriteBenchmark *b = new DiskWriteBenchmark(cfg);
-        b->run(block);
-        marks.push_back(b);
-    }
+    Report report(opts);
 
-    std::cout << "Performing read tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        DiskReadBenchmark *b = new DiskReadBenchmark(cfg);
-        b->run(block);
-        marks.push_back(b);
+    if (report.enabled("io")) {
+        std::cerr << "Performing I/O tests..." << std::endl;
+        Workspace ws("iospeed.h5", "speed");
+        for (const Config &cfg : make_configs()) {
+            IOSuite(opts, report, ws, cfg).run();
+        }
     }
 
-    std::cout << "Performing write tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        WriteBenchmark *benchmark = new WriteBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    if (report.enabled("strings")) {
+        std::cerr << "Performing string tests..." << std::endl;
+        Workspace ws("stringspeed.h5", "strings");
+        StringSuite(opts, report, ws).run();
     }
 
-    std::cout << "Performing read tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        ReadBenchmark *benchmark = new ReadBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    if (report.enabled("entities") || report.enabled("sections") || report.enabled("properties")) {
+        std::cerr << "Performing metadata tests..." << std::endl;
+        Workspace ws("metaspeed.h5", "metadata");
+        MetadataSuite(opts, report, ws).run();
     }
 
-    std::cout << "Performing read (poly) tests..." << std::endl;
-    for (const Config &cfg : configs) {
-        ReadPolyBenchmark *benchmark = new ReadPolyBenchmark(cfg);
-        benchmark->run(block);
-        marks.push_back(benchmark);
+    if (report.enabled("tags")) {
+        std::cerr << "Performing tag tests..." << std::endl;
+        Workspace ws("tagspeed.h5", "tags");
+        TagSuite(opts, report, ws).run();
     }
 
-    std::cout << " === Reports ===" << std::endl;
-    std::cout.precision(5);
-    std::cout.unsetf (std::ios::floatfield);
-    for (Benchmark *mark : marks) {
-        std::cout << mark->cfg().name() << ", " << mark->id() << ", "
-                << mark->speed_in_mbs() << " MB/s, "
-                << mark->speed_in_nps() << " N/s" << std::endl;
-        delete mark;
+    if (report.enabled("units")) {
+        std::cerr << "Performing unit parsing tests..." << std::endl;
+        unit_benchmark(opts, report, true);
+        unit_benchmark(opts, report, false);
     }
 
+    if (opts.output.empty()) {
+        report.write(std::cout);
+    } else {
+        std::ofstream out(opts.output);
+        if (!out) {
+            std::cerr << "Could not open " << opts.output << std::endl;
+            return 1;
+        }
+        report.write(out);
+    }
 
     return 0;
 }
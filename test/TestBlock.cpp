@@ -292,6 +292,155 @@ void TestBlock::testMultiTagAccess() {
 }
 
 
+void TestBlock::testEntityHandles() {
+    vector<string> names = { "handle_c", "handle_a", "handle_b" };
+    vector<DataArray> created;
+    for (const auto &name : names) {
+        created.push_back(block.createDataArray(name, "channel", DataType::Double, nix::NDSize({ 0 })));
+    }
+    Tag tag = block.createTag("handle_tag", "event", {1.0});
+    MultiTag mtag = block.createMultiTag("handle_mtag", "events", created[0]);
+    Source source = block.createSource("handle_source", "electrode");
+
+    // enumeration has the same order as index access
+    vector<DataArray> arrays = block.dataArrays();
+    CPPUNIT_ASSERT_EQUAL(names.size(), arrays.size());
+    for (size_t i = 0; i < arrays.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(block.getDataArray(i).id(), arrays[i].id());
+    }
+
+    // handles of living entities share the backend object
+    DataArray by_id = block.getDataArray(created[1].id());
+    CPPUNIT_ASSERT(by_id.impl() == created[1].impl());
+    CPPUNIT_ASSERT(block.tags()[0].impl() == tag.impl());
+    CPPUNIT_ASSERT(block.multiTags()[0].impl() == mtag.impl());
+    CPPUNIT_ASSERT(block.sources()[0].impl() == source.impl());
+
+    // a deleted entity is never returned for a new one
+    string old_id = created[2].id();
+    block.deleteDataArray(created[2]);
+    DataArray replacement = block.createDataArray("handle_b", "channel", DataType::Double, nix::NDSize({ 0 }));
+    CPPUNIT_ASSERT(replacement.id() != old_id);
+    CPPUNIT_ASSERT_EQUAL(replacement.id(), block.getDataArray("handle_b").id());
+    CPPUNIT_ASSERT_EQUAL(names.size(), block.dataArrays().size());
+}
+
+
+void TestBlock::testDescribeDataArrays() {
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), block.describeDataArrays().size());
+
+    DataArray da_a = block.createDataArray("summary_a", "channel", DataType::Double, NDSize({ 10, 2 }));
+    da_a.unit("mV");
+    DataArray da_b = block.createDataArray("summary_b", "event", DataType::Int32, NDSize({ 0 }));
+    da_b.dataExtent(NDSize({ 7 }));
+    block_other.createDataArray("summary_c", "channel", DataType::String, NDSize({ 3 }));
+
+    DataArraySummary summary = block.describeDataArrays();
+    CPPUNIT_ASSERT_EQUAL(block.dataArrayCount(), static_cast<ndsize_t>(summary.size()));
+
+    for (size_t i = 0; i < summary.size(); i++) {
+        DataArray da = block.getDataArray(summary.id[i]);
+        CPPUNIT_ASSERT(da);
+        CPPUNIT_ASSERT_EQUAL(block.name(), summary.block[i]);
+        CPPUNIT_ASSERT_EQUAL(da.name(), summary.name[i]);
+        CPPUNIT_ASSERT_EQUAL(da.type(), summary.type[i]);
+        CPPUNIT_ASSERT_EQUAL(da.dataType(), summary.dtype[i]);
+        CPPUNIT_ASSERT_EQUAL(da.dataExtent(), summary.shape[i]);
+        CPPUNIT_ASSERT_EQUAL(da.unit() ? *da.unit() : string(), summary.unit[i]);
+        CPPUNIT_ASSERT_EQUAL(da.createdAt(), summary.created_at[i]);
+    }
+
+    DataArraySummary all = file.describeDataArrays();
+    CPPUNIT_ASSERT_EQUAL(summary.size() + block_other.dataArrayCount(), static_cast<ndsize_t>(all.size()));
+}
+
+
+void TestBlock::testSourceReferences() {
+    Source probe = block.createSource("probe", "probe");
+    Source shank = probe.createSource("shank", "shank");
+    Source channel = shank.createSource("channel", "channel");
+    Source unused = block.createSource("unused", "probe");
+
+    DataArray da = block.createDataArray("refs_da", "channel", DataType::Double, NDSize({ 0 }));
+    Tag tag = block.createTag("refs_tag", "event", {1.0});
+    MultiTag mtag = block.createMultiTag("refs_mtag", "event", da);
+    da.addSource(channel);
+    tag.addSource(channel);
+    tag.addSource(probe);
+    mtag.addSource(shank);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), block.findSources().size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.findSources(util::NameFilter<Source>("channel")).size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), shank.findSources(util::NameFilter<Source>("probe")).size());
+
+    vector<DataArray> arrays = block.referencingDataArrays(channel);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), arrays.size());
+    CPPUNIT_ASSERT_EQUAL(da.id(), arrays[0].id());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.referencingTags(channel).size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.referencingTags(probe).size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.referencingMultiTags(shank).size());
+    CPPUNIT_ASSERT(block.referencingDataArrays(unused).empty());
+    CPPUNIT_ASSERT(block.referencingMultiTags(channel).empty());
+    CPPUNIT_ASSERT_THROW(block.referencingTags(Source()), std::runtime_error);
+
+    // changes are visible immediately
+    tag.removeSource(probe);
+    CPPUNIT_ASSERT(block.referencingTags(probe).empty());
+    block.deleteDataArray(da);
+    CPPUNIT_ASSERT(block.referencingDataArrays(channel).empty());
+
+    CPPUNIT_ASSERT(block.deleteSource(probe));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.findSources().size());
+    CPPUNIT_ASSERT(block.findSources(util::NameFilter<Source>("channel")).empty());
+
+    // sources are found level by level
+    Source tree = block.createSource("tree", "tree");
+    Source a = tree.createSource("a", "node");
+    Source b = tree.createSource("b", "node");
+    Source a1 = a.createSource("a1", "node");
+    Source a2 = a.createSource("a2", "node");
+    Source b1 = b.createSource("b1", "node");
+    a1.createSource("a11", "leaf");
+    b1.createSource("b11", "leaf");
+
+    vector<string> expected = {"tree", "a", "b", "a1", "a2", "b1", "a11", "b11"};
+    vector<Source> found = tree.findSources();
+    CPPUNIT_ASSERT_EQUAL(expected.size(), found.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(expected[i], found[i].name());
+    }
+
+    found = tree.findSources(util::TypeFilter<Source>("leaf"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), found.size());
+    CPPUNIT_ASSERT_EQUAL(string("a11"), found[0].name());
+    CPPUNIT_ASSERT_EQUAL(string("b11"), found[1].name());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), tree.findSources(util::AcceptAll<Source>(), 1).size());
+
+    // adding sources to many entities does not rebuild the indexes of the file
+    const size_t count = 100;
+    vector<DataArray> arrays_many;
+    for (size_t i = 0; i < count; i++) {
+        arrays_many.push_back(block.createDataArray("many_" + util::numToStr(i), "channel",
+                                                    DataType::Double, NDSize({ 0 })));
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.findSources(util::NameFilter<Source>("b11")).size());
+
+    file.collectIOStats(true);
+    for (size_t i = 0; i < count; i++) {
+        arrays_many[i].addSource(i % 2 ? a1 : b1);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), block.findSources(util::NameFilter<Source>("b11")).size());
+    }
+    CPPUNIT_ASSERT(file.ioStats()[IOOperation::LinkIteration].calls < count);
+    file.collectIOStats(false);
+
+    CPPUNIT_ASSERT_EQUAL(count / 2, block.referencingDataArrays(a1).size());
+    CPPUNIT_ASSERT_EQUAL(count / 2, block.referencingDataArrays(b1).size());
+    CPPUNIT_ASSERT(arrays_many[0].removeSource(b1));
+    CPPUNIT_ASSERT_EQUAL(count / 2 - 1, block.referencingDataArrays(b1).size());
+    CPPUNIT_ASSERT_THROW(arrays_many[0].addSource(util::createId()), std::runtime_error);
+}
+
+
 void TestBlock::testOperators() {
     CPPUNIT_ASSERT(block_null == false);
     CPPUNIT_ASSERT(block_null == none);
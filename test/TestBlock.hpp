@@ -43,6 +43,9 @@ private:
     CPPUNIT_TEST(testDataArrayAccess);
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
+    CPPUNIT_TEST(testEntityHandles);
+    CPPUNIT_TEST(testDescribeDataArrays);
+    CPPUNIT_TEST(testSourceReferences);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -71,6 +74,9 @@ public:
     void testDataArrayAccess();
     void testTagAccess();
     void testMultiTagAccess();
+    void testEntityHandles();
+    void testDescribeDataArrays();
+    void testSourceReferences();
 
     void testOperators();
     void testUpdatedAt();
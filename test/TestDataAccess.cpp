@@ -141,6 +141,13 @@ void TestDataAccess::testPositionToIndexSampledDimension() {
     CPPUNIT_ASSERT_THROW(util::positionToIndex(0.005, invalid_unit, sampledDim), nix::IncompatibleDimensions);
     CPPUNIT_ASSERT(util::positionToIndex(5.0, unit, sampledDim) == 5);
     CPPUNIT_ASSERT(util::positionToIndex(0.005, scaled_unit, sampledDim) == 5);
+
+    vector<double> positions = {0.005, 0.0, 0.0121, 0.0004};
+    vector<size_t> indices = util::positionToIndex(positions, scaled_unit, sampledDim);
+    CPPUNIT_ASSERT(indices == vector<size_t>({5, 0, 12, 0}));
+    CPPUNIT_ASSERT(util::positionToIndex(vector<double>(), unit, sampledDim).empty());
+    CPPUNIT_ASSERT_THROW(util::positionToIndex(vector<double>({1.0, -1.0}), unit, sampledDim), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::positionToIndex(positions, invalid_unit, sampledDim), nix::IncompatibleDimensions);
 }
 
 
@@ -448,3 +455,67 @@ void TestDataAccess::testDataView() {
     double val = 0.0;
     CPPUNIT_ASSERT_THROW(io.getData(val, {}, {0, 0, 3}), OutOfBounds);
 }
+
+
+void TestDataAccess::testRetrieveDataBatch() {
+    CPPUNIT_ASSERT_THROW(util::retrieveData(multi_tag, vector<ndsize_t>{0}, 1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::retrieveData(multi_tag, vector<ndsize_t>{0, 2}, 0), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::retrieveData(multi_tag, vector<ndsize_t>{0, 1}, 0), nix::OutOfBounds);
+
+    MultiTagData batch = util::retrieveData(multi_tag, vector<ndsize_t>{0}, 0);
+    DataView view = util::retrieveData(multi_tag, 0, 0);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), batch.counts.size());
+    CPPUNIT_ASSERT_EQUAL(view.dataExtent(), batch.counts[0]);
+
+    vector<double> expected(view.dataExtent().nelms());
+    view.getData(DataType::Double, expected.data(), view.dataExtent(), NDSize(3, 0));
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(expected.size()), batch.data.num_elements());
+    for (size_t i = 0; i < expected.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(expected[i], batch.data.get<double>(i));
+    }
+
+    // many short, partly overlapping snippets of a sampled signal
+    vector<int32_t> signal(5000);
+    for (size_t i = 0; i < signal.size(); i++) {
+        signal[i] = static_cast<int32_t>(i);
+    }
+    DataArray recording = block.createDataArray("recording", "test", signal);
+    recording.appendSampledDimension(0.5).unit("ms");
+
+    typedef boost::multi_array<double, 2> position_type;
+    const size_t n = 200;
+    position_type spike_positions(boost::extents[n][1]);
+    position_type spike_extents(boost::extents[n][1]);
+    for (size_t i = 0; i < n; i++) {
+        // mix near and far positions, not sorted
+        spike_positions[i][0] = (i % 2 ? 2000.0 : 10.0) + ((i * 37) % 101) * 1.5;
+        spike_extents[i][0] = 2.0 + (i % 5);
+    }
+
+    DataArray spike_array = block.createDataArray("spike positions", "test", spike_positions);
+    DataArray extent_array = block.createDataArray("spike extents", "test", spike_extents);
+    MultiTag spikes = block.createMultiTag("spikes", "events", spike_array);
+    spikes.extents(extent_array);
+    spikes.units({"ms"});
+    spikes.addReference(recording);
+
+    vector<ndsize_t> indices;
+    for (ndsize_t i = n; i > 0; i--) {
+        indices.push_back(i - 1);
+    }
+
+    batch = spikes.retrieveData(indices, 0, DataType::Int32);
+    CPPUNIT_ASSERT_EQUAL(DataType::Int32, batch.data.dtype());
+    CPPUNIT_ASSERT_EQUAL(indices.size(), batch.offsets.size());
+
+    for (size_t k = 0; k < indices.size(); k++) {
+        view = spikes.retrieveData(indices[k], 0);
+        CPPUNIT_ASSERT_EQUAL(view.dataExtent(), batch.counts[k]);
+
+        vector<int32_t> snippet;
+        view.getData(snippet, view.dataExtent(), NDSize({0}));
+        for (size_t i = 0; i < snippet.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(snippet[i], batch.data.get<int32_t>(batch.offsets[k] + i));
+        }
+    }
+}
@@ -39,6 +39,7 @@ private:
     CPPUNIT_TEST(testMultiTagFeatureData);
     CPPUNIT_TEST(testMultiTagUnitSupport);
     CPPUNIT_TEST(testDataView);
+    CPPUNIT_TEST(testRetrieveDataBatch);
     CPPUNIT_TEST_SUITE_END ();
 
     nix::File file;
@@ -63,5 +64,6 @@ public:
     void testMultiTagFeatureData();
     void testMultiTagUnitSupport();
     void testDataView();
+    void testRetrieveDataBatch();
 };
 
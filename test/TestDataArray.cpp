@@ -12,8 +12,12 @@
 
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
+#include <nix/DataView.hpp>
+#include <nix/hdf5/BaseHDF5.hpp>
 
 #include <cstdint>
+#include <cstring>
+#include <numeric>
 
 using namespace nix;
 using namespace valid;
@@ -346,6 +350,40 @@ void TestDataArray::testPolynomial()
     for (size_t i = 0; i < dvin_poly.size(); i++) {
         CPPUNIT_ASSERT_EQUAL(static_cast<int32_t >(dv[i]-origin), dvin_poly[i]);
     }
+
+    // calibrated integer recordings, read directly into various types
+    std::vector<int16_t> raw = {-32768, -1000, -1, 0, 1, 1000, 32767};
+    nix::DataArray dai = block.createDataArray("polyio-int16", "int16", raw);
+    dai.polynomCoefficients({0.5, 0.25});
+    dai.expansionOrigin(1.0);
+
+    std::vector<double> cal_d(raw.size());
+    std::vector<float> cal_f(raw.size());
+    std::vector<int16_t> cal_s(raw.size());
+    std::vector<uint8_t> cal_u(raw.size());
+    dai.getData(DataType::Double, cal_d.data(), nix::NDSize({raw.size()}), nix::NDSize({0}));
+    dai.getData(DataType::Float, cal_f.data(), nix::NDSize({raw.size()}), nix::NDSize({0}));
+    dai.getData(DataType::Int16, cal_s.data(), nix::NDSize({raw.size()}), nix::NDSize({0}));
+    dai.getData(DataType::UInt8, cal_u.data(), nix::NDSize({raw.size()}), nix::NDSize({0}));
+
+    for (size_t i = 0; i < raw.size(); i++) {
+        double expected = 0.5 + 0.25 * (raw[i] - 1.0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, cal_d[i], 1e-12);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, cal_f[i], 1e-3);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int16_t>(expected), cal_s[i]);
+        // out of range values are clamped
+        uint8_t clamped = expected < 0 ? 0 : static_cast<uint8_t>(std::min(expected, 255.0));
+        CPPUNIT_ASSERT_EQUAL(clamped, cal_u[i]);
+    }
+
+    // higher order polynomials on integer data
+    dai.polynomCoefficients({1.0, 2.0, 3.0});
+    dai.expansionOrigin(0.0);
+    dai.getData(DataType::Double, cal_d.data(), nix::NDSize({raw.size()}), nix::NDSize({0}));
+    for (size_t i = 0; i < raw.size(); i++) {
+        double x = raw[i];
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 2.0 * x + 3.0 * x * x, cal_d[i], 1e-6);
+    }
 }
 
 void TestDataArray::testLabel()
@@ -435,6 +473,602 @@ void TestDataArray::testDimension()
 }
 
 
+void TestDataArray::testChunkCache()
+{
+    const ndsize_t rows = 300, cols = 40;
+    std::vector<int32_t> values(rows * cols);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i);
+    }
+
+    DataArray da = block.createDataArray("cached", "int", DataType::Int32, NDSize({rows, cols}));
+    da.setData(DataType::Int32, values.data(), NDSize({rows, cols}), NDSize({0, 0}));
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), da.chunkCacheStats().capacity);
+
+    da.chunkCache(1024 * 1024, 2);
+    CPPUNIT_ASSERT_EQUAL(size_t(1024 * 1024), da.chunkCacheStats().capacity);
+
+    // sliding, overlapping windows, read as native and as converted type
+    for (ndsize_t start = 0; start + 20 <= rows; start += 7) {
+        std::vector<int32_t> window(20 * 10);
+        da.getData(DataType::Int32, window.data(), NDSize({20, 10}), NDSize({start, ndsize_t(15)}));
+
+        std::vector<double> converted(20 * 10);
+        da.getData(DataType::Double, converted.data(), NDSize({20, 10}), NDSize({start, ndsize_t(15)}));
+
+        for (ndsize_t i = 0; i < 20; i++) {
+            for (ndsize_t j = 0; j < 10; j++) {
+                int32_t expected = values[(start + i) * cols + 15 + j];
+                CPPUNIT_ASSERT_EQUAL(expected, window[i * 10 + j]);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(expected), converted[i * 10 + j], 0.0);
+            }
+        }
+    }
+
+    ChunkCacheStats stats = da.chunkCacheStats();
+    CPPUNIT_ASSERT(stats.hits > 0);
+    CPPUNIT_ASSERT(stats.misses > 0);
+    CPPUNIT_ASSERT(stats.size > 0 && stats.size <= stats.capacity);
+
+    // other handles of the same entity share the cache
+    DataArray other = block.getDataArray(da.id());
+    CPPUNIT_ASSERT_EQUAL(stats.hits, other.chunkCacheStats().hits);
+
+    // writes must be visible through the cache
+    std::vector<int32_t> patch(5 * 5, -1);
+    da.setData(DataType::Int32, patch.data(), NDSize({5, 5}), NDSize({100, 10}));
+
+    std::vector<int32_t> check(10 * 10);
+    other.getData(DataType::Int32, check.data(), NDSize({10, 10}), NDSize({98, 8}));
+    for (ndsize_t i = 0; i < 10; i++) {
+        for (ndsize_t j = 0; j < 10; j++) {
+            bool patched = i >= 2 && i < 7 && j >= 2 && j < 7;
+            int32_t expected = patched ? -1 : values[(98 + i) * cols + 8 + j];
+            CPPUNIT_ASSERT_EQUAL(expected, check[i * 10 + j]);
+        }
+    }
+
+    // rows beyond the logical extent are neither served by the cache nor read
+    da.impl()->logicalExtent(NDSize({ndsize_t(200), cols}));
+    stats = da.chunkCacheStats();
+    std::vector<int32_t> tail(10 * cols);
+    CPPUNIT_ASSERT_THROW(da.getData(DataType::Int32, tail.data(), NDSize({ndsize_t(10), cols}),
+                                    NDSize({ndsize_t(195), ndsize_t(0)})),
+                         OutOfBounds);
+    CPPUNIT_ASSERT_EQUAL(stats.hits, da.chunkCacheStats().hits);
+    CPPUNIT_ASSERT_EQUAL(stats.misses, da.chunkCacheStats().misses);
+    da.impl()->logicalExtent(none);
+
+    // reads larger than the cache bypass it
+    da.chunkCache(64, 0);
+    std::vector<int32_t> all(rows * cols);
+    da.getData(DataType::Int32, all.data(), NDSize({rows, cols}), NDSize({0, 0}));
+    CPPUNIT_ASSERT_EQUAL(-1, all[100 * cols + 10]);
+    CPPUNIT_ASSERT_EQUAL(values[rows * cols - 1], all[rows * cols - 1]);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), da.chunkCacheStats().size);
+
+    da.chunkCache(none);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), da.chunkCacheStats().capacity);
+}
+
+
+void TestDataArray::testChunkShape()
+{
+    DataArray guessed = block.createDataArray("guessed", "double", DataType::Double, NDSize({1024, 1024}));
+    CPPUNIT_ASSERT_EQUAL(NDSize({64, 64}), guessed.chunkShape());
+
+    ChunkingHint hint;
+    hint.append_axis = 0;
+    hint.read_shape = NDSize({0, 1});
+    hint.target_bytes = 8192;
+
+    DataArray recording = block.createDataArray("recording", "int16", DataType::Int16, NDSize({0, 64}), hint);
+    CPPUNIT_ASSERT_EQUAL(NDSize({4096, 1}), recording.chunkShape());
+
+    std::vector<int16_t> samples(5000 * 64, 1);
+    recording.dataExtent(NDSize({5000, 64}));
+    recording.setData(DataType::Int16, samples.data(), NDSize({5000, 64}), NDSize({0, 0}));
+    CPPUNIT_ASSERT_EQUAL(NDSize({5000, 64}), recording.dataExtent());
+
+    // invalid hints do not leave a data array behind
+    hint.read_shape = NDSize({1});
+    CPPUNIT_ASSERT_THROW(block.createDataArray("bad_read_shape", "int16", DataType::Int16, NDSize({0, 64}), hint),
+                         InvalidRank);
+    CPPUNIT_ASSERT(!block.hasDataArray("bad_read_shape"));
+
+    hint.read_shape = NDSize();
+    hint.append_axis = 2;
+    CPPUNIT_ASSERT_THROW(block.createDataArray("bad_axis", "int16", DataType::Int16, NDSize({0, 64}), hint),
+                         OutOfBounds);
+    CPPUNIT_ASSERT(!block.hasDataArray("bad_axis"));
+}
+
+
+void TestDataArray::testCompression()
+{
+    const ndsize_t rows = 3000, cols = 16;
+
+    // slowly varying, constant and noisy columns to cover long matches,
+    // short matches and incompressible data
+    std::vector<int32_t> values(rows * cols);
+    uint32_t state = 42;
+    for (ndsize_t i = 0; i < rows; i++) {
+        for (ndsize_t j = 0; j < cols; j++) {
+            state = state * 1664525 + 1013904223;
+            int32_t v = j < 8 ? static_cast<int32_t>(i / 10 + j) : (j < 12 ? 7 : static_cast<int32_t>(state));
+            values[i * cols + j] = v;
+        }
+    }
+
+    std::vector<Compression> settings = {
+        Compression(Codec::None, true),
+        Compression(Codec::Deflate),
+        Compression(Codec::Deflate, true, 9),
+        Compression(Codec::LZ4),
+        Compression(Codec::LZ4, true)
+    };
+
+    std::vector<std::string> ids;
+    for (size_t k = 0; k < settings.size(); k++) {
+        DataArray da = block.createDataArray("compressed_" + nix::util::numToStr(k), "int", DataType::Int32,
+                                             NDSize({rows, cols}), settings[k]);
+        da.setData(DataType::Int32, values.data(), NDSize({rows, cols}), NDSize({0, 0}));
+        ids.push_back(da.id());
+    }
+
+    // also with reopening to make sure the data is decoded from the file
+    const std::string block_id = block.id();
+    file.close();
+    file = nix::File::open("test_DataArray.h5", nix::FileMode::ReadOnly);
+    Block b = file.getBlock(block_id);
+
+    for (const std::string &id : ids) {
+        DataArray da = b.getDataArray(id);
+
+        std::vector<int32_t> all(rows * cols);
+        da.getData(DataType::Int32, all.data(), NDSize({rows, cols}), NDSize({0, 0}));
+        CPPUNIT_ASSERT(all == values);
+
+        std::vector<double> part(100 * 5);
+        da.getData(DataType::Double, part.data(), NDSize({100, 5}), NDSize({1234, 6}));
+        for (ndsize_t i = 0; i < 100; i++) {
+            for (ndsize_t j = 0; j < 5; j++) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<double>(values[(1234 + i) * cols + 6 + j]), part[i * 5 + j]);
+            }
+        }
+    }
+
+    file.close();
+    file = nix::File::open("test_DataArray.h5", nix::FileMode::ReadWrite);
+    block = file.getBlock(block_id);
+
+    // tiny and empty data sets
+    DataArray tiny = block.createDataArray("tiny", "int", DataType::Int32, NDSize({3}), Compression(Codec::LZ4));
+    std::vector<int32_t> three = {1, 2, 3}, back(3);
+    tiny.setData(DataType::Int32, three.data(), NDSize({3}), NDSize({0}));
+    tiny.getData(DataType::Int32, back.data(), NDSize({3}), NDSize({0}));
+    CPPUNIT_ASSERT(three == back);
+    CPPUNIT_ASSERT_THROW(tiny.createData(DataType::Int32, NDSize({3}), Compression(Codec::LZ4)), std::runtime_error);
+
+    DataArray empty = block.createDataArray("empty", "int", DataType::Int32, NDSize({0}), Compression(Codec::Deflate));
+    CPPUNIT_ASSERT_EQUAL(NDSize({0}), empty.dataExtent());
+
+    CPPUNIT_ASSERT_THROW(block.createDataArray("bad_level", "int", DataType::Int32, NDSize({10}),
+                                               Compression(Codec::Deflate, false, 10)),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT(!block.hasDataArray("bad_level"));
+
+    // a chunk header claiming more than the chunk holds fails the read
+    // instead of allocating for it
+    file.close();
+    {
+        hid_t fid = H5Fopen("test_DataArray.h5", H5F_ACC_RDWR, H5P_DEFAULT);
+        hid_t ds = H5Dopen2(fid, "/data/block_one/data_arrays/tiny/data", H5P_DEFAULT);
+        CPPUNIT_ASSERT(ds >= 0);
+        std::vector<unsigned char> chunk(12 + 4 + 12, 0);
+        std::fill(chunk.begin(), chunk.begin() + 8, 0xFF);
+        chunk[11] = 12;
+        chunk[15] = 12;
+        hsize_t origin[1] = {0};
+        CPPUNIT_ASSERT(H5Dwrite_chunk(ds, H5P_DEFAULT, 0, origin, chunk.size(), chunk.data()) >= 0);
+        H5Dclose(ds);
+        H5Fclose(fid);
+    }
+
+    file = nix::File::open("test_DataArray.h5", nix::FileMode::ReadOnly);
+    DataArray corrupt = file.getBlock(block_id).getDataArray("tiny");
+    CPPUNIT_ASSERT_THROW(corrupt.getData(DataType::Int32, back.data(), NDSize({3}), NDSize({0})), std::exception);
+    file.readThreads(2);
+    CPPUNIT_ASSERT_THROW(corrupt.getData(DataType::Int32, back.data(), NDSize({3}), NDSize({0})), std::exception);
+    corrupt = none;
+}
+
+
+void TestDataArray::testAppender()
+{
+    DataArray da = block.createDataArray("appended", "int", DataType::Int32, NDSize({0, 3}));
+
+    CPPUNIT_ASSERT_THROW(DataAppender(da, 2), InvalidRank);
+
+    {
+        DataAppender appender(da, 0, 64);
+        CPPUNIT_ASSERT_THROW(appender.append(DataType::Int32, nullptr, NDSize({2, 4})), IncompatibleDimensions);
+
+        std::vector<int32_t> row(3);
+        for (int32_t i = 0; i < 100; i++) {
+            row = {i, i + 1000, i + 2000};
+            appender.append(DataType::Int32, row.data(), NDSize({1, 3}));
+            CPPUNIT_ASSERT_EQUAL(ndsize_t(i + 1), appender.length());
+        }
+
+        // data set is allocated ahead, but only the written data is visible
+        NDSize extent = da.dataExtent();
+        CPPUNIT_ASSERT_EQUAL(ndsize_t(3), extent[1]);
+        CPPUNIT_ASSERT_EQUAL(ndsize_t(96), extent[0]);
+
+        std::vector<int32_t> beyond(3);
+        CPPUNIT_ASSERT_THROW(da.getData(DataType::Int32, beyond.data(), NDSize({1, 3}), NDSize({96, 0})),
+                             OutOfBounds);
+
+        std::vector<int32_t> block_rows = {100, 1100, 2100, 101, 1101, 2101};
+        appender.append(DataType::Int32, block_rows.data(), NDSize({2, 3}));
+
+        appender.close();
+        CPPUNIT_ASSERT_THROW(appender.append(DataType::Int32, row.data(), NDSize({1, 3})), std::runtime_error);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(NDSize({102, 3}), da.dataExtent());
+
+    std::vector<int32_t> data(102 * 3);
+    da.getData(DataType::Int32, data.data(), NDSize({102, 3}), NDSize({0, 0}));
+    for (int32_t i = 0; i < 102; i++) {
+        CPPUNIT_ASSERT_EQUAL(i, data[i * 3]);
+        CPPUNIT_ASSERT_EQUAL(i + 1000, data[i * 3 + 1]);
+        CPPUNIT_ASSERT_EQUAL(i + 2000, data[i * 3 + 2]);
+    }
+
+    // appending along an inner axis, trimmed by the destructor
+    DataArray cols = block.createDataArray("columns", "double", DataType::Double, NDSize({2, 0}));
+    {
+        DataAppender appender(cols, 1, 1024);
+        for (int i = 0; i < 10; i++) {
+            std::vector<double> block_cols = {double(i), double(i) + 0.5, -double(i), -double(i) - 0.5};
+            appender.append(DataType::Double, block_cols.data(), NDSize({2, 2}));
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(NDSize({2, 20}), cols.dataExtent());
+    std::vector<double> col_data(2 * 20);
+    cols.getData(DataType::Double, col_data.data(), NDSize({2, 20}), NDSize({0, 0}));
+    for (int i = 0; i < 10; i++) {
+        CPPUNIT_ASSERT_EQUAL(double(i), col_data[2 * i]);
+        CPPUNIT_ASSERT_EQUAL(double(i) + 0.5, col_data[2 * i + 1]);
+        CPPUNIT_ASSERT_EQUAL(-double(i), col_data[20 + 2 * i]);
+        CPPUNIT_ASSERT_EQUAL(-double(i) - 0.5, col_data[20 + 2 * i + 1]);
+    }
+
+    // whole reads through a second handle stay within the logical extent
+    // while the appender holds rows allocated ahead
+    DataArray samples = block.createDataArray("samples", "double", DataType::Double, NDSize({0}));
+    DataArray words = block.createDataArray("appended_words", "string", DataType::String, NDSize({0}));
+    {
+        DataAppender appender(samples, 0, 1);
+        DataAppender word_appender(words, 0);
+        std::vector<double> chunk(100);
+        std::iota(chunk.begin(), chunk.end(), 0.0);
+        appender.append(DataType::Double, chunk.data(), NDSize({100}));
+        appender.append(DataType::Double, chunk.data(), NDSize({10}));
+
+        std::vector<std::string> appended_words = {"alpha", "beta", "gamma"};
+        word_appender.append(DataType::String, appended_words.data(), NDSize({3}));
+        word_appender.append(DataType::String, appended_words.data(), NDSize({1}));
+
+        DataArray other = block.getDataArray(samples.id());
+        std::vector<double> values;
+        other.getData(values);
+        CPPUNIT_ASSERT_EQUAL(size_t(110), values.size());
+        CPPUNIT_ASSERT_EQUAL(99.0, values[99]);
+        CPPUNIT_ASSERT_EQUAL(9.0, values[109]);
+
+        std::vector<std::string> read_words;
+        block.getDataArray(words.id()).getData(read_words);
+        CPPUNIT_ASSERT_EQUAL(size_t(4), read_words.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("alpha"), read_words[3]);
+
+        StringColumn column;
+        words.getData(column);
+        CPPUNIT_ASSERT_EQUAL(size_t(4), column.size());
+    }
+}
+
+
+void TestDataArray::testStringColumn()
+{
+    std::vector<std::string> words(500);
+    for (size_t i = 0; i < words.size(); i++) {
+        words[i] = "word" + std::string(i % 7, '-') + std::to_string(i);
+    }
+    words[3] = "";
+    words[4] = std::string(100000, 'x');
+
+    DataArray da = block.createDataArray("words", "string", words);
+
+    StringColumn column;
+    da.getData(column);
+    CPPUNIT_ASSERT_EQUAL(words.size(), column.size());
+    CPPUNIT_ASSERT(column.strings() == words);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), column.length(3));
+    CPPUNIT_ASSERT_EQUAL(std::string("word--2"), std::string(column.c_str(2)));
+
+    da.getData(column, NDSize({10}), NDSize({100}));
+    CPPUNIT_ASSERT_EQUAL(size_t(10), column.size());
+    for (size_t i = 0; i < column.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(words[100 + i], column[i]);
+    }
+
+    StringColumn replacement;
+    replacement.push_back("alpha");
+    replacement.push_back(std::string("beta"));
+    da.setData(replacement, NDSize({498}));
+
+    std::vector<std::string> read;
+    da.getData(read);
+    CPPUNIT_ASSERT_EQUAL(words[497], read[497]);
+    CPPUNIT_ASSERT_EQUAL(std::string("alpha"), read[498]);
+    CPPUNIT_ASSERT_EQUAL(std::string("beta"), read[499]);
+
+    CPPUNIT_ASSERT_THROW(da.setData(replacement, NDSize({3}), NDSize({0})), std::invalid_argument);
+
+    da.setData(replacement);
+    CPPUNIT_ASSERT_EQUAL(NDSize({2}), da.dataExtent());
+    da.getData(column);
+    CPPUNIT_ASSERT(column.strings() == replacement.strings());
+}
+
+
+void TestDataArray::testMap()
+{
+    std::vector<int32_t> values(300 * 4);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i * 3) - 100;
+    }
+
+    ChunkingHint hint;
+    hint.contiguous = true;
+    DataArray flat = block.createDataArray("flat", "int", DataType::Int32, NDSize({300, 4}), hint);
+    CPPUNIT_ASSERT(!flat.chunkShape());
+    flat.setData(DataType::Int32, values.data(), NDSize({300, 4}), NDSize({0, 0}));
+
+    MappedArray view = flat.map();
+    CPPUNIT_ASSERT(view.isMapped());
+    CPPUNIT_ASSERT_EQUAL(NDSize({300, 4}), view.shape());
+    CPPUNIT_ASSERT_EQUAL(NDSize({4, 1}), view.strides());
+    CPPUNIT_ASSERT_EQUAL(DataType::Int32, view.dtype());
+    CPPUNIT_ASSERT_EQUAL(values[0], view.get<int32_t>(0));
+    CPPUNIT_ASSERT_EQUAL(values[1199], view.get<int32_t>(1199));
+    CPPUNIT_ASSERT_EQUAL(values[42 * 4 + 3], view.get<int32_t>(NDSize({42, 3})));
+
+    // chunked data is read instead
+    DataArray chunked = block.createDataArray("chunked", "int", DataType::Int32, NDSize({300, 4}));
+    chunked.setData(DataType::Int32, values.data(), NDSize({300, 4}), NDSize({0, 0}));
+    MappedArray copy = chunked.map();
+    CPPUNIT_ASSERT(!copy.isMapped());
+    CPPUNIT_ASSERT_EQUAL(NDSize({300, 4}), copy.shape());
+    CPPUNIT_ASSERT_EQUAL(0, std::memcmp(copy.data(), values.data(), values.size() * sizeof(int32_t)));
+
+    // the view has the stored type
+    DataArray converted = block.createDataArray("converted", "int", DataType::Int64, NDSize({10}), hint);
+    converted.setData(DataType::Int32, values.data(), NDSize({10}), NDSize({0}));
+    MappedArray conv = converted.map();
+    CPPUNIT_ASSERT_EQUAL(DataType::Int64, conv.dtype());
+    CPPUNIT_ASSERT_EQUAL(int64_t(values[9]), conv.get<int64_t>(9));
+
+    hint.append_axis = 0;
+    CPPUNIT_ASSERT_THROW(block.createDataArray("growing", "int", DataType::Int32, NDSize({0, 4}), hint),
+                         std::invalid_argument);
+    CPPUNIT_ASSERT(!block.hasDataArray("growing"));
+}
+
+
+void TestDataArray::testSelection()
+{
+    std::vector<int32_t> values(100 * 8);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i);
+    }
+
+    DataArray da = block.createDataArray("selected", "int", DataType::Int32, NDSize({100, 8}));
+    da.setData(DataType::Int32, values.data(), NDSize({100, 8}), NDSize({0, 0}));
+
+    // every other row
+    std::vector<int32_t> data;
+    DataSelection strided(NDSize({0, 0}), NDSize({50, 8}), NDSize({2, 1}));
+    CPPUNIT_ASSERT_EQUAL(NDSize({50, 8}), strided.shape());
+    da.getData(data, strided);
+    CPPUNIT_ASSERT_EQUAL(size_t(400), data.size());
+    CPPUNIT_ASSERT_EQUAL(values[2 * 8 + 3], data[8 + 3]);
+    CPPUNIT_ASSERT_EQUAL(values[98 * 8 + 7], data[399]);
+
+    // pairs of rows, 20 rows apart
+    DataSelection blocks(NDSize({0, 0}), NDSize({5, 8}), NDSize({20, 1}), NDSize({2, 1}));
+    CPPUNIT_ASSERT_EQUAL(NDSize({10, 8}), blocks.shape());
+    da.getData(data, blocks);
+    CPPUNIT_ASSERT_EQUAL(values[8], data[8]);
+    CPPUNIT_ASSERT_EQUAL(values[21 * 8], data[3 * 8]);
+
+    // decimated channel subset
+    DataSelection preview = DataSelection::decimate(NDSize({0, 0}), NDSize({100, 8}), 0, 10);
+    preview.only(1, {1, 2, 5});
+    CPPUNIT_ASSERT_EQUAL(size_t(2), preview.hyperslabs().size());
+    CPPUNIT_ASSERT_EQUAL(NDSize({10, 3}), preview.shape());
+    da.getData(data, preview);
+    CPPUNIT_ASSERT_EQUAL(size_t(30), data.size());
+    for (size_t r = 0; r < 10; r++) {
+        CPPUNIT_ASSERT_EQUAL(values[r * 10 * 8 + 1], data[r * 3]);
+        CPPUNIT_ASSERT_EQUAL(values[r * 10 * 8 + 2], data[r * 3 + 1]);
+        CPPUNIT_ASSERT_EQUAL(values[r * 10 * 8 + 5], data[r * 3 + 2]);
+    }
+
+    // points in the order they were added
+    DataSelection points;
+    points.addPoint(NDSize({3, 4})).addPoint(NDSize({0, 1})).addPoint(NDSize({99, 7}));
+    da.getData(data, points);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), data.size());
+    CPPUNIT_ASSERT_EQUAL(values[3 * 8 + 4], data[0]);
+    CPPUNIT_ASSERT_EQUAL(values[1], data[1]);
+    CPPUNIT_ASSERT_EQUAL(values[799], data[2]);
+
+    // calibration is applied
+    da.polynomCoefficients({1.0, 2.0});
+    std::vector<double> calibrated;
+    da.getData(calibrated, points);
+    CPPUNIT_ASSERT_EQUAL(1.0 + 2.0 * values[1], calibrated[1]);
+    da.polynomCoefficients(std::vector<double>());
+
+    // views translate the selection
+    DataView view(da, NDSize({10, 4}), NDSize({20, 2}));
+    view.getData(data, DataSelection(NDSize({0, 0}), NDSize({5, 4}), NDSize({2, 1})));
+    CPPUNIT_ASSERT_EQUAL(size_t(20), data.size());
+    CPPUNIT_ASSERT_EQUAL(values[20 * 8 + 2], data[0]);
+    CPPUNIT_ASSERT_EQUAL(values[28 * 8 + 5], data[19]);
+    CPPUNIT_ASSERT_THROW(view.getData(data, DataSelection(NDSize({0, 0}), NDSize({6, 4}), NDSize({2, 1}))),
+                         OutOfBounds);
+
+    CPPUNIT_ASSERT_THROW(da.getData(data, DataSelection(NDSize({0, 0}), NDSize({51, 8}), NDSize({2, 1}))),
+                         OutOfBounds);
+
+    DataSelection overlap(NDSize({0, 0}), NDSize({2, 8}));
+    overlap.add(NDSize({1, 0}), NDSize({2, 8}));
+    CPPUNIT_ASSERT_THROW(da.getData(data, overlap), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(overlap.addPoint(NDSize({0, 0})), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(DataSelection(NDSize({0, 0}), NDSize({2, 8}), NDSize({1, 1}), NDSize({2, 1})),
+                         std::invalid_argument);
+}
+
+// compare an envelope of channel c with the min, max and mean of the samples
+static void check_envelope(const Envelope &env, const std::vector<double> &samples,
+                           size_t channels, size_t c, ndsize_t end) {
+    CPPUNIT_ASSERT(env.step > 0);
+    CPPUNIT_ASSERT_EQUAL(env.min.size(), static_cast<size_t>(env.shape.nelms()));
+
+    for (ndsize_t i = 0; i < env.shape[0]; i++) {
+        ndsize_t first = env.start + i * env.step;
+        ndsize_t last = std::min(first + env.step, end);
+        double lo = samples[first * channels + c], hi = lo, sum = 0.0;
+
+        for (ndsize_t s = first; s < last; s++) {
+            lo = std::min(lo, samples[s * channels + c]);
+            hi = std::max(hi, samples[s * channels + c]);
+            sum += samples[s * channels + c];
+        }
+
+        CPPUNIT_ASSERT_EQUAL(lo, env.min[i * channels + c]);
+        CPPUNIT_ASSERT_EQUAL(hi, env.max[i * channels + c]);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sum / (last - first), env.mean[i * channels + c], 1e-9);
+    }
+}
+
+
+void TestDataArray::testOverview()
+{
+    std::vector<double> samples(10000);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = static_cast<double>((i * 37) % 1001) - 500.0;
+    }
+
+    DataArray da = block.createDataArray("overview", "double", DataType::Double, NDSize({10000}));
+    da.setData(DataType::Double, samples.data(), NDSize({10000}), NDSize({0}));
+
+    // computed from the data without an overview
+    CPPUNIT_ASSERT(!da.hasOverview());
+    Envelope env = da.envelope(100, 50, 10);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(100), env.start);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(5), env.step);
+    CPPUNIT_ASSERT_EQUAL(NDSize({10, 1}), env.shape);
+    check_envelope(env, samples, 1, 0, 150);
+
+    CPPUNIT_ASSERT_THROW(da.overview(1), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(da.overview(16, 1), InvalidRank);
+
+    da.overview(16);
+    CPPUNIT_ASSERT(da.hasOverview());
+
+    env = da.envelope(0, 10000, 100);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(64), env.step);
+    CPPUNIT_ASSERT_EQUAL(NDSize({157, 1}), env.shape);
+    check_envelope(env, samples, 1, 0, 10000);
+
+    // the range is extended to whole bins
+    env = da.envelope(1000, 4000, 20);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(128), env.step);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(896), env.start);
+    check_envelope(env, samples, 1, 0, 10000);
+
+    // few samples per point are computed from the data
+    env = da.envelope(100, 50, 10);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(5), env.step);
+    check_envelope(env, samples, 1, 0, 150);
+
+    // appending and overwriting keeps the overview up to date
+    std::vector<double> more(3000);
+    for (size_t i = 0; i < more.size(); i++) {
+        more[i] = static_cast<double>(i % 17);
+    }
+    da.appendData(DataType::Double, more.data(), NDSize({3000}), 0);
+    samples.insert(samples.end(), more.begin(), more.end());
+
+    double peak = 1e6;
+    da.setData(DataType::Double, &peak, NDSize({1}), NDSize({5000}));
+    samples[5000] = peak;
+
+    env = da.envelope(0, 13000, 50);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(256), env.step);
+    check_envelope(env, samples, 1, 0, 13000);
+    CPPUNIT_ASSERT_EQUAL(peak, env.max[5000 / 256]);
+
+    // shrinking drops the levels that are no longer needed
+    da.dataExtent(NDSize({600}));
+    samples.resize(600);
+    env = da.envelope(0, 600, 1);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(512), env.step);
+    CPPUNIT_ASSERT_EQUAL(NDSize({2, 1}), env.shape);
+    check_envelope(env, samples, 1, 0, 600);
+
+    // channels along the first dimension, samples along the second
+    std::vector<double> columns(1000 * 3);
+    for (size_t i = 0; i < 1000; i++) {
+        for (size_t c = 0; c < 3; c++) {
+            columns[i * 3 + c] = static_cast<double>(c) * 1000.0 + static_cast<double>((i * 13) % 97);
+        }
+    }
+
+    DataArray multi = block.createDataArray("overview_2d", "double", DataType::Double, NDSize({3, 0}));
+    multi.overview(10, 1);
+
+    {
+        DataAppender appender(multi, 1, 1024);
+        for (size_t i = 0; i < 1000; i++) {
+            appender.append(DataType::Double, &columns[i * 3], NDSize({3, 1}));
+        }
+    }
+
+    env = multi.envelope(0, 1000, 20);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(40), env.step);
+    CPPUNIT_ASSERT_EQUAL(NDSize({25, 3}), env.shape);
+    for (size_t c = 0; c < 3; c++) {
+        check_envelope(env, columns, 3, c, 1000);
+    }
+
+    multi.overview(none);
+    CPPUNIT_ASSERT(!multi.hasOverview());
+
+    std::vector<std::string> words = {"a", "b"};
+    DataArray text = block.createDataArray("overview_text", "string", words);
+    CPPUNIT_ASSERT_THROW(text.overview(), std::invalid_argument);
+}
+
+
 void TestDataArray::testOperator()
 {
     std::stringstream mystream;
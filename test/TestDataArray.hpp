@@ -46,6 +46,14 @@ public:
     void testLabel();
     void testUnit();
     void testDimension();
+    void testChunkCache();
+    void testChunkShape();
+    void testCompression();
+    void testAppender();
+    void testStringColumn();
+    void testMap();
+    void testSelection();
+    void testOverview();
     void testOperator();
     void testValidate();
 
@@ -62,6 +70,14 @@ private:
     CPPUNIT_TEST(testLabel);
     CPPUNIT_TEST(testUnit);
     CPPUNIT_TEST(testDimension);
+    CPPUNIT_TEST(testChunkCache);
+    CPPUNIT_TEST(testChunkShape);
+    CPPUNIT_TEST(testCompression);
+    CPPUNIT_TEST(testAppender);
+    CPPUNIT_TEST(testStringColumn);
+    CPPUNIT_TEST(testMap);
+    CPPUNIT_TEST(testSelection);
+    CPPUNIT_TEST(testOverview);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
 
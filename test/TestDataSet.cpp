@@ -164,6 +164,38 @@ void TestDataSet::testChunkGuessing() {
     CPPUNIT_ASSERT_EQUAL(chunks[1], 64ULL);
 }
 
+void TestDataSet::testChunkPlanning() {
+    ChunkingHint hint;
+
+    // no hint at all is the same as guessing
+    NDSize dims({1024, 1024});
+    CPPUNIT_ASSERT_EQUAL(hdf5::DataSet::guessChunking(dims, sizeof(double)),
+                         hdf5::DataSet::planChunking(dims, sizeof(double), hint));
+
+    // appending along time, chunks span all channels
+    hint.append_axis = 0;
+    hint.target_bytes = 64 * 1024;
+    CPPUNIT_ASSERT_EQUAL(NDSize({256, 64}), hdf5::DataSet::planChunking(NDSize({0, 64}), sizeof(float), hint));
+    CPPUNIT_ASSERT_EQUAL(NDSize({1280, 8}), hdf5::DataSet::planChunking(NDSize({10, 8}), sizeof(float), hint));
+
+    // reading single channels, chunks never span several channels
+    hint.append_axis = boost::none;
+    hint.read_shape = NDSize({0, 1});
+    CPPUNIT_ASSERT_EQUAL(NDSize({12500, 1}), hdf5::DataSet::planChunking(NDSize({100000, 64}), sizeof(float), hint));
+
+    // the read shape is only given up if nothing else is left
+    hint.read_shape = NDSize({32, 32});
+    hint.target_bytes = 256;
+    CPPUNIT_ASSERT_EQUAL(NDSize({8, 8}), hdf5::DataSet::planChunking(NDSize({100, 100}), sizeof(float), hint));
+
+    hint.read_shape = NDSize({10});
+    CPPUNIT_ASSERT_THROW(hdf5::DataSet::planChunking(dims, sizeof(double), hint), InvalidRank);
+
+    hint.read_shape = NDSize();
+    hint.append_axis = 2;
+    CPPUNIT_ASSERT_THROW(hdf5::DataSet::planChunking(dims, sizeof(double), hint), OutOfBounds);
+}
+
 
 void TestDataSet::testDataType() {
     static struct _type_info {
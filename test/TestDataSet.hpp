@@ -34,6 +34,7 @@ public:
     void setUp();
     void testNDSize();
     void testChunkGuessing();
+    void testChunkPlanning();
     void testDataType();
     void testBasic();
     void testSelection();
@@ -53,6 +54,7 @@ private:
     CPPUNIT_TEST_SUITE(TestDataSet);
     CPPUNIT_TEST(testNDSize);
     CPPUNIT_TEST(testChunkGuessing);
+    CPPUNIT_TEST(testChunkPlanning);
     CPPUNIT_TEST(testDataType);
     CPPUNIT_TEST(testBasic);
     CPPUNIT_TEST(testSelection);
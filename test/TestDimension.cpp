@@ -11,6 +11,8 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace nix;
 using namespace valid;
@@ -387,6 +389,38 @@ void TestDimension::testRangeDimIndexOf() {
     CPPUNIT_ASSERT(rd.indexOf(257.28) == 4);
     CPPUNIT_ASSERT(rd.indexOf(-257.28) == 0);
 
+    std::vector<size_t> indices = rd.indexOf(std::vector<double>{257.28, -50., 5.0, -100., -70.});
+    CPPUNIT_ASSERT(indices == std::vector<size_t>({4, 1, 2, 0, 0}));
+
+    // ticks written through the dimension replace the cached ones
+    rd.ticks({0.0, 1.0, 2.0});
+    CPPUNIT_ASSERT(rd.indexOf(1.6) == 2);
+    CPPUNIT_ASSERT(rd.tickAt(2) == 2.0);
+
+    // irregular ticks spanning several blocks
+    std::vector<double> many(20000);
+    for (size_t i = 0; i < many.size(); i++) {
+        many[i] = static_cast<double>(i) * 0.5 + static_cast<double>(i % 7) * 0.01;
+    }
+    rd.ticks(many);
+
+    std::vector<double> positions;
+    for (double p = -3.0; p < 10010.0; p += 2.71) {
+        positions.push_back(p);
+    }
+    std::reverse(positions.begin(), positions.end());
+
+    indices = rd.indexOf(positions);
+    for (size_t k = 0; k < positions.size(); k++) {
+        auto low = std::lower_bound(many.begin(), many.end(), positions[k]);
+        size_t expected = low == many.end() ? many.size() - 1 : static_cast<size_t>(low - many.begin());
+        if (low != many.end() && low != many.begin() && *low - positions[k] >= positions[k] - *(low - 1)) {
+            expected--;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, indices[k]);
+        CPPUNIT_ASSERT_EQUAL(expected, rd.indexOf(positions[k]));
+    }
+
     data_array.deleteDimension(d.index());
 }
 
@@ -67,5 +67,42 @@ void TestEntity::testUpdatedAt() {
 }
 
 
+void TestEntity::testAttributeCache() {
+    block.definition("cached");
+    string id = block.id();
+
+    // all handles of the entity see the changes made through any of them
+    Block other = file.getBlock(id);
+    CPPUNIT_ASSERT(other.type() == "dataset");
+    block.type("changed");
+    CPPUNIT_ASSERT(other.type() == "changed");
+    other.definition(nix::none);
+    CPPUNIT_ASSERT(block.definition() == nix::none);
 
-
+    time_t updated = block.updatedAt();
+    file.flush();
+    CPPUNIT_ASSERT(other.updatedAt() == updated);
+
+    // the attributes of an entity are read in a single pass on first access;
+    // no other handle of the new block is alive, so nothing is cached yet
+    string fresh_id = file.createBlock("fresh", "dataset").id();
+    file.flush();
+    file.collectIOStats(true);
+    Block fresh = file.getBlock(fresh_id);
+    file.resetIOStats();
+    fresh.name();
+    // entity_id, name, type, created_at and updated_at
+    CPPUNIT_ASSERT_EQUAL(size_t(5), file.ioStats()[IOOperation::AttrRead].calls);
+
+    // and never again
+    file.resetIOStats();
+    for (int i = 0; i < 3; i++) {
+        fresh.name();
+        fresh.type();
+        fresh.definition();
+        fresh.createdAt();
+        fresh.updatedAt();
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(0), file.ioStats()[IOOperation::AttrRead].calls);
+    file.collectIOStats(false);
+}
@@ -37,6 +37,7 @@ private:
 
     CPPUNIT_TEST(testUpdatedAt);
     CPPUNIT_TEST(testCreatedAt);
+    CPPUNIT_TEST(testAttributeCache);
 
     CPPUNIT_TEST_SUITE_END ();
 
@@ -56,5 +57,6 @@ public:
     void testOperators();
     void testUpdatedAt();
     void testCreatedAt();
+    void testAttributeCache();
 
 };
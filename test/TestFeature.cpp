@@ -82,6 +82,22 @@ void TestFeature::testData() {
     block.deleteDataArray(da_2.id());
     // make sure link is gone with deleted data array
     CPPUNIT_ASSERT_THROW(rp.data(), std::runtime_error);
+
+    // the linked array sees data appended through other handles
+    rp.data(data_array);
+    vector<double> values(10, 1.0);
+    data_array.setData(values);
+    DataArray linked = rp.data();
+    CPPUNIT_ASSERT_EQUAL(NDSize({10}), linked.dataExtent());
+
+    vector<double> appended = {2.0, 3.0, 4.0, 5.0, 6.0};
+    data_array.appendData(DataType::Double, appended.data(), NDSize({5}), 0);
+    CPPUNIT_ASSERT_EQUAL(NDSize({15}), linked.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(NDSize({15}), rp.data().dataExtent());
+
+    vector<double> tail;
+    linked.getData(tail, NDSize({5}), NDSize({10}));
+    CPPUNIT_ASSERT(tail == appended);
     tag.deleteFeature(rp.id());
 }
 
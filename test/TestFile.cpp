@@ -10,6 +10,7 @@
 
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
+#include <nix/hdf5/Group.hpp>
 
 #include <ctime>
 
@@ -94,6 +95,15 @@ void TestFile::testBlockAccess() {
     CPPUNIT_ASSERT(file_open.blockCount() == names.size());
     CPPUNIT_ASSERT(file_open.blocks().size() == names.size());
 
+    // the blocks are listed with a single pass over the links, in link order
+    file_open.collectIOStats(true);
+    vector<Block> blocks = file_open.blocks();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), file_open.ioStats()[IOOperation::LinkIteration].calls);
+    file_open.collectIOStats(false);
+    for (size_t i = 0; i < names.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(names[i], blocks[i].name());
+    }
+
     for (const auto &name : names) {
         Block bl_name = file_open.getBlock(name);
         CPPUNIT_ASSERT(bl_name);
@@ -178,6 +188,19 @@ void TestFile::testOperators(){
 void TestFile::testReopen() {
     //file_open is currently open
     Block b = file_open.createBlock("a", "a");
+    string block_id = b.id();
+    string array_id = b.createDataArray("x", "x", DataType::Double, NDSize({1})).id();
+    b = none;
+    file_open.close();
+
+    // the id indexes stored on close spare the scans over the entities
+    file_open = nix::File::open("test_file.h5", FileMode::ReadWrite);
+    file_open.collectIOStats(true);
+    b = file_open.getBlock(block_id);
+    CPPUNIT_ASSERT(b);
+    CPPUNIT_ASSERT(b.getDataArray(array_id));
+    CPPUNIT_ASSERT(!b.getDataArray(util::createId()));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), file_open.ioStats()[IOOperation::LinkIteration].calls);
     b = none;
     file_open.close();
 
@@ -185,3 +208,96 @@ void TestFile::testReopen() {
     b = file_open.createBlock("b", "b");
 }
 
+
+void TestFile::testFlush() {
+    Block b = file_open.createBlock("flushed", "test");
+    Section s = file_open.createSection("flushed", "test");
+    CPPUNIT_ASSERT(b.updatedAt() >= statup_time);
+
+    b.definition("pending update");
+    time_t block_updated = b.updatedAt();
+    time_t section_updated = s.updatedAt();
+    CPPUNIT_ASSERT(block_updated >= statup_time);
+
+    // a second handle of the file reads the attribute itself, bypassing the
+    // pending times and cached attributes of the library
+    auto stored_update = []() {
+        boost::optional<time_t> stored;
+        hid_t fid = H5Fopen("test_file.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        CPPUNIT_ASSERT(fid >= 0);
+        {
+            nix::hdf5::Group group(H5Gopen2(fid, "/data/flushed", H5P_DEFAULT));
+            if (group.hasAttr("updated_at")) {
+                string t;
+                group.getAttr("updated_at", t);
+                stored = util::strToTime(t);
+            }
+        }
+        H5Fclose(fid);
+        return stored;
+    };
+
+    CPPUNIT_ASSERT(!stored_update());
+    file_open.flush();
+    boost::optional<time_t> stored = stored_update();
+    CPPUNIT_ASSERT(stored);
+    CPPUNIT_ASSERT_EQUAL(block_updated, *stored);
+
+    s.definition("pending until close");
+    section_updated = s.updatedAt();
+    string block_id = b.id(), section_id = s.id();
+    b = none;
+    s = none;
+    file_open.close();
+
+    // read-only traversal sees the times written on flush and close
+    File ro = File::open("test_file.h5", FileMode::ReadOnly);
+    b = ro.getBlock(block_id);
+    s = ro.getSection(section_id);
+    CPPUNIT_ASSERT_EQUAL(block_updated, b.updatedAt());
+    CPPUNIT_ASSERT_EQUAL(section_updated, s.updatedAt());
+    CPPUNIT_ASSERT(b.createdAt() <= b.updatedAt());
+    b = none;
+    s = none;
+    ro.close();
+}
+
+
+void TestFile::testIOStats() {
+    Block b = file_open.createBlock("stats", "test");
+    DataArray da = b.createDataArray("data", "test", DataType::Double, NDSize({100}));
+    std::vector<double> values(100, 1.0);
+
+    // nothing is counted before the collection is enabled
+    da.setData(values);
+    IOStats stats = file_open.ioStats();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), stats[IOOperation::DataWrite].calls);
+
+    file_open.collectIOStats(true);
+    da.setData(values);
+    da.getData(values);
+    b.getDataArray("data").name();
+
+    stats = file_open.ioStats();
+    CPPUNIT_ASSERT(stats[IOOperation::DataWrite].calls >= 1);
+    CPPUNIT_ASSERT(stats[IOOperation::DataWrite].bytes >= 100 * sizeof(double));
+    CPPUNIT_ASSERT(stats[IOOperation::DataRead].calls >= 1);
+    CPPUNIT_ASSERT(stats[IOOperation::DataRead].bytes >= 100 * sizeof(double));
+    CPPUNIT_ASSERT(stats[IOOperation::AttrRead].calls >= 1);
+    CPPUNIT_ASSERT(stats[IOOperation::ObjectOpen].calls >= 1);
+
+    const IOCounter &reads = stats[IOOperation::DataRead];
+    size_t binned = 0;
+    for (size_t n : reads.histogram) {
+        binned += n;
+    }
+    CPPUNIT_ASSERT_EQUAL(reads.calls, binned);
+
+    // disabling keeps the counters, resetting clears them
+    file_open.collectIOStats(false);
+    da.getData(values);
+    CPPUNIT_ASSERT_EQUAL(reads.calls, file_open.ioStats()[IOOperation::DataRead].calls);
+
+    file_open.resetIOStats();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), file_open.ioStats()[IOOperation::DataRead].calls);
+}
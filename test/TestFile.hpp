@@ -37,6 +37,8 @@ private:
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
+    CPPUNIT_TEST(testFlush);
+    CPPUNIT_TEST(testIOStats);
     CPPUNIT_TEST_SUITE_END ();
 
     nix::File file_open, file_other, file_null;
@@ -56,4 +58,6 @@ public:
     void testSectionAccess();
     void testOperators();
     void testReopen();
+    void testFlush();
+    void testIOStats();
 };
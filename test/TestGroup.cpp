@@ -13,6 +13,8 @@
 #include "RefTester.hpp"
 
 #include <nix/hdf5/FileHDF5.hpp>
+#include <nix/hdf5/FileState.hpp>
+#include <nix/hdf5/IOMonitor.hpp>
 
 unsigned int & TestGroup::open_mode()
 {
@@ -209,3 +211,146 @@ void TestGroup::testRefCount() {
     test_refcounting<nix::hdf5::Group>(h5group, ha);
     H5Gclose(ha);
 }
+
+void TestGroup::testEntityIndex() {
+    nix::hdf5::Group root(h5group, true);
+    // keeps the caches of the file, like an open nix::File does
+    std::shared_ptr<nix::hdf5::FileState> state = nix::hdf5::FileState::open(root);
+    nix::hdf5::Group parent = root.openGroup("index_parent", true);
+    nix::hdf5::Group container = parent.openGroup("entities", true);
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 5; i++) {
+        std::string name = "entity_" + nix::util::numToStr(i);
+        nix::hdf5::Group g = container.openGroup(name, true);
+        std::string uuid = nix::util::createId();
+        g.setAttr("entity_id", uuid);
+        g.setAttr("name", name);
+        ids.push_back(uuid);
+    }
+
+    nix::hdf5::EntityIndex index;
+
+    boost::optional<std::string> found = index.lookup(container, ids[3]);
+    CPPUNIT_ASSERT(found);
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_3"), *found);
+
+    // the rebuilt index is stored next to the container on flush
+    CPPUNIT_ASSERT(!parent.hasData("entities_index"));
+    nix::hdf5::EntityIndex::flush(root);
+    CPPUNIT_ASSERT(parent.hasData("entities_index"));
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({5, 2}), parent.openData("entities_index").size());
+
+    // and read back instead of scanning the container again
+    auto scans = [this]() {
+        return nix::hdf5::IOMonitor::stats(h5file)[nix::IOOperation::LinkIteration].calls;
+    };
+    state.reset();
+    state = nix::hdf5::FileState::open(root);
+    nix::hdf5::IOMonitor::enable(h5file, true);
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_2"), *index.lookup(container, ids[2]));
+    CPPUNIT_ASSERT(!index.lookup(container, nix::util::createId()));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), scans());
+
+    boost::optional<nix::hdf5::Group> g = index.findGroupByNameOrId(container, ids[1]);
+    CPPUNIT_ASSERT(g);
+    std::string idout;
+    g->getAttr("entity_id", idout);
+    CPPUNIT_ASSERT_EQUAL(ids[1], idout);
+    CPPUNIT_ASSERT(index.findGroupByNameOrId(container, "entity_1"));
+    CPPUNIT_ASSERT(!index.findGroupByNameOrId(container, "entity_42"));
+
+    // add & remove
+    std::string uuid = nix::util::createId();
+    nix::hdf5::Group added = container.openGroup("entity_new", true);
+    added.setAttr("entity_id", uuid);
+    added.setAttr("name", std::string("entity_new"));
+    index.add(container, uuid, "entity_new");
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_new"), *index.lookup(container, uuid));
+
+    index.remove(container, uuid, "entity_new");
+    container.removeGroup("entity_new");
+    CPPUNIT_ASSERT(!index.lookup(container, uuid));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), scans());
+
+    // entities added to a container with a stored index keep it usable
+    nix::hdf5::EntityIndex::flush(root);
+    state.reset();
+    state = nix::hdf5::FileState::open(root);
+    nix::hdf5::IOMonitor::enable(h5file, true);
+    uuid = nix::util::createId();
+    added = container.openGroup("entity_late", true);
+    added.setAttr("entity_id", uuid);
+    index.add(container, uuid, "entity_late");
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_late"), *index.lookup(container, uuid));
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_0"), *index.lookup(container, ids[0]));
+    CPPUNIT_ASSERT(!index.lookup(container, nix::util::createId()));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), scans());
+    nix::hdf5::EntityIndex::flush(root);
+
+    // entities removed or added without updating the index are detected,
+    // also when the index is read from the file
+    state.reset();
+    state = nix::hdf5::FileState::open(root);
+    container.removeGroup("entity_0");
+    CPPUNIT_ASSERT(!index.lookup(container, ids[0]));
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_4"), *index.lookup(container, ids[4]));
+
+    uuid = nix::util::createId();
+    added = container.openGroup("entity_other", true);
+    added.setAttr("entity_id", uuid);
+    CPPUNIT_ASSERT_EQUAL(std::string("entity_other"), *index.lookup(container, uuid));
+}
+
+void TestGroup::testVisitLinks() {
+    nix::hdf5::Group root(h5group, true);
+    nix::hdf5::Group container = root.openGroup("visit", true);
+
+    std::string long_name(300, 'x');
+    std::vector<std::string> names = {"a", "b", "c", long_name};
+    for (const auto &name : names) {
+        nix::hdf5::Group g = container.openGroup(name, true);
+        g.setAttr("entity_id", name + "_id");
+    }
+
+    nix::hdf5::DataSet ds = container.createData("d", nix::DataType::Double, nix::NDSize({2}));
+    ds.setAttr("entity_id", std::string("d_id"));
+    H5Lcreate_soft("a", container.h5id(), "soft", H5P_DEFAULT, H5P_DEFAULT);
+
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(6), container.objectCount());
+
+    std::vector<nix::hdf5::Link> links = container.links(true);
+    CPPUNIT_ASSERT_EQUAL(size_t(6), links.size());
+    for (size_t i = 0; i < links.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(container.objectName(i), links[i].name);
+
+        if (links[i].name == "d") {
+            CPPUNIT_ASSERT(links[i].type == H5O_TYPE_DATASET);
+        } else if (links[i].name == "soft") {
+            CPPUNIT_ASSERT(links[i].type == H5O_TYPE_UNKNOWN);
+            CPPUNIT_ASSERT(links[i].address.second == HADDR_UNDEF);
+        } else {
+            CPPUNIT_ASSERT(links[i].type == H5O_TYPE_GROUP);
+        }
+    }
+    CPPUNIT_ASSERT(container.links().front().type == H5O_TYPE_UNKNOWN);
+    CPPUNIT_ASSERT_THROW(container.objectName(6), nix::OutOfBounds);
+
+    // the visitor can stop the iteration
+    size_t visited = 0;
+    container.visitLinks([&visited](const nix::hdf5::Link &link) {
+        return ++visited < 2;
+    });
+    CPPUNIT_ASSERT_EQUAL(size_t(2), visited);
+
+    // exceptions of the visitor are passed on
+    CPPUNIT_ASSERT_THROW(container.visitLinks([](const nix::hdf5::Link &link) -> bool {
+        throw std::runtime_error("stop");
+    }), std::runtime_error);
+
+    boost::optional<nix::hdf5::Group> g = container.findGroupByAttribute("entity_id", long_name + "_id");
+    CPPUNIT_ASSERT(g);
+    CPPUNIT_ASSERT(!container.findGroupByAttribute("entity_id", "d_id"));
+    CPPUNIT_ASSERT(container.findDataByAttribute("entity_id", "d_id"));
+    CPPUNIT_ASSERT(!container.findDataByAttribute("entity_id", "a_id"));
+}
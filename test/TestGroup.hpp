@@ -12,6 +12,7 @@
 #include <nix.hpp>
 
 #include <nix/hdf5/Group.hpp>
+#include <nix/hdf5/EntityIndex.hpp>
 
 #include <iostream>
 #include <sstream>
@@ -48,6 +49,10 @@ public:
 
     void testOpen();
 
+    void testEntityIndex();
+
+    void testVisitLinks();
+
     template<typename T>
     static void assert_vectors_equal(std::vector<T> &a, std::vector<T> &b) {
 
@@ -77,5 +82,7 @@ private:
     CPPUNIT_TEST(testVector);
     CPPUNIT_TEST(testMultiArray);
     CPPUNIT_TEST(testArray);
+    CPPUNIT_TEST(testEntityIndex);
+    CPPUNIT_TEST(testVisitLinks);
     CPPUNIT_TEST_SUITE_END ();
 };
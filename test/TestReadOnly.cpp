@@ -43,6 +43,30 @@ void TestReadOnly::setUp() {
     MultiTag mtag = block.createMultiTag("tag_one", "test_tag", positions);
     Feature feature = tag.createFeature(data_array, nix::LinkType::Tagged);
     Property property = section.createProperty("doubleProperty", values);
+
+    // the last rows are never written, their chunks stay unallocated
+    DataArray signal = block.createDataArray("signal", "signal", DataType::Int32, NDSize({ 40000, 16 }));
+    std::vector<int32_t> samples(30000 * 16);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = static_cast<int32_t>(i);
+    }
+    signal.setData(DataType::Int32, samples.data(), NDSize({ 30000, 16 }), NDSize({ 0, 0 }));
+    signal_id = signal.id();
+
+    // the same samples in small compressed chunks
+    ChunkingHint hint;
+    hint.target_bytes = 16 * 1024;
+    std::vector<Compression> codecs = { Compression(Codec::Deflate, false),
+                                        Compression(Codec::Deflate, true),
+                                        Compression(Codec::LZ4, false),
+                                        Compression(Codec::LZ4, true) };
+    compressed_ids.clear();
+    for (size_t i = 0; i < codecs.size(); i++) {
+        DataArray compressed = block.createDataArray("compressed_" + util::numToStr(i), "signal",
+                                                     DataType::Int32, NDSize({ 30000, 16 }), hint, codecs[i]);
+        compressed.setData(DataType::Int32, samples.data(), NDSize({ 30000, 16 }), NDSize({ 0, 0 }));
+        compressed_ids.push_back(compressed.id());
+    }
     
     section_id = section.id(); feature_id = feature.id(); tag_id = tag.id();
     mtag_id = mtag.id(); property_id = property.id(); block_id = block.id();
@@ -86,3 +110,57 @@ void TestReadOnly::testRead() {
     
     file.close();
 }
+
+
+void TestReadOnly::testParallelRead() {
+    File file = File::open("test_read_only.h5", FileMode::ReadWrite);
+    CPPUNIT_ASSERT_THROW(file.readThreads(4), std::runtime_error);
+    file.close();
+
+    file = File::open("test_read_only.h5", FileMode::ReadOnly);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), file.readThreads());
+    file.readThreads(4);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), file.readThreads());
+
+    DataArray signal = file.getBlock(block_id).getDataArray(signal_id);
+
+    std::vector<int32_t> all(40000 * 16);
+    signal.getData(DataType::Int32, all.data(), NDSize({ 40000, 16 }), NDSize({ 0, 0 }));
+    for (size_t i = 0; i < all.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(i < 30000 * 16 ? static_cast<int32_t>(i) : 0, all[i]);
+    }
+
+    std::vector<double> part(25001 * 5);
+    signal.getData(DataType::Double, part.data(), NDSize({ 25001, 5 }), NDSize({ 3, 7 }));
+    for (size_t i = 0; i < 25001; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            double expected = static_cast<double>((i + 3) * 16 + j + 7);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, part[i * 5 + j], 0.0);
+        }
+    }
+
+    // compressed chunks are fetched one by one and decoded by the workers
+    file.collectIOStats(true);
+    for (const std::string &id : compressed_ids) {
+        DataArray compressed = file.getBlock(block_id).getDataArray(id);
+
+        file.resetIOStats();
+        std::vector<int32_t> values(20000 * 16);
+        compressed.getData(DataType::Int32, values.data(), NDSize({ 20000, 16 }), NDSize({ 5000, 0 }));
+        for (size_t i = 0; i < values.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<int32_t>(i + 5000 * 16), values[i]);
+        }
+        CPPUNIT_ASSERT(file.ioStats()[IOOperation::DataRead].calls > 1);
+
+        std::vector<double> converted(999 * 3);
+        compressed.getData(DataType::Double, converted.data(), NDSize({ 999, 3 }), NDSize({ 28001, 13 }));
+        for (size_t i = 0; i < 999; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                double expected = static_cast<double>((i + 28001) * 16 + j + 13);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, converted[i * 3 + j], 0.0);
+            }
+        }
+    }
+
+    file.close();
+}
@@ -33,11 +33,13 @@ private:
     CPPUNIT_TEST_SUITE(TestReadOnly);
 
     CPPUNIT_TEST(testRead);
+    CPPUNIT_TEST(testParallelRead);
 
     CPPUNIT_TEST_SUITE_END ();
 
     std::string section_id, block_id, tag_id, mtag_id, property_id, 
-                feature_id, data_array_id;
+                feature_id, data_array_id, signal_id;
+    std::vector<std::string> compressed_ids;
     size_t dim_index, dim_sampled_index, dim_range_index, dim_set_index;
     std::stringstream s;
 
@@ -49,5 +51,6 @@ public:
     void tearDown();
 
     void testRead();
+    void testParallelRead();
 
 };
@@ -269,6 +269,64 @@ void TestSection::testFindRelated() {
 }
 
 
+void TestSection::testFindIndexed() {
+    Section a = section.createSection("a", "ta");
+    Section b = section.createSection("b", "tb");
+    Section a1 = a.createSection("a1", "leaf");
+    Section a2 = a.createSection("a2", "leaf");
+    Section b1 = b.createSection("b1", "leaf");
+    Section b11 = b1.createSection("b11", "leaf");
+    b11.createProperty("prop", DataType::Double);
+
+    // same breadth-first order as a traversal of the children
+    vector<Section> expected = {section};
+    for (size_t i = 0; i < expected.size(); i++) {
+        vector<Section> children = expected[i].sections();
+        expected.insert(expected.end(), children.begin(), children.end());
+    }
+    vector<Section> found = section.findSections();
+    CPPUNIT_ASSERT_EQUAL(expected.size(), found.size());
+    for (size_t i = 0; i < found.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(expected[i].id(), found[i].id());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(3), section.findSections(util::AcceptAll<Section>(), 1).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(3), section.findSections(util::TypeFilter<Section>("leaf"), 2).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), b.findSections(util::TypeFilter<Section>("leaf")).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), section.findSections(util::NameFilter<Section>("b1")).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), a.findSections(util::IdFilter<Section>(b1.id())).size());
+
+    // sections found by the index know their parents
+    found = section.findSections(util::PropertyFilter<Section>("prop"));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), found.size());
+    CPPUNIT_ASSERT_EQUAL(b11.id(), found[0].id());
+    CPPUNIT_ASSERT_EQUAL(b1.id(), found[0].parent().id());
+    CPPUNIT_ASSERT_EQUAL(section.id(), found[0].parent().parent().parent().id());
+
+    found = file.findSections(util::IdFilter<Section>(a2.id()));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), found.size());
+    CPPUNIT_ASSERT_EQUAL(a.id(), found[0].parent().id());
+
+    // changes of the tree are visible in the next search
+    a2.type("other");
+    CPPUNIT_ASSERT_EQUAL(size_t(1), a.findSections(util::TypeFilter<Section>("leaf")).size());
+    a2.createProperty("prop", DataType::Int32);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), section.findSections(util::PropertyFilter<Section>("prop")).size());
+    b11.deleteProperty("prop");
+    CPPUNIT_ASSERT_EQUAL(size_t(1), section.findSections(util::PropertyFilter<Section>("prop")).size());
+    a2.createSection("a21", "leaf");
+    CPPUNIT_ASSERT_EQUAL(size_t(2), a.findSections(util::TypeFilter<Section>("leaf")).size());
+    section.deleteSection(b.id());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), section.findSections(util::NameFilter<Section>("b11")).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(5), section.findSections().size());
+
+    // custom filters still work
+    found = section.findSections([](const Section &s) { return s.name().size() == 3; });
+    CPPUNIT_ASSERT_EQUAL(size_t(1), found.size());
+    CPPUNIT_ASSERT_EQUAL(string("a21"), found[0].name());
+}
+
+
 void TestSection::testPropertyAccess() {
     vector<string> names = { "property_a", "property_b", "property_c", "property_d", "property_e" };
 
@@ -41,6 +41,7 @@ private:
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testFindSection);
     CPPUNIT_TEST(testFindRelated);
+    CPPUNIT_TEST(testFindIndexed);
     CPPUNIT_TEST(testPropertyAccess);
 
     CPPUNIT_TEST(testOperators);
@@ -71,6 +72,7 @@ public:
     void testSectionAccess();
     void testFindSection();
     void testFindRelated();
+    void testFindIndexed();
     void testPropertyAccess();
 
     void testOperators();
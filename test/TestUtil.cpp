@@ -52,6 +52,10 @@ void TestUtil::testUnitScaling() {
     CPPUNIT_ASSERT(util::getSIScaling("V","mV") == 1e+03);
     CPPUNIT_ASSERT(util::getSIScaling("V^2","mV^2") == 1e+06);
     CPPUNIT_ASSERT(util::getSIScaling("mV^2","kV^2") == 1e-12);
+
+    // repeated lookups are served from the cache
+    CPPUNIT_ASSERT(util::getSIScaling("mV^2","kV^2") == 1e-12);
+    CPPUNIT_ASSERT_THROW(util::getSIScaling("mOhm","ms"), nix::InvalidUnit);
 }
 
 void TestUtil::testIsSIUnit() {
@@ -81,6 +85,14 @@ void TestUtil::testSIUnitSplit() {
     CPPUNIT_ASSERT(prefix == "m" && unit == "V" && power == "-2");
     util::splitUnit(unit_5, prefix, unit, power);
     CPPUNIT_ASSERT(prefix == "" && unit == "m" && power == "2");
+    util::splitUnit("dam^+3", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "da" && unit == "m" && power == "+3");
+    util::splitUnit("mmol^2", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "m" && unit == "mol" && power == "2");
+    util::splitUnit("cd", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "" && unit == "cd" && power == "");
+    util::splitUnit("foo", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "" && unit == "foo" && power == "");
 }
 
 void TestUtil::testIsAtomicSIUnit() {
@@ -90,6 +102,14 @@ void TestUtil::testIsAtomicSIUnit() {
     CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV/cm"));
     CPPUNIT_ASSERT(util::isAtomicSIUnit("dB"));
     CPPUNIT_ASSERT(util::isAtomicSIUnit("rad"));
+    CPPUNIT_ASSERT(util::isAtomicSIUnit("Pa"));
+    CPPUNIT_ASSERT(util::isAtomicSIUnit("kHz^+12"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit(""));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("k"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV^0"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV^"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV^2x"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit(" mV"));
 }
 
 void TestUtil::testIsCompoundSIUnit() {
@@ -102,6 +122,10 @@ void TestUtil::testIsCompoundSIUnit() {
     CPPUNIT_ASSERT(util::isCompoundSIUnit(unit_2));
     CPPUNIT_ASSERT(util::isCompoundSIUnit(unit_3));
     CPPUNIT_ASSERT(!util::isCompoundSIUnit(unit_4));
+    CPPUNIT_ASSERT(!util::isCompoundSIUnit("mV*"));
+    CPPUNIT_ASSERT(!util::isCompoundSIUnit("*mV"));
+    CPPUNIT_ASSERT(!util::isCompoundSIUnit("mV**s"));
+    CPPUNIT_ASSERT(!util::isCompoundSIUnit("mV * s"));
 }
 
 